@@ -0,0 +1,109 @@
+//
+//  AttributeListParser.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#include <stddef.h>
+#include "AttributeListParser.h"
+
+static inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline void trimWhitespace(const char *bytes, uint64_t *start, uint64_t *end) {
+    while (*start < *end && isWhitespace(bytes[*start])) {
+        *start += 1;
+    }
+    while (*end > *start && isWhitespace(bytes[*end - 1])) {
+        *end -= 1;
+    }
+}
+
+static inline AttributeListEntry makeEntry(const char *bytes, uint64_t keyStart, uint64_t keyEnd, uint64_t valueStart, uint64_t valueEnd) {
+    
+    trimWhitespace(bytes, &keyStart, &keyEnd);
+    trimWhitespace(bytes, &valueStart, &valueEnd);
+    
+    bool quoteEscaped = false;
+    if (valueEnd > valueStart && bytes[valueStart] == '"' && bytes[valueEnd - 1] == '"') {
+        // like `String.trimDoubleQuotes()`, this trims every leading and trailing quote
+        while (valueStart < valueEnd && bytes[valueStart] == '"') {
+            valueStart++;
+        }
+        while (valueEnd > valueStart && bytes[valueEnd - 1] == '"') {
+            valueEnd--;
+        }
+        quoteEscaped = true;
+    }
+    
+    AttributeListEntry entry = { keyStart, keyEnd - keyStart, valueStart, valueEnd - valueStart, quoteEscaped };
+    return entry;
+}
+
+int64_t mamba_parseAttributeList(const char *bytes, uint64_t length, AttributeListEntry *entries, uint64_t capacity) {
+    
+    if (bytes == NULL || length == 0) {
+        return 0;
+    }
+    
+    uint64_t count = 0;
+    // the start of the key or value that we are currently reading
+    uint64_t tokenStart = 0;
+    uint64_t keyStart = 0;
+    uint64_t keyEnd = 0;
+    // a key is only found on the first unquoted '=' of a pair, and only if it is not empty
+    bool haveKey = false;
+    bool quoteEscaped = false;
+    
+    for (uint64_t i = 0; i < length; i++) {
+        const char c = bytes[i];
+        if (c == '"') {
+            quoteEscaped = !quoteEscaped;
+        }
+        else if (c == '=' && !quoteEscaped && !haveKey) {
+            if (i == 0) {
+                return -1;
+            }
+            keyStart = tokenStart;
+            keyEnd = i;
+            haveKey = keyEnd > keyStart;
+            tokenStart = i + 1;
+        }
+        else if (c == ',' && !quoteEscaped) {
+            if (!haveKey) {
+                return -1;
+            }
+            if (count < capacity) {
+                entries[count] = makeEntry(bytes, keyStart, keyEnd, tokenStart, i);
+            }
+            count++;
+            haveKey = false;
+            tokenStart = i + 1;
+        }
+    }
+    
+    if (!haveKey) {
+        return -1;
+    }
+    if (count < capacity) {
+        entries[count] = makeEntry(bytes, keyStart, keyEnd, tokenStart, length);
+    }
+    count++;
+    
+    return (int64_t)count;
+}
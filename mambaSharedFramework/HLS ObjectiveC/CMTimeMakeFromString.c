@@ -18,6 +18,7 @@
 //
 
 #include "CMTimeMakeFromString.h"
+#include <stdbool.h>
 
 // Used in calculating segment durations to avoid floating point math.
 // On overflow, returns -1.
@@ -32,51 +33,105 @@ static inline int32_t int32exp10(uint8_t exp) {
     return powers[exp];
 }
 
-CMTime mamba_CMTimeMakeFromString(const char * _Nullable string, uint8_t decimal_places, const char * _Nullable * _Nullable remainder) {
-    CMTime result = kCMTimeInvalid;
+// These do not depend on the C locale, unlike isspace and isdigit
+static inline bool isWhitespace(const char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline bool isDigit(const char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// The string ends at `end` or at a null character, whichever comes first. `end` may be NULL for null-terminated strings.
+static inline bool isAtEnd(const char *p, const char *end) {
+    return p == end || *p == '\0';
+}
+
+// Cannot represent a number with more than 19 digits in int64_t
+// plus one char for minus sign
+static const long maxIntegralLength = 20;
+// Cannot represent more than 9 decimal places with a power of 10 in int32_t
+static const long maxDecimalLength = 9;
+
+/*
+ Reads a fixed point number in the format `\s*-?[0-9]+(\.[0-9]+)?` as a number of 1/10^decimal_places units.
+ 
+ This accepts and rejects the same strings as the `sscanf(" %20[-0-9]%zn%1[.]%zn%9[0-9]%zn")` followed by
+ `strtoll` that we used to use, and leaves `remainder` in the same place, but reads each character once and
+ does not copy anything.
+ 
+ Returns false if the string could not be interpreted.
+ */
+static inline bool parseFixedPoint(const char *string, const char *end, uint8_t decimal_places, CMTimeValue *value, int32_t *timescale, const char **remainder) {
     
-    size_t charsRead = 0;
+    const char *p = string;
+    *remainder = string;
     
-    if (string == NULL) {
-        goto end;
+    while (!isAtEnd(p, end) && isWhitespace(*p)) {
+        p++;
     }
     
-    // Cannot represent a number with more than 19 digits in int64_t
-    // plus one char for minus sign
-    char integralString[21];
-    // Must copy out this value to detect its presence
-    char decimalPoint;
-    // Cannot represent more than 9 decimal places with a power of 10 in int32_t
-    char decimalString[10];
-    
-    int argsRead = sscanf(string, " %20[-0-9]%zn%1[.]%zn%9[0-9]%zn", integralString, &charsRead, &decimalPoint, &charsRead, decimalString, &charsRead);
+    // like `%20[-0-9]`, take minus signs and digits, and check that they make a single integer afterwards
+    const char *integralStart = p;
+    while (!isAtEnd(p, end) && p - integralStart < maxIntegralLength && (isDigit(*p) || *p == '-')) {
+        p++;
+    }
+    const char *integralEnd = p;
+    if (integralEnd == integralStart) {
+        return false;
+    }
+    *remainder = p;
     
-    // must read one integer, or two separated by a period
-    // should not accept "1234."
-    if (!(argsRead == 1 || argsRead == 3)) {
-        goto end;
+    const char *decimalStart = NULL;
+    const char *decimalEnd = NULL;
+    if (!isAtEnd(p, end) && *p == '.') {
+        p++;
+        *remainder = p;
+        decimalStart = p;
+        while (!isAtEnd(p, end) && p - decimalStart < maxDecimalLength && isDigit(*p)) {
+            p++;
+        }
+        decimalEnd = p;
+        // should not accept "1234."
+        if (decimalEnd == decimalStart) {
+            return false;
+        }
+        *remainder = p;
     }
     
-    int32_t timebase = int32exp10(decimal_places);
+    const int32_t timebase = int32exp10(decimal_places);
     if (timebase == -1) {
-        goto end;
+        return false;
     }
     
-    char *integralRemainder = NULL;
-    int64_t time = strtoll(integralString, &integralRemainder, 10);
-    
     // the entire portion before the decimal point must be a single valid signed integer
-    if (*integralRemainder != '\0') {
-        goto end;
+    const char *digit = integralStart;
+    const bool negative = *digit == '-';
+    if (negative) {
+        digit++;
+    }
+    if (digit == integralEnd) {
+        return false;
+    }
+    // like `strtoll`, clamp to the int64_t range on overflow
+    const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t magnitude = 0;
+    for (; digit < integralEnd; digit++) {
+        if (!isDigit(*digit)) {
+            return false;
+        }
+        const uint64_t digitValue = (uint64_t)(*digit - '0');
+        magnitude = magnitude > (limit - digitValue) / 10 ? limit : magnitude * 10 + digitValue;
     }
     
-    time *= timebase;
+    // unsigned math, so an out of range duration wraps rather than being undefined
+    uint64_t time = (negative ? 0 - magnitude : magnitude) * (uint64_t)timebase;
     
-    if (argsRead == 3) {
-        char *decimalRemainder = NULL;
-        int64_t fractionalTime = strtoull(decimalString, &decimalRemainder, 10);
-        
-        uint8_t numberOfDecimalDigits = (uint8_t)(decimalRemainder - decimalString);
+    if (decimalStart != NULL) {
+        uint64_t fractionalTime = 0;
+        for (digit = decimalStart; digit < decimalEnd; digit++) {
+            fractionalTime = fractionalTime * 10 + (uint64_t)(*digit - '0');
+        }
         
         // This will not overflow because:
         // * the max number of digits will be 9
@@ -87,21 +142,74 @@ CMTime mamba_CMTimeMakeFromString(const char * _Nullable string, uint8_t decimal
         // * thus this value cannot exceed 999999999e9 == 9.99999999e17 < 1e18
         // * int64_t max is 2^63 - 1 > 1e18
         // * max value < 1e18 < int64_t max
-        fractionalTime *= timebase;
-        fractionalTime /= int32exp10(numberOfDecimalDigits);
-        
-        if (integralString[0] == '-') {
-            fractionalTime *= -1;
-        }
+        fractionalTime *= (uint64_t)timebase;
+        fractionalTime /= (uint64_t)int32exp10((uint8_t)(decimalEnd - decimalStart));
         
-        time += fractionalTime;
+        time = negative ? time - fractionalTime : time + fractionalTime;
     }
     
-    result = CMTimeMake(time, timebase);
+    *value = (CMTimeValue)time;
+    *timescale = timebase;
+    return true;
+}
+
+CMTime mamba_CMTimeMakeFromString(const char * _Nullable string, uint8_t decimal_places, const char * _Nullable * _Nullable remainder) {
+    CMTime result = kCMTimeInvalid;
+    const char *end = string;
+    
+    if (string != NULL) {
+        CMTimeValue value = 0;
+        int32_t timescale = 0;
+        if (parseFixedPoint(string, NULL, decimal_places, &value, &timescale, &end)) {
+            result = CMTimeMake(value, timescale);
+        }
+    }
     
-end:
     if (remainder != NULL) {
-        *remainder = string + charsRead;
+        *remainder = end;
     }
     return result;
 }
+
+// This function uses strictly fixed-point arithmetic to compute EXTINF segment durations.
+// Using floating-point math can cause rounding errors on the order of .0001 seconds that make
+// timelines non-continuous.
+int64_t mamba_EXTINFDurationTicks(const char * _Nullable bytes, size_t length) {
+    if (bytes == NULL || length == 0) {
+        return -1;
+    }
+    
+    // Clamp segment durations to 7 characters for efficiency. Unlikely to find a longer one in production.
+    // Matches the limit of seven characters (one whole digit plus the decimal point plus five fractional digits)
+    static const size_t clamping = 7;
+    const char *end = bytes + (length < clamping ? length : clamping);
+    
+    CMTimeValue ticks = 0;
+    int32_t timescale = 0;
+    // Remainder gets set to the first unrecognized character
+    const char *remainder = NULL;
+    if (!parseFixedPoint(bytes, end, mamba_EXTINFDurationDecimalPlaces, &ticks, &timescale, &remainder)) {
+        return -1;
+    }
+    
+    // Negative times are disallowed
+    if (ticks < 0) {
+        return -1;
+    }
+    
+    // time must be followed by a comma or end of string
+    // otherwise, does not match EXTINF spec
+    if (!(isAtEnd(remainder, end) || *remainder == ',')) {
+        return -1;
+    }
+    
+    return ticks;
+}
+
+CMTime mamba_CMTimeMakeFromEXTINFDuration(const char * _Nullable bytes, size_t length) {
+    const int64_t ticks = mamba_EXTINFDurationTicks(bytes, length);
+    if (ticks < 0) {
+        return kCMTimeInvalid;
+    }
+    return CMTimeMake(ticks, mamba_EXTINFDurationTimescale);
+}
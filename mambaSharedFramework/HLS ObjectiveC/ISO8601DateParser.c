@@ -0,0 +1,189 @@
+//
+//  ISO8601DateParser.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#include <stdint.h>
+#include <string.h>
+#include "ISO8601DateParser.h"
+
+// "yyyy-MM-dd"
+static const size_t dateLength = 10;
+// "yyyy-MM-ddTHH:mm:ss"
+static const size_t dateTimeLength = 19;
+// more digits than this are beyond the precision of a double anyway
+static const size_t maxFractionalDigits = 9;
+
+// Used to skip the day calculation for consecutive dates on the same day
+struct LastParsedDay {
+    char date[10];
+    int64_t daysSince1970;
+    bool valid;
+};
+
+static _Thread_local struct LastParsedDay lastParsedDay;
+
+static inline bool isDigit(const char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+// Reads a fixed number of digits. Returns -1 if any of them is not a digit.
+static inline int32_t readDigits(const char *bytes, const size_t count) {
+    int32_t value = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!isDigit(bytes[i])) {
+            return -1;
+        }
+        value = value * 10 + (bytes[i] - '0');
+    }
+    return value;
+}
+
+static inline bool isLeapYear(const int32_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static inline int32_t daysInMonth(const int32_t year, const int32_t month) {
+    static const int32_t days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && isLeapYear(year)) ? 29 : days[month - 1];
+}
+
+// Days from 1970-01-01 in the proleptic Gregorian calendar, see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+static inline int64_t daysSince1970(int32_t year, const int32_t month, const int32_t day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Returns false if the date is not valid
+static inline bool parseDate(const char *bytes, int64_t *days) {
+    
+    if (lastParsedDay.valid && memcmp(lastParsedDay.date, bytes, dateLength) == 0) {
+        *days = lastParsedDay.daysSince1970;
+        return true;
+    }
+    
+    if (bytes[4] != '-' || bytes[7] != '-') {
+        return false;
+    }
+    const int32_t year = readDigits(bytes, 4);
+    const int32_t month = readDigits(bytes + 5, 2);
+    const int32_t day = readDigits(bytes + 8, 2);
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    
+    *days = daysSince1970(year, month, day);
+    
+    memcpy(lastParsedDay.date, bytes, dateLength);
+    lastParsedDay.daysSince1970 = *days;
+    lastParsedDay.valid = true;
+    
+    return true;
+}
+
+bool mamba_parseISO8601Date(const char *bytes, size_t length, double *timeIntervalSince1970) {
+    
+    if (bytes == NULL || length < dateTimeLength + 1) {
+        return false;
+    }
+    
+    int64_t days = 0;
+    if (!parseDate(bytes, &days) || bytes[10] != 'T' || bytes[13] != ':' || bytes[16] != ':') {
+        return false;
+    }
+    
+    const int32_t hour = readDigits(bytes + 11, 2);
+    const int32_t minute = readDigits(bytes + 14, 2);
+    const int32_t second = readDigits(bytes + 17, 2);
+    // allows for a leap second
+    if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 60) {
+        return false;
+    }
+    
+    size_t position = dateTimeLength;
+    
+    double fraction = 0;
+    if (bytes[position] == '.') {
+        position++;
+        const size_t fractionStart = position;
+        int64_t fractionalValue = 0;
+        int64_t fractionalScale = 1;
+        while (position < length && isDigit(bytes[position])) {
+            if (position - fractionStart < maxFractionalDigits) {
+                fractionalValue = fractionalValue * 10 + (bytes[position] - '0');
+                fractionalScale *= 10;
+            }
+            position++;
+        }
+        if (position == fractionStart) {
+            return false;
+        }
+        fraction = (double)fractionalValue / (double)fractionalScale;
+    }
+    
+    if (position == length) {
+        // a time zone is required
+        return false;
+    }
+    
+    int32_t offsetSeconds = 0;
+    const char zone = bytes[position];
+    if (zone == 'Z') {
+        position++;
+    }
+    else if (zone == '+' || zone == '-') {
+        position++;
+        const size_t remaining = length - position;
+        int32_t offsetHours = -1;
+        int32_t offsetMinutes = 0;
+        if (remaining == 2) {
+            offsetHours = readDigits(bytes + position, 2);
+        }
+        else if (remaining == 4) {
+            offsetHours = readDigits(bytes + position, 2);
+            offsetMinutes = readDigits(bytes + position + 2, 2);
+        }
+        else if (remaining == 5 && bytes[position + 2] == ':') {
+            offsetHours = readDigits(bytes + position, 2);
+            offsetMinutes = readDigits(bytes + position + 3, 2);
+        }
+        if (offsetHours < 0 || offsetHours > 23 || offsetMinutes < 0 || offsetMinutes > 59) {
+            return false;
+        }
+        offsetSeconds = (offsetHours * 60 + offsetMinutes) * 60;
+        if (zone == '-') {
+            offsetSeconds = -offsetSeconds;
+        }
+        position = length;
+    }
+    else {
+        return false;
+    }
+    
+    if (position != length) {
+        return false;
+    }
+    
+    const int64_t seconds = days * 86400 + hour * 3600 + minute * 60 + second - offsetSeconds;
+    *timeIntervalSince1970 = (double)seconds + fraction;
+    return true;
+}
@@ -104,39 +104,12 @@
     return self.stringCopy;
 }
 
-// This method uses strictly fixed-point arithmetic to compute EXTINF segment durations.
-// Using floating-point math can cause rounding errors on the order of .0001 seconds that make
-// timelines non-continuous.
+// See `mamba_CMTimeMakeFromEXTINFDuration` for the details of what we accept.
 - (CMTime)EXTINFSegmentDuration {
     if (self.length == 0) {
         return kCMTimeInvalid;
     }
-    
-    // Clamp segment durations to 7 characters for efficiency. Unlikely to find a longer one in production.
-    static const int clamping = 7;
-    // Must null-terminate string
-    char c[clamping + 1] = {0};
-    memcpy(&c, [self UTF8Bytes], MIN(self.length, clamping));
-    
-    // Matches the limit of seven characters (one whole digit plus the decimal point plus five fractional digits)
-    static const uint8_t decimalPlaces = 5;
-    
-    // Remainder gets set to the first unrecognized character
-    const char *remainder = NULL;
-    CMTime time = mamba_CMTimeMakeFromString(c, decimalPlaces, &remainder);
-    
-    // Negative times are disallowed
-    if (CMTimeCompare(time, kCMTimeZero) < 0) {
-        time = kCMTimeInvalid;
-    }
-    
-    // time must be followed by a comma or end of string
-    // otherwise, does not match EXTINF spec
-    if (!(*remainder == ',' || *remainder == '\0')) {
-        time = kCMTimeInvalid;
-    }
-    
-    return time;
+    return mamba_CMTimeMakeFromEXTINFDuration([self UTF8Bytes], self.length);
 }
 
 - (BOOL)isEqual:(id)object {
@@ -0,0 +1,51 @@
+//
+//  PlaylistLineSearch.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#include <string.h>
+#include <stdbool.h>
+#include "PlaylistLineSearch.h"
+
+static inline bool isLineEnding(const char c) {
+    return c == '\n' || c == '\r';
+}
+
+int64_t mamba_offsetAfterLastLineMatching(const char *bytes, uint64_t length, const char *line, uint64_t lineLength) {
+    
+    if (lineLength == 0) {
+        return -1;
+    }
+    
+    uint64_t lineEnd = length;
+    while (lineEnd >= lineLength) {
+        uint64_t lineStart = lineEnd;
+        while (lineStart > 0 && !isLineEnding(bytes[lineStart - 1])) {
+            lineStart--;
+        }
+        if (lineEnd - lineStart == lineLength && memcmp(bytes + lineStart, line, lineLength) == 0) {
+            return (int64_t)lineEnd;
+        }
+        if (lineStart == 0) {
+            break;
+        }
+        // step over the line ending (blank lines and `\r\n` pairs just become empty lines)
+        lineEnd = lineStart - 1;
+    }
+    return -1;
+}
@@ -22,11 +22,25 @@
 #import "RapidParserNewTagCallbacks.h"
 #import "MambaStringRef.h"
 #import "RapidParserCallback.h"
+#import "RapidParserLineRecord.h"
+#import "RapidParserLineRecordBuffer.h"
+#import "RapidParserTagID.h"
 #import "parseHLS.h"
+#import "RapidParserIncremental.h"
 
 #pragma mark RapidParser Interface required for RapidParserNewTagCallbacks Implementations
 
-@interface RapidParser ()
+@interface RapidParser () {
+    @public
+    // non-NULL only while parsing to line records
+    struct RapidParserLineRecordBuffer *_lineRecords;
+    // the bytes that line record offsets refer to, used to recognize tag names. NULL if the bytes are not all available.
+    const unsigned char *_lineRecordBytes;
+    @private
+    // storage for `_lineRecords` during an incremental parse, which outlives any one method call
+    struct RapidParserLineRecordBuffer _incrementalLineRecords;
+    struct RapidParserIncrementalState _incrementalState;
+}
 
 - (void)newTagWithStartTagName:(UInt64)startTagName
                     endTagName:(UInt64)endTagName
@@ -54,9 +68,40 @@
 
 /*
  These C functions are defined here to have access to some of RapidParser's private data and methods
+ 
+ When parsing to line records, new lines are written straight into the line record buffer
+ without any Objective-C messaging or object allocation.
+ 
+ Tag names are looked up, and #EXTINF durations decoded, while their bytes are still in cache, so that
+ the Swift side only has to search its tag registry for names that are not built in.
  */
+static inline uint8_t lineRecordTagID(RapidParser *parser, const uint64_t startTagName, const uint64_t endTagName) {
+    if (parser->_lineRecordBytes == NULL) {
+        return RapidParserTagIDNone;
+    }
+    return (uint8_t)rapidParserTagIDForTagName(parser->_lineRecordBytes + startTagName, endTagName - startTagName + 1);
+}
+
+static inline int64_t lineRecordDurationTicks(RapidParser *parser, const uint64_t startDuration, const uint64_t endDuration) {
+    if (parser->_lineRecordBytes == NULL) {
+        return RapidParserLineRecordDurationNotDecoded;
+    }
+    return mamba_EXTINFDurationTicks((const char *)parser->_lineRecordBytes + startDuration, endDuration - startDuration + 1);
+}
+
 void NewTagCallback(const void *parentparser, const uint64_t startTagName, const uint64_t endTagName, const uint64_t startTagData, const uint64_t endTagData) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    if (parser->_lineRecords != NULL) {
+        appendLineRecord(parser->_lineRecords, (RapidParserLineRecord){
+            .kind = RapidParserLineRecordKindTag,
+            .tagID = lineRecordTagID(parser, startTagName, endTagName),
+            .nameStart = startTagName,
+            .nameLength = endTagName - startTagName + 1,
+            .dataStart = startTagData,
+            .dataLength = endTagData - startTagData + 1
+        });
+        return;
+    }
     [parser newTagWithStartTagName:startTagName
                         endTagName:endTagName
                       startTagData:startTagData
@@ -65,11 +110,34 @@ void NewTagCallback(const void *parentparser, const uint64_t startTagName, const
 
 void NewTagNoDataCallback(const void *parentparser, const uint64_t startTagName, const uint64_t endTagName) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    if (parser->_lineRecords != NULL) {
+        appendLineRecord(parser->_lineRecords, (RapidParserLineRecord){
+            .kind = RapidParserLineRecordKindNoDataTag,
+            .tagID = lineRecordTagID(parser, startTagName, endTagName),
+            .nameStart = startTagName,
+            .nameLength = endTagName - startTagName + 1
+        });
+        return;
+    }
     [parser newNoDataTagWithStartTagName:startTagName endTagName:endTagName];
 }
 
 void NewEXTINFTagNoDataCallback(const void *parentparser, const uint64_t startTagName, const uint64_t endTagName, const uint64_t startDuration, const uint64_t endDuration, const uint64_t startTagData, const uint64_t endTagData) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    if (parser->_lineRecords != NULL) {
+        appendLineRecord(parser->_lineRecords, (RapidParserLineRecord){
+            .kind = RapidParserLineRecordKindEXTINFTag,
+            .tagID = lineRecordTagID(parser, startTagName, endTagName),
+            .nameStart = startTagName,
+            .nameLength = endTagName - startTagName + 1,
+            .dataStart = startTagData,
+            .dataLength = endTagData - startTagData + 1,
+            .durationStart = startDuration,
+            .durationLength = endDuration - startDuration + 1,
+            .durationTicks = lineRecordDurationTicks(parser, startDuration, endDuration)
+        });
+        return;
+    }
     [parser newEXTINFTagWithStartTagName:startTagName
                               endTagName:endTagName
                            startDuration:startDuration
@@ -80,14 +148,44 @@ void NewEXTINFTagNoDataCallback(const void *parentparser, const uint64_t startTa
 
 void NewCommentCallback(const void *parentparser, const uint64_t startComment, const uint64_t endComment) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    if (parser->_lineRecords != NULL) {
+        appendLineRecord(parser->_lineRecords, (RapidParserLineRecord){
+            .kind = RapidParserLineRecordKindComment,
+            .dataStart = startComment,
+            .dataLength = endComment - startComment + 1
+        });
+        return;
+    }
     [parser newCommentWithStart:startComment end:endComment];
 }
 
 bool NewURLCallback(const void *parentparser, const uint64_t startURL, const uint64_t endURL) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    if (parser->_lineRecords != NULL) {
+        appendLineRecord(parser->_lineRecords, (RapidParserLineRecord){
+            .kind = RapidParserLineRecordKindURL,
+            .dataStart = startURL,
+            .dataLength = endURL - startURL + 1
+        });
+        return true;
+    }
     return [parser newURLWithStart:startURL end:endURL] == YES;
 }
 
+bool ParseShouldContinue(const void *parentparser) {
+    RapidParser *parser = (__bridge RapidParser *)(parentparser);
+    RapidParserCancellation *cancellation = parser.cancellation;
+    if (cancellation == nil) {
+        return true;
+    }
+    const uint32_t errorNumber = [cancellation stopErrorNumber];
+    if (errorNumber == 0) {
+        return true;
+    }
+    ParseError(parentparser, errorNumber, errorNumber == RapidParserErrorCancelled ? RapidParserErrorCancelled_Message : RapidParserErrorTimedOut_Message);
+    return false;
+}
+
 void ParseComplete(const void *parentparser) {
     RapidParser *parser = (__bridge RapidParser *)(parentparser);
     [parser parseComplete];
@@ -99,13 +197,40 @@ void ParseError(const void *parentparser, const uint32_t errorNum, const char *e
     [parser parseError:error errorNumber:errorNum];
 }
 
+#pragma mark RapidParserPartition Interface
+
+/*
+ Scans one newline aligned partition of a playlist for `parseHLSDataToLineRecords:partitionCount:callback:`.
+ 
+ Line records (with offsets relative to the start of the partition) and any error are held on to rather
+ than passed on, so that the parent parser can join all the partitions once they are done.
+ */
+@interface RapidParserPartition : RapidParser {
+    @public
+    struct RapidParserLineRecordBuffer _partitionLineRecords;
+}
+
+@property (nonatomic, readonly) uint64_t start;
+@property (nonatomic, readonly) uint64_t length;
+@property (nonatomic, strong) NSString *errorString;
+@property (nonatomic, assign) UInt32 errorNumber;
+
+- (instancetype)initWithStart:(uint64_t)start length:(uint64_t)length;
+
++ (NSArray<RapidParserPartition *> *)partitionsOfBytes:(const unsigned char *)bytes length:(uint64_t)length count:(NSUInteger)count;
+
+- (void)parseBytes:(const unsigned char *)bytes;
+
+@end
+
 #pragma mark RapidParser Interface
 
 @interface RapidParser ()
 
-@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
 @property (nonatomic, strong) StaticMemoryStorage *storage;
 @property (nonatomic, weak) id<RapidParserCallback> callback;
+@property (nonatomic, weak) id<RapidParserLineRecordCallback> lineRecordCallback;
 
 @end
 
@@ -113,13 +238,19 @@ void ParseError(const void *parentparser, const uint32_t errorNum, const char *e
 
 @implementation RapidParser
 
-- (instancetype)init{
-    self = [super init];
-    if (self) {
+@synthesize queue = _queue;
+
+- (dispatch_queue_t)queue {
+    // created on first use, so that parsers that only ever parse synchronously never create one
+    if (_queue == nil) {
         dispatch_queue_attr_t qosAttribute = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
         _queue = dispatch_queue_create("com.comcast.mamba.RapidParser", qosAttribute);
     }
-    return self;
+    return _queue;
+}
+
+- (void)dealloc {
+    freeLineRecordBuffer(&_incrementalLineRecords);
 }
 
 #pragma mark Main Parser Method
@@ -133,10 +264,121 @@ void ParseError(const void *parentparser, const uint32_t errorNum, const char *e
     const uint64_t length = [storage length];
     
     dispatch_async(self.queue, ^{
+        if (!ParseShouldContinue((__bridge const void *)(self))) {
+            return;
+        }
         parseHLS((__bridge const void *)(self), bytes, length);
     });
 }
 
+- (void)parseHLSDataToLineRecords:(StaticMemoryStorage * _Nonnull)storage callback:(id<RapidParserLineRecordCallback> _Nonnull)callback {
+    [self parseHLSDataToLineRecords:storage partitionCount:1 callback:callback];
+}
+
+- (void)parseHLSDataToLineRecords:(StaticMemoryStorage * _Nonnull)storage partitionCount:(NSUInteger)partitionCount callback:(id<RapidParserLineRecordCallback> _Nonnull)callback {
+    
+    self.storage = storage;
+    self.lineRecordCallback = callback;
+    
+    const unsigned char *bytes = [storage bytes];
+    const uint64_t length = [storage length];
+    
+    dispatch_async(self.queue, ^{
+        [self scanLineRecordsOfBytes:bytes length:length partitionCount:partitionCount];
+    });
+}
+
+- (void)parseHLSDataToLineRecordsSynchronously:(StaticMemoryStorage * _Nonnull)storage partitionCount:(NSUInteger)partitionCount callback:(id<RapidParserLineRecordCallback> _Nonnull)callback {
+    
+    self.storage = storage;
+    self.lineRecordCallback = callback;
+    
+    [self scanLineRecordsOfBytes:[storage bytes] length:[storage length] partitionCount:partitionCount];
+}
+
+- (void)scanLineRecordsOfBytes:(const unsigned char *)bytes length:(const uint64_t)length partitionCount:(NSUInteger)partitionCount {
+    
+    if (partitionCount <= 1) {
+        struct RapidParserLineRecordBuffer lineRecords;
+        initializeLineRecordBuffer(&lineRecords, length);
+        _lineRecords = &lineRecords;
+        _lineRecordBytes = bytes;
+        
+        // a parse that is cancelled before it starts fails right away
+        if (ParseShouldContinue((__bridge const void *)(self))) {
+            parseHLS((__bridge const void *)(self), bytes, length);
+        }
+        
+        _lineRecords = NULL;
+        _lineRecordBytes = NULL;
+        freeLineRecordBuffer(&lineRecords);
+        return;
+    }
+    
+    NSArray<RapidParserPartition *> *partitions = [RapidParserPartition partitionsOfBytes:bytes length:length count:partitionCount];
+    for (RapidParserPartition *partition in partitions) {
+        partition.cancellation = self.cancellation;
+    }
+    
+    dispatch_apply(partitions.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t index) {
+        [partitions[index] parseBytes:bytes];
+    });
+    
+    // join the partitions last to first, which gives us the same records in the same order as `parseHLS` on the whole buffer
+    struct RapidParserLineRecordBuffer lineRecords;
+    initializeLineRecordBuffer(&lineRecords, length);
+    _lineRecords = &lineRecords;
+    
+    RapidParserPartition *failedPartition = nil;
+    for (RapidParserPartition *partition in partitions.reverseObjectEnumerator) {
+        if (partition.errorString != nil) {
+            // `parseHLS` stops at the first error it finds, which is the one closest to the end of the playlist
+            failedPartition = partition;
+            break;
+        }
+        appendLineRecordsWithOffset(&lineRecords, partition->_partitionLineRecords.records, partition->_partitionLineRecords.count, partition.start);
+    }
+    
+    if (failedPartition != nil) {
+        [self parseError:failedPartition.errorString errorNumber:failedPartition.errorNumber];
+    }
+    else {
+        [self parseComplete];
+    }
+    
+    _lineRecords = NULL;
+    freeLineRecordBuffer(&lineRecords);
+}
+
+#pragma mark Incremental Parser Methods
+
+- (void)beginIncrementalParseWithCallback:(id<RapidParserLineRecordCallback> _Nonnull)callback {
+    
+    self.lineRecordCallback = callback;
+    
+    freeLineRecordBuffer(&_incrementalLineRecords);
+    initializeLineRecordBuffer(&_incrementalLineRecords, 0);
+    _lineRecords = &_incrementalLineRecords;
+    
+    beginIncrementalParseHLS(&_incrementalState);
+}
+
+- (BOOL)feedIncrementalParse:(NSData * _Nonnull)data {
+    if (_lineRecords != &_incrementalLineRecords) {
+        // the parse has failed or has been finished
+        return NO;
+    }
+    return feedIncrementalParseHLS((__bridge const void *)(self), &_incrementalState, data.bytes, data.length) ? YES : NO;
+}
+
+- (void)finishIncrementalParse {
+    if (_lineRecords != &_incrementalLineRecords) {
+        // the parse has failed or has been finished
+        return;
+    }
+    finishIncrementalParseHLS((__bridge const void *)(self), &_incrementalState);
+}
+
 #pragma mark Fast C Parser callbacks
 
 /*
@@ -195,16 +437,97 @@ void ParseError(const void *parentparser, const uint32_t errorNum, const char *e
 }
 
 - (void)parseComplete {
-    [self.callback parseComplete];
-    self.storage = nil;
-    self.callback = nil;
+    if (_lineRecords != NULL) {
+        [self.lineRecordCallback parsedLineRecords:_lineRecords->records count:(NSUInteger)_lineRecords->count];
+    }
+    else {
+        [self.callback parseComplete];
+    }
+    [self endParse];
 }
 
 - (void)parseError:(NSString *)errorString
        errorNumber:(UInt32)errorNumber {
-    [self.callback parseError:errorString errorNumber:errorNumber];
+    if (_lineRecords != NULL) {
+        [self.lineRecordCallback parseError:errorString errorNumber:errorNumber];
+    }
+    else {
+        [self.callback parseError:errorString errorNumber:errorNumber];
+    }
+    [self endParse];
+}
+
+- (void)endParse {
+    if (_lineRecords == &_incrementalLineRecords) {
+        _lineRecords = NULL;
+        freeLineRecordBuffer(&_incrementalLineRecords);
+    }
     self.storage = nil;
     self.callback = nil;
+    self.lineRecordCallback = nil;
+}
+
+@end
+
+#pragma mark RapidParserPartition Implementation
+
+@implementation RapidParserPartition
+
+- (instancetype)initWithStart:(uint64_t)start length:(uint64_t)length {
+    self = [super init];
+    if (self) {
+        _start = start;
+        _length = length;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    freeLineRecordBuffer(&_partitionLineRecords);
+}
+
++ (NSArray<RapidParserPartition *> *)partitionsOfBytes:(const unsigned char *)bytes length:(uint64_t)length count:(NSUInteger)count {
+    
+    NSMutableArray<RapidParserPartition *> *partitions = [NSMutableArray arrayWithCapacity:count];
+    
+    uint64_t start = 0;
+    for (NSUInteger i = 1; i <= count; i++) {
+        uint64_t end = length;
+        if (i < count) {
+            // move the end of this partition forward until it's just past a newline, so no line is split
+            end = MAX(start, length / count * i);
+            while (end > 0 && end < length && bytes[end - 1] != '\n' && bytes[end - 1] != '\r') {
+                end++;
+            }
+        }
+        [partitions addObject:[[RapidParserPartition alloc] initWithStart:start length:end - start]];
+        start = end;
+    }
+    
+    return partitions;
+}
+
+- (void)parseBytes:(const unsigned char *)bytes {
+    initializeLineRecordBuffer(&_partitionLineRecords, self.length);
+    _lineRecords = &_partitionLineRecords;
+    _lineRecordBytes = bytes + self.start;
+    
+    if (ParseShouldContinue((__bridge const void *)(self))) {
+        parseHLS((__bridge const void *)(self), bytes + self.start, self.length);
+    }
+    
+    _lineRecords = NULL;
+    _lineRecordBytes = NULL;
+}
+
+- (void)parseComplete {
+    // the records are left in `_partitionLineRecords` for our parent parser
+}
+
+- (void)parseError:(NSString *)errorString
+       errorNumber:(UInt32)errorNumber {
+    self.errorString = errorString;
+    self.errorNumber = errorNumber;
 }
 
 @end
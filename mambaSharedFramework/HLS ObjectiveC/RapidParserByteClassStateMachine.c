@@ -0,0 +1,212 @@
+//
+//  RapidParserByteClassStateMachine.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#include "RapidParserByteClassStateMachine.h"
+
+const uint8_t byteClassTable[256] = {
+    ['\n'] = ByteClassNewline,
+    ['\r'] = ByteClassNewline,
+    ['#'] = ByteClassHash,
+    [','] = ByteClassComma,
+    [':'] = ByteClassColon,
+    ['E'] = ByteClassE,
+    ['F'] = ByteClassF,
+    ['I'] = ByteClassI,
+    ['N'] = ByteClassN,
+    ['T'] = ByteClassT,
+    ['X'] = ByteClassX,
+    // all other bytes are zero, i.e. ByteClassOther
+};
+
+/*
+ Every state shares the same basic rules as the Scanning state (see the diagram in
+ RapidParserState.h). Each state then has one byte class that moves it further along
+ towards a #EXT, #EXTINF or comment line.
+ */
+const uint8_t byteClassTransitionTable[numberOfScanningParseStates][numberOfByteClasses] = {
+    [Scanning] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForXForEXT] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = LookingForEForEXT,
+    },
+    [LookingForEForEXT] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = LookingForHashForEXT,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForHashForEXT] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForEXT,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForNewLineForEXT] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForEXT,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForNewLineForComment] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForComment,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForNForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = LookingForIForEXTINF,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForIForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = LookingForTForEXTINF,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForTForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXTINF,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForXForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = LookingForEForEXTINF,
+    },
+    [LookingForEForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = LookingForHashForEXTINF,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForHashForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForURL,
+        [ByteClassHash] = LookingForNewlineForEXTINF,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+    [LookingForNewlineForEXTINF] = {
+        [ByteClassOther] = Scanning,
+        [ByteClassNewline] = ByteClassActionEndOfLineForEXTINF,
+        [ByteClassHash] = LookingForNewLineForComment,
+        [ByteClassComma] = ByteClassActionAddComma,
+        [ByteClassColon] = ByteClassActionAddColon,
+        [ByteClassE] = Scanning,
+        [ByteClassF] = LookingForNForEXTINF,
+        [ByteClassI] = Scanning,
+        [ByteClassN] = Scanning,
+        [ByteClassT] = LookingForXForEXT,
+        [ByteClassX] = Scanning,
+    },
+};
@@ -0,0 +1,113 @@
+//
+//  RapidParserByteClassStateMachine.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#ifndef RapidParserByteClassStateMachine_h
+#define RapidParserByteClassStateMachine_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include "RapidParserState.h"
+#include "RapidParserLineState.h"
+#include "RapidParserStateHandlers.h"
+
+/*
+ A compact version of the `masterParseArray`.
+
+ Of the 256 possible byte values only 13 have any meaning to the parser, so rather than
+ a 13x256 array of function pointers we map each byte to one of a few byte classes and
+ look up an action in a small state x byte class table. The two tables together are
+ under 400 bytes, and the simple actions (state changes, recording a comma or colon) are
+ handled inline in `byteClassParseStep` without a function call.
+
+ The behavior must exactly match `masterParseArray`. See ParseArrayTests.m.
+ */
+
+enum ByteClass {
+    // any byte with no special meaning
+    ByteClassOther = 0,
+    // '\n' or '\r'
+    ByteClassNewline,
+    ByteClassHash,
+    ByteClassComma,
+    ByteClassColon,
+    ByteClassE,
+    ByteClassF,
+    ByteClassI,
+    ByteClassN,
+    ByteClassT,
+    ByteClassX,
+    // THIS NEEDS TO BE LAST IN THE BYTE CLASS LIST
+    numberOfByteClasses
+};
+
+/*
+ Entries in `byteClassTransitionTable`.
+
+ Any value less than `numberOfScanningParseStates` is a plain move to that `ParseState`
+ with no other side effects. The values below are actions that need to touch the `LineState`
+ or call back to our parent parser.
+ */
+enum ByteClassAction {
+    ByteClassActionAddComma = 0x80,
+    ByteClassActionAddColon,
+    ByteClassActionEndOfLineForURL,
+    ByteClassActionEndOfLineForEXT,
+    ByteClassActionEndOfLineForComment,
+    ByteClassActionEndOfLineForEXTINF
+};
+
+extern const uint8_t byteClassTable[256];
+
+extern const uint8_t byteClassTransitionTable[numberOfScanningParseStates][numberOfByteClasses];
+
+/**
+ Processes one byte. Takes the same parameters and returns the same new state as the
+ `parserStateHandler` found at `masterParseArray[currentState][character]`.
+ */
+static inline uint8_t byteClassParseStep(const void *parentparser, const unsigned char character, const uint64_t index, uint8_t currentState, struct LineState *lineState) {
+
+    const uint8_t action = byteClassTransitionTable[currentState][byteClassTable[character]];
+
+    if (action < ByteClassActionAddComma) {
+        return action;
+    }
+
+    switch (action) {
+        case ByteClassActionAddComma:
+            // overwriting the last comma is ok, we only care about the comma that's earliest in the line
+            lineState->commaPosition = index;
+            return Scanning;
+        case ByteClassActionAddColon:
+            // overwriting the last colon is ok, we only care about the colon that's earliest in the line
+            lineState->colonPosition = index;
+            return Scanning;
+        case ByteClassActionEndOfLineForURL:
+            return endOfLineForURLAndContinueScanning(parentparser, character, index, currentState, lineState);
+        case ByteClassActionEndOfLineForEXT:
+            return foundNewlineCompletingEXTBeginAndContinueScanning(parentparser, character, index, currentState, lineState);
+        case ByteClassActionEndOfLineForComment:
+            return foundNewlineForCommentBeginAndContinueScanning(parentparser, character, index, currentState, lineState);
+        case ByteClassActionEndOfLineForEXTINF:
+            return foundNewlineCompletingEXTINFBeginAndContinueScanning(parentparser, character, index, currentState, lineState);
+        default:
+            return Scanning;
+    }
+}
+
+#endif /* RapidParserByteClassStateMachine_h */
@@ -0,0 +1,62 @@
+//
+//  RapidParserCancellation.m
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#import "RapidParserCancellation.h"
+#import "RapidParserError.h"
+#import <stdatomic.h>
+
+@interface RapidParserCancellation () {
+    atomic_bool _cancelled;
+}
+@end
+
+@implementation RapidParserCancellation
+
+- (instancetype)init {
+    return [self initWithDeadline:DISPATCH_TIME_FOREVER];
+}
+
+- (instancetype)initWithDeadline:(dispatch_time_t)deadline {
+    self = [super init];
+    if (self) {
+        _deadline = deadline;
+        atomic_init(&_cancelled, false);
+    }
+    return self;
+}
+
+- (BOOL)isCancelled {
+    return atomic_load_explicit(&_cancelled, memory_order_relaxed) ? YES : NO;
+}
+
+- (void)cancel {
+    atomic_store_explicit(&_cancelled, true, memory_order_relaxed);
+}
+
+- (uint32_t)stopErrorNumber {
+    if (atomic_load_explicit(&_cancelled, memory_order_relaxed)) {
+        return RapidParserErrorCancelled;
+    }
+    if (_deadline != DISPATCH_TIME_FOREVER && dispatch_time(DISPATCH_TIME_NOW, 0) >= _deadline) {
+        return RapidParserErrorTimedOut;
+    }
+    return 0;
+}
+
+@end
@@ -31,6 +31,14 @@ const uint32_t RapidParserErrorMissingTagData = PlaylistParserInternalErrorCodeM
 
 const uint32_t RapidParserErrorMissingTagDataForEXTINF = PlaylistParserInternalErrorCodeMissingTagDataForEXTINF;
 
+const uint32_t RapidParserErrorCancelled = PlaylistParserInternalErrorCodeCancelled;
+
+const uint32_t RapidParserErrorTimedOut = PlaylistParserInternalErrorCodeTimedOut;
+
 const char * RapidParserErrorMissingTagData_Message = "Found a tag with missing tag data";
 
 const char * RapidParserErrorMissingTagDataForEXTINF_Message = "Found an EXTINF tag with missing tag data";
+
+const char * RapidParserErrorCancelled_Message = "The parse was cancelled";
+
+const char * RapidParserErrorTimedOut_Message = "The parse deadline passed";
@@ -0,0 +1,182 @@
+//
+//  RapidParserIncremental.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#include "RapidParserIncremental.h"
+#include "RapidParserNewTagCallbacks.h"
+#include "RapidParserError.h"
+#include "RapidParserDebug.h"
+
+static void resetLineState(struct RapidParserIncrementalState *incrementalState) {
+    initializeLineState(&incrementalState->lineState);
+    incrementalState->state = IncrementalLineStart;
+}
+
+/*
+ Lines are classified from their first seven bytes ("#EXTINF"), which is where `parseHLS` ends up
+ deciding what a line is when it scans back to the newline.
+ */
+static inline uint8_t nextLineState(const uint8_t state, const unsigned char character) {
+    switch (state) {
+        case IncrementalLineStart:
+            return character == '#' ? IncrementalFoundHash : IncrementalInURL;
+        case IncrementalFoundHash:
+            return character == 'E' ? IncrementalFoundHashE : IncrementalInComment;
+        case IncrementalFoundHashE:
+            return character == 'X' ? IncrementalFoundHashEX : IncrementalInComment;
+        case IncrementalFoundHashEX:
+            return character == 'T' ? IncrementalFoundHashEXT : IncrementalInComment;
+        case IncrementalFoundHashEXT:
+            return character == 'I' ? IncrementalFoundHashEXTI : IncrementalInTag;
+        case IncrementalFoundHashEXTI:
+            return character == 'N' ? IncrementalFoundHashEXTIN : IncrementalInTag;
+        case IncrementalFoundHashEXTIN:
+            return character == 'F' ? IncrementalInEXTINFTag : IncrementalInTag;
+        default:
+            return state;
+    }
+}
+
+/*
+ Called when we find a newline (or at the end of the playlist). `end` is the index of the last byte in the line.
+ Makes the same callbacks that the `parseHLS` end of line handlers would make for the same line.
+ */
+static uint8_t completeLine(const void *parentparser, struct RapidParserIncrementalState *incrementalState, const int64_t end) {
+
+    struct LineState *lineState = &incrementalState->lineState;
+
+    switch (incrementalState->state) {
+        case IncrementalLineStart:
+            // this is either a blank line or a \r\n pair. We're not going to parse this, just keep moving
+            break;
+        case IncrementalFoundHash:
+        case IncrementalFoundHashE:
+        case IncrementalFoundHashEX:
+        case IncrementalInComment:
+            NewCommentCallback(parentparser, lineState->start, end);
+            break;
+        case IncrementalFoundHashEXT:
+        case IncrementalFoundHashEXTI:
+        case IncrementalFoundHashEXTIN:
+        case IncrementalInTag:
+            if ( lineState->colonPosition == lineStateInvalidValue ) {
+                // we are a no value tag
+                NewTagNoDataCallback(parentparser, lineState->start, end);
+                break;
+            }
+            if (end - lineState->colonPosition == 0) {
+                ParseError(parentparser, RapidParserErrorMissingTagData, RapidParserErrorMissingTagData_Message);
+                return IncrementalErrorEarlyExit;
+            }
+            NewTagCallback(parentparser, lineState->start, (lineState->colonPosition - 1), (lineState->colonPosition + 1), end);
+            break;
+        case IncrementalInEXTINFTag: {
+            if ( lineState->colonPosition == lineStateInvalidValue ) {
+                // this is an error, all EXTINF tags must have a :
+                ParseError(parentparser, RapidParserErrorMissingTagDataForEXTINF, RapidParserErrorMissingTagDataForEXTINF_Message);
+                return IncrementalErrorEarlyExit;
+            }
+            if (end - lineState->colonPosition == 0) {
+                ParseError(parentparser, RapidParserErrorMissingTagData, RapidParserErrorMissingTagData_Message);
+                return IncrementalErrorEarlyExit;
+            }
+            int64_t endDurationPosition = end;
+            if ( lineState->commaPosition != lineStateInvalidValue ) {
+                endDurationPosition = lineState->commaPosition - 1;
+            }
+            NewEXTINFTagNoDataCallback(parentparser, lineState->start, (lineState->colonPosition - 1), (lineState->colonPosition + 1), endDurationPosition, (lineState->colonPosition + 1), end);
+            break;
+        }
+        case IncrementalInURL:
+            if (!NewURLCallback(parentparser, lineState->start, end)) {
+                return IncrementalEarlyExit;
+            }
+            break;
+        default:
+            break;
+    }
+    resetLineState(incrementalState);
+    return IncrementalLineStart;
+}
+
+void beginIncrementalParseHLS(struct RapidParserIncrementalState *incrementalState) {
+    incrementalState->position = 0;
+    resetLineState(incrementalState);
+
+    rapid_parser_debug_print("Begining incremental parse of hls data\n");
+}
+
+bool feedIncrementalParseHLS(const void *parentparser, struct RapidParserIncrementalState *incrementalState, const unsigned char *bytes, const uint64_t length) {
+
+    struct LineState *lineState = &incrementalState->lineState;
+    const uint64_t offset = incrementalState->position;
+    uint8_t state = incrementalState->state;
+
+    for (uint64_t i = 0; i < length && state < IncrementalEarlyExit; i++) {
+
+        const unsigned char character = bytes[i];
+        const int64_t index = (int64_t)(offset + i);
+
+        if (character == '\n' || character == '\r') {
+            incrementalState->state = state;
+            state = completeLine(parentparser, incrementalState, index - 1);
+            continue;
+        }
+        if (state == IncrementalLineStart) {
+            lineState->start = index;
+        }
+        // unlike `parseHLS`, we see the earliest comma and colon in the line first, so we do not overwrite them
+        if (character == ':') {
+            if (lineState->colonPosition == lineStateInvalidValue) {
+                lineState->colonPosition = index;
+            }
+        }
+        else if (character == ',') {
+            if (lineState->commaPosition == lineStateInvalidValue) {
+                lineState->commaPosition = index;
+            }
+        }
+        state = nextLineState(state, character);
+    }
+
+    incrementalState->state = state;
+    incrementalState->position = offset + length;
+
+    return state < IncrementalEarlyExit;
+}
+
+void finishIncrementalParseHLS(const void *parentparser, struct RapidParserIncrementalState *incrementalState) {
+
+    if (incrementalState->state >= IncrementalEarlyExit) {
+        // if we are in IncrementalErrorEarlyExit another part of the code already called ParseError to exit out
+        // if we are in IncrementalEarlyExit, its because the client has asked us to exit and they know that parsing is complete
+        return;
+    }
+
+    // handle the final line, force a line completion as if there were a newline after the last byte
+    incrementalState->state = completeLine(parentparser, incrementalState, (int64_t)incrementalState->position - 1);
+
+    if (incrementalState->state < IncrementalEarlyExit) {
+
+        rapid_parser_debug_print("Ending incremental parse of hls data with length %llu\n", incrementalState->position);
+
+        // mark the parse as finished so that any further calls are ignored
+        incrementalState->state = IncrementalEarlyExit;
+        ParseComplete(parentparser);
+    }
+}
@@ -0,0 +1,96 @@
+//
+//  RapidParserIncremental.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#ifndef RapidParserIncremental_h
+#define RapidParserIncremental_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "RapidParserLineState.h"
+
+/*
+ A forward scanning, resumable version of `parseHLS`.
+
+ `parseHLS` scans a complete buffer from the end to the beginning. This parser scans from the
+ beginning and can be fed the playlist in arbitrarily sized chunks as it arrives. All state needed
+ to resume (including a partial line) is kept in `RapidParserIncrementalState`, so the caller never
+ has to hand us a byte twice.
+
+ All indexes passed to the `RapidParserNewTagCallbacks` are offsets from the start of the first
+ chunk, i.e. they are offsets into the concatenation of all chunks fed so far.
+
+ Lines are classified exactly as `parseHLS` classifies them, but callbacks are made in document order.
+ Note that if a playlist has more than one error, this parser will report the first one, while
+ `parseHLS` reports the last one.
+ */
+
+enum IncrementalLineState {
+    // at the start of a line, nothing found yet
+    IncrementalLineStart = 0,
+    // found "#"
+    IncrementalFoundHash,
+    // found "#E"
+    IncrementalFoundHashE,
+    // found "#EX"
+    IncrementalFoundHashEX,
+    // found "#EXT", this is a tag
+    IncrementalFoundHashEXT,
+    // found "#EXTI", this is a tag
+    IncrementalFoundHashEXTI,
+    // found "#EXTIN", this is a tag
+    IncrementalFoundHashEXTIN,
+    // this line is a tag
+    IncrementalInTag,
+    // this line is a #EXTINF tag
+    IncrementalInEXTINFTag,
+    // this line is a comment
+    IncrementalInComment,
+    // this line is a url
+    IncrementalInURL,
+    // the client has asked us to stop scanning
+    IncrementalEarlyExit,
+    // we have found an error and called ParseError
+    IncrementalErrorEarlyExit
+};
+
+struct RapidParserIncrementalState {
+    // offset of the next byte we will be fed
+    uint64_t position;
+    // a `IncrementalLineState` value
+    uint8_t state;
+    // `start`, `colonPosition` and `commaPosition` for the line in progress. `end` is unused.
+    struct LineState lineState;
+};
+
+void beginIncrementalParseHLS(struct RapidParserIncrementalState *incrementalState);
+
+/**
+ Scans the next chunk of the playlist.
+
+ @return false if the parse has stopped (because of an error or an early exit) and further data will be ignored.
+ */
+bool feedIncrementalParseHLS(const void *parentparser, struct RapidParserIncrementalState *incrementalState, const unsigned char *bytes, const uint64_t length);
+
+/**
+ Completes the final line (if any) and calls `ParseComplete`, unless the parse has already stopped.
+ */
+void finishIncrementalParseHLS(const void *parentparser, struct RapidParserIncrementalState *incrementalState);
+
+#endif /* RapidParserIncremental_h */
@@ -0,0 +1,85 @@
+//
+//  RapidParserLineRecordBuffer.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#ifndef RapidParserLineRecordBuffer_h
+#define RapidParserLineRecordBuffer_h
+
+#include <stdlib.h>
+#include "RapidParserLineRecord.h"
+
+/*
+ Growable, contiguous array of `RapidParserLineRecord`s that the parser callbacks write into
+ when the RapidParser is parsing to line records.
+ */
+struct RapidParserLineRecordBuffer {
+    RapidParserLineRecord *records;
+    uint64_t count;
+    uint64_t capacity;
+};
+
+// A rough guess at the average line length of a playlist, used to size the buffer up front
+static const uint64_t lineRecordBufferEstimatedBytesPerLine = 48;
+static const uint64_t lineRecordBufferMinimumCapacity = 64;
+
+static inline void initializeLineRecordBuffer(struct RapidParserLineRecordBuffer *buffer, const uint64_t playlistLength) {
+    uint64_t capacity = playlistLength / lineRecordBufferEstimatedBytesPerLine;
+    if (capacity < lineRecordBufferMinimumCapacity) {
+        capacity = lineRecordBufferMinimumCapacity;
+    }
+    buffer->records = malloc(capacity * sizeof(RapidParserLineRecord));
+    buffer->count = 0;
+    buffer->capacity = buffer->records != NULL ? capacity : 0;
+}
+
+static inline void freeLineRecordBuffer(struct RapidParserLineRecordBuffer *buffer) {
+    free(buffer->records);
+    buffer->records = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+}
+
+static inline void appendLineRecord(struct RapidParserLineRecordBuffer *buffer, const RapidParserLineRecord record) {
+    if (buffer->count == buffer->capacity) {
+        uint64_t newCapacity = buffer->capacity > 0 ? buffer->capacity * 2 : lineRecordBufferMinimumCapacity;
+        RapidParserLineRecord *newRecords = realloc(buffer->records, newCapacity * sizeof(RapidParserLineRecord));
+        if (newRecords == NULL) {
+            abort();
+        }
+        buffer->records = newRecords;
+        buffer->capacity = newCapacity;
+    }
+    buffer->records[buffer->count] = record;
+    buffer->count += 1;
+}
+
+/*
+ Appends `count` records, moving each one's spans forward by `offset` bytes. Used to join records that
+ were found in a part of a larger buffer.
+ */
+static inline void appendLineRecordsWithOffset(struct RapidParserLineRecordBuffer *buffer, const RapidParserLineRecord *records, const uint64_t count, const uint64_t offset) {
+    for (uint64_t i = 0; i < count; i++) {
+        RapidParserLineRecord record = records[i];
+        record.nameStart += offset;
+        record.dataStart += offset;
+        record.durationStart += offset;
+        appendLineRecord(buffer, record);
+    }
+}
+
+#endif /* RapidParserLineRecordBuffer_h */
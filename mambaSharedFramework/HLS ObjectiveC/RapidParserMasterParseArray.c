@@ -35,6 +35,11 @@
  This file greatly abuses the preprocessor. The function pointers for each
  state are defined in seperate files for readability (in ".include" files)
  and are included here via the preprocessor.
+ 
+ Note that `parseHLS` no longer dispatches through this array. It uses the much smaller
+ byte class tables in RapidParserByteClassStateMachine.h instead. This array is kept as
+ the readable reference definition of the parser, and the unit tests check that the
+ byte class tables behave identically to it.
  */
 
 const parserStateHandler masterParseArray[numberOfScanningParseStates][256] = {
@@ -29,6 +29,8 @@ void NewEXTINFTagNoDataCallback(const void *parentparser, const uint64_t startTa
 void NewCommentCallback(const void *parentparser, const uint64_t startComment, const uint64_t endComment);
 // return true to NewURLCallback to continue scanning, false to trigger an early exit and stop the parse
 bool NewURLCallback(const void *parentparser, const uint64_t startURL, const uint64_t endURL);
+// called every `parseContinueCheckInterval` bytes. return false to stop the parse, after calling ParseError to say why
+bool ParseShouldContinue(const void *parentparser);
 void ParseComplete(const void *parentparser);
 void ParseError(const void *parentparser, const uint32_t errorNum, const char *errorString);
 
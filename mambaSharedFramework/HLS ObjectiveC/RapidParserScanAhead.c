@@ -0,0 +1,149 @@
+//
+//  RapidParserScanAhead.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#include "RapidParserScanAhead.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RAPID_PARSER_SCAN_AHEAD_AVX2 (1)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define RAPID_PARSER_SCAN_AHEAD_SSE2 (1)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RAPID_PARSER_SCAN_AHEAD_NEON (1)
+#endif
+
+static const bool scanningStateInterestingBytes[256] = {
+    ['\n'] = true,
+    ['\r'] = true,
+    ['#'] = true,
+    [','] = true,
+    [':'] = true,
+    ['F'] = true,
+    ['T'] = true,
+};
+
+bool isInterestingByteForScanningState(const unsigned char byte) {
+    return scanningStateInterestingBytes[byte];
+}
+
+// Scalar fallback, also used for the tail of the buffer that is too short for a vector load
+static inline uint64_t skipBackwardsScalar(const unsigned char *bytes, uint64_t index, const uint64_t limit) {
+    while (index > limit && !scanningStateInterestingBytes[bytes[index - 1]]) {
+        index -= 1;
+    }
+    return index;
+}
+
+#if RAPID_PARSER_SCAN_AHEAD_AVX2
+
+uint64_t skipBackwardsToInterestingByteForScanningState(const unsigned char *bytes, uint64_t index) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriageReturn = _mm256_set1_epi8('\r');
+    const __m256i hash = _mm256_set1_epi8('#');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i capitalF = _mm256_set1_epi8('F');
+    const __m256i capitalT = _mm256_set1_epi8('T');
+
+    while (index >= 32) {
+        const __m256i block = _mm256_loadu_si256((const __m256i *)(bytes + index - 32));
+        __m256i match = _mm256_or_si256(_mm256_cmpeq_epi8(block, newline), _mm256_cmpeq_epi8(block, carriageReturn));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, hash));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, comma));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, colon));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, capitalF));
+        match = _mm256_or_si256(match, _mm256_cmpeq_epi8(block, capitalT));
+        const uint32_t mask = (uint32_t)_mm256_movemask_epi8(match);
+        if (mask != 0) {
+            // the highest set bit is the interesting byte closest to `index`
+            return index - 32 + (32 - (uint64_t)__builtin_clz(mask));
+        }
+        index -= 32;
+    }
+    return skipBackwardsScalar(bytes, index, 0);
+}
+
+#elif RAPID_PARSER_SCAN_AHEAD_SSE2
+
+uint64_t skipBackwardsToInterestingByteForScanningState(const unsigned char *bytes, uint64_t index) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    const __m128i hash = _mm_set1_epi8('#');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i capitalF = _mm_set1_epi8('F');
+    const __m128i capitalT = _mm_set1_epi8('T');
+
+    while (index >= 16) {
+        const __m128i block = _mm_loadu_si128((const __m128i *)(bytes + index - 16));
+        __m128i match = _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, carriageReturn));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, hash));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, comma));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, colon));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, capitalF));
+        match = _mm_or_si128(match, _mm_cmpeq_epi8(block, capitalT));
+        const uint32_t mask = (uint32_t)_mm_movemask_epi8(match);
+        if (mask != 0) {
+            // the highest set bit is the interesting byte closest to `index`
+            return index - 16 + (32 - (uint64_t)__builtin_clz(mask));
+        }
+        index -= 16;
+    }
+    return skipBackwardsScalar(bytes, index, 0);
+}
+
+#elif RAPID_PARSER_SCAN_AHEAD_NEON
+
+uint64_t skipBackwardsToInterestingByteForScanningState(const unsigned char *bytes, uint64_t index) {
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    const uint8x16_t carriageReturn = vdupq_n_u8('\r');
+    const uint8x16_t hash = vdupq_n_u8('#');
+    const uint8x16_t comma = vdupq_n_u8(',');
+    const uint8x16_t colon = vdupq_n_u8(':');
+    const uint8x16_t capitalF = vdupq_n_u8('F');
+    const uint8x16_t capitalT = vdupq_n_u8('T');
+
+    while (index >= 16) {
+        const uint8x16_t block = vld1q_u8(bytes + index - 16);
+        uint8x16_t match = vorrq_u8(vceqq_u8(block, newline), vceqq_u8(block, carriageReturn));
+        match = vorrq_u8(match, vceqq_u8(block, hash));
+        match = vorrq_u8(match, vceqq_u8(block, comma));
+        match = vorrq_u8(match, vceqq_u8(block, colon));
+        match = vorrq_u8(match, vceqq_u8(block, capitalF));
+        match = vorrq_u8(match, vceqq_u8(block, capitalT));
+        // NEON has no movemask. Narrowing each 16 bit lane by 4 leaves a 64 bit value with one nibble per byte.
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+        if (mask != 0) {
+            // the highest set nibble is the interesting byte closest to `index`
+            return index - 16 + (16 - ((uint64_t)__builtin_clzll(mask) >> 2));
+        }
+        index -= 16;
+    }
+    return skipBackwardsScalar(bytes, index, 0);
+}
+
+#else
+
+uint64_t skipBackwardsToInterestingByteForScanningState(const unsigned char *bytes, uint64_t index) {
+    return skipBackwardsScalar(bytes, index, 0);
+}
+
+#endif
@@ -0,0 +1,56 @@
+//
+//  RapidParserScanAhead.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#ifndef RapidParserScanAhead_h
+#define RapidParserScanAhead_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ In the Scanning state, almost every byte we look at (URL characters, attribute
+ text, digits) maps to `noOpContinueScanning` in the `masterParseArray`. The only
+ bytes that do anything are `\n`, `\r`, `#`, `,`, `:`, `F` and `T`. Everything else
+ leaves us in Scanning with no change to the `LineState`, so we can jump over runs of
+ them without dispatching through the parse array.
+
+ The table in RapidParserScanAhead.c must match the non-`noOpContinueScanning` entries
+ in `RapidParser_ScanningState_ParseArray.include`.
+ */
+
+/**
+ Returns true if `byte` would cause an action or a state change while in the Scanning state.
+ */
+bool isInterestingByteForScanningState(const unsigned char byte);
+
+/**
+ Skips backwards over bytes that are uninteresting in the Scanning state.
+
+ @param bytes The buffer being parsed.
+ @param index The current parse index. `bytes[index - 1]` is the next byte the parser would look at.
+
+ @return A new index `n <= index` such that every byte in `bytes[n ..< index]` is uninteresting and
+ `bytes[n - 1]` is interesting. If no interesting byte exists before `index`, 0 is returned.
+
+ Uses SSE2 (or AVX2 if the target enables it) on x86, NEON on ARM and a scalar fallback elsewhere.
+ */
+uint64_t skipBackwardsToInterestingByteForScanningState(const unsigned char *bytes, uint64_t index);
+
+#endif /* RapidParserScanAhead_h */
@@ -166,9 +166,6 @@ uint8_t foundHashLookingForNewlineForEXTINF(const void *parentparser, const unsi
 
 uint8_t foundNewlineCompletingEXTINFBeginAndContinueScanning(const void *parentparser, const unsigned char character, const uint64_t index, uint8_t currentState, struct LineState *lineState) {
     
-    static uint64_t commaPosition = 0;
-    static uint64_t endDurationPosition = 0;
-
     // index is currently a newline. we do not want to include it
     lineState->start = index + 1;
     
@@ -183,11 +180,10 @@ uint8_t foundNewlineCompletingEXTINFBeginAndContinueScanning(const void *parentp
         return ErrorEarlyExit;
     }
     
-    commaPosition = lineState->end;
-    endDurationPosition = lineState->end;
+    // locals rather than statics, since partitions of a parallel parse run this handler concurrently
+    uint64_t endDurationPosition = lineState->end;
     if ( lineState->commaPosition != lineStateInvalidValue ) {
-        commaPosition = lineState->commaPosition;
-        endDurationPosition = commaPosition - 1;
+        endDurationPosition = lineState->commaPosition - 1;
     }
 
     NewEXTINFTagNoDataCallback(parentparser, lineState->start, (lineState->colonPosition - 1), (lineState->colonPosition + 1), endDurationPosition, (lineState->colonPosition + 1), lineState->end);
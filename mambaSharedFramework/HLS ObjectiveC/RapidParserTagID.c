@@ -0,0 +1,127 @@
+//
+//  RapidParserTagID.c
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#include <string.h>
+#include "RapidParserTagID.h"
+
+struct TagName {
+    const char *name;
+    uint64_t length;
+};
+
+#define TAG_NAME(string) { string, sizeof(string) - 1 }
+
+static const struct TagName tagNames[numberOfRapidParserTagIDs] = {
+    [RapidParserTagIDNone] = { NULL, 0 },
+    [RapidParserTagIDEXTM3U] = TAG_NAME("#EXTM3U"),
+    [RapidParserTagIDEXT_X_VERSION] = TAG_NAME("#EXT-X-VERSION"),
+    [RapidParserTagIDEXT_X_MEDIA] = TAG_NAME("#EXT-X-MEDIA"),
+    [RapidParserTagIDEXT_X_STREAM_INF] = TAG_NAME("#EXT-X-STREAM-INF"),
+    [RapidParserTagIDEXT_X_I_FRAME_STREAM_INF] = TAG_NAME("#EXT-X-I-FRAME-STREAM-INF"),
+    [RapidParserTagIDEXT_X_SESSION_DATA] = TAG_NAME("#EXT-X-SESSION-DATA"),
+    [RapidParserTagIDEXT_X_SESSION_KEY] = TAG_NAME("#EXT-X-SESSION-KEY"),
+    [RapidParserTagIDEXT_X_CONTENT_STEERING] = TAG_NAME("#EXT-X-CONTENT-STEERING"),
+    [RapidParserTagIDEXT_X_TARGETDURATION] = TAG_NAME("#EXT-X-TARGETDURATION"),
+    [RapidParserTagIDEXT_X_MEDIA_SEQUENCE] = TAG_NAME("#EXT-X-MEDIA-SEQUENCE"),
+    [RapidParserTagIDEXT_X_ENDLIST] = TAG_NAME("#EXT-X-ENDLIST"),
+    [RapidParserTagIDEXT_X_PLAYLIST_TYPE] = TAG_NAME("#EXT-X-PLAYLIST-TYPE"),
+    [RapidParserTagIDEXT_X_I_FRAMES_ONLY] = TAG_NAME("#EXT-X-I-FRAMES-ONLY"),
+    [RapidParserTagIDEXT_X_ALLOW_CACHE] = TAG_NAME("#EXT-X-ALLOW-CACHE"),
+    [RapidParserTagIDEXT_X_INDEPENDENT_SEGMENTS] = TAG_NAME("#EXT-X-INDEPENDENT-SEGMENTS"),
+    [RapidParserTagIDEXT_X_START] = TAG_NAME("#EXT-X-START"),
+    [RapidParserTagIDEXTINF] = TAG_NAME("#EXTINF"),
+    [RapidParserTagIDEXT_X_BITRATE] = TAG_NAME("#EXT-X-BITRATE"),
+    [RapidParserTagIDEXT_X_BYTERANGE] = TAG_NAME("#EXT-X-BYTERANGE"),
+    [RapidParserTagIDEXT_X_KEY] = TAG_NAME("#EXT-X-KEY"),
+    [RapidParserTagIDEXT_X_MAP] = TAG_NAME("#EXT-X-MAP"),
+    [RapidParserTagIDEXT_X_PROGRAM_DATE_TIME] = TAG_NAME("#EXT-X-PROGRAM-DATE-TIME"),
+    [RapidParserTagIDEXT_X_DISCONTINUITY] = TAG_NAME("#EXT-X-DISCONTINUITY"),
+    [RapidParserTagIDEXT_X_DISCONTINUITY_SEQUENCE] = TAG_NAME("#EXT-X-DISCONTINUITY-SEQUENCE"),
+    [RapidParserTagIDEXT_X_DATERANGE] = TAG_NAME("#EXT-X-DATERANGE"),
+    [RapidParserTagIDEXT_X_SKIP] = TAG_NAME("#EXT-X-SKIP"),
+};
+
+/*
+ A perfect hash of the tag names above into 64 slots.
+ 
+ Every name starts with "#EXT", so we mix the length with the last byte and the byte after "#EXT-X-"
+ (or the last byte again for the short names). The multiplier was found by searching for one with no
+ collisions. If you add a tag, you will need to check that it still has none, see RapidParserTagIDTests.m.
+ */
+enum {
+    tagIDHashSlotCount = 64
+};
+
+static inline uint8_t tagIDHashSlot(const unsigned char *name, const uint64_t length) {
+    const unsigned char last = name[length - 1];
+    const unsigned char mix = name[length > 7 ? 7 : length - 1];
+    return (uint8_t)((length + last * 15 + mix) & (tagIDHashSlotCount - 1));
+}
+
+static const uint8_t tagIDHashSlots[tagIDHashSlotCount] = {
+    [1] = RapidParserTagIDEXT_X_INDEPENDENT_SEGMENTS,
+    [3] = RapidParserTagIDEXT_X_CONTENT_STEERING,
+    [7] = RapidParserTagIDEXT_X_MAP,
+    [11] = RapidParserTagIDEXT_X_START,
+    [12] = RapidParserTagIDEXT_X_KEY,
+    [14] = RapidParserTagIDEXT_X_SKIP,
+    [15] = RapidParserTagIDEXT_X_DISCONTINUITY,
+    [20] = RapidParserTagIDEXT_X_I_FRAMES_ONLY,
+    [23] = RapidParserTagIDEXTM3U,
+    [27] = RapidParserTagIDEXT_X_BITRATE,
+    [28] = RapidParserTagIDEXT_X_SESSION_KEY,
+    [29] = RapidParserTagIDEXT_X_BYTERANGE,
+    [30] = RapidParserTagIDEXT_X_ALLOW_CACHE,
+    [31] = RapidParserTagIDEXT_X_DATERANGE,
+    [39] = RapidParserTagIDEXTINF,
+    [40] = RapidParserTagIDEXT_X_MEDIA,
+    [44] = RapidParserTagIDEXT_X_DISCONTINUITY_SEQUENCE,
+    [45] = RapidParserTagIDEXT_X_MEDIA_SEQUENCE,
+    [47] = RapidParserTagIDEXT_X_PLAYLIST_TYPE,
+    [51] = RapidParserTagIDEXT_X_PROGRAM_DATE_TIME,
+    [53] = RapidParserTagIDEXT_X_SESSION_DATA,
+    [54] = RapidParserTagIDEXT_X_VERSION,
+    [59] = RapidParserTagIDEXT_X_TARGETDURATION,
+    [60] = RapidParserTagIDEXT_X_I_FRAME_STREAM_INF,
+    [62] = RapidParserTagIDEXT_X_STREAM_INF,
+    [63] = RapidParserTagIDEXT_X_ENDLIST,
+};
+
+RapidParserTagID rapidParserTagIDForTagName(const unsigned char *name, uint64_t length) {
+    if (length == 0) {
+        return RapidParserTagIDNone;
+    }
+    const uint8_t tagID = tagIDHashSlots[tagIDHashSlot(name, length)];
+    if (tagID == RapidParserTagIDNone) {
+        return RapidParserTagIDNone;
+    }
+    // the slot tells us the only tag this can be, we still have to check that it is
+    const struct TagName tagName = tagNames[tagID];
+    if (tagName.length != length || memcmp(tagName.name, name, length) != 0) {
+        return RapidParserTagIDNone;
+    }
+    return (RapidParserTagID)tagID;
+}
+
+const char *rapidParserTagNameForTagID(uint8_t tagID) {
+    if (tagID >= numberOfRapidParserTagIDs) {
+        return NULL;
+    }
+    return tagNames[tagID].name;
+}
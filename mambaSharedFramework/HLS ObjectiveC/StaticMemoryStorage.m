@@ -18,6 +18,27 @@
 //
 
 #import "StaticMemoryStorage.h"
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <fcntl.h>
+#import <unistd.h>
+
+typedef NS_ENUM(uint8_t, StaticMemoryStorageOwnership) {
+    // we malloc'ed `_bytes` and must free it
+    StaticMemoryStorageOwnershipMalloc = 0,
+    // `_bytes` belongs to `_data`
+    StaticMemoryStorageOwnershipData,
+    // `_bytes` is a read-only mapping of a file and must be unmapped
+    StaticMemoryStorageOwnershipMappedFile
+};
+
+@interface StaticMemoryStorage () {
+    StaticMemoryStorageOwnership _ownership;
+    NSData *_data;
+    // the number of bytes of the document of `_precedingStorage` that come before our bytes
+    NSUInteger _precedingLength;
+}
+@end
 
 @implementation StaticMemoryStorage
 
@@ -26,6 +47,7 @@
     if (self) {
         _length = 0;
         _bytes = 0;
+        _ownership = StaticMemoryStorageOwnershipMalloc;
     }
     return self;
 }
@@ -37,14 +59,147 @@
         [data getBytes:buffer length:data.length];
         _bytes = buffer;
         _length = data.length;
+        _ownership = StaticMemoryStorageOwnershipMalloc;
+    }
+    return self;
+}
+
+- (instancetype)initWithDataNoCopy:(NSData *)data {
+    self = [super init];
+    if (self) {
+        // `copy` on an immutable NSData just retains it, but protects us from a NSMutableData changing underneath us
+        _data = [data copy];
+        _bytes = _data.bytes;
+        _length = _data.length;
+        _ownership = StaticMemoryStorageOwnershipData;
     }
     return self;
 }
 
+- (instancetype)initWithBytes:(const void *)bytes
+                       length:(NSUInteger)length
+             precedingStorage:(StaticMemoryStorage *)precedingStorage
+              precedingLength:(NSUInteger)precedingLength {
+    NSParameterAssert(precedingLength <= precedingStorage.documentLength);
+    self = [super init];
+    if (self) {
+        if (length > 0) {
+            void *buffer = malloc(length);
+            memcpy(buffer, bytes, length);
+            _bytes = buffer;
+        }
+        _length = length;
+        _ownership = StaticMemoryStorageOwnershipMalloc;
+        _precedingStorage = precedingStorage;
+        _precedingLength = MIN(precedingLength, precedingStorage.documentLength);
+        _precedingStorageCount = precedingStorage.precedingStorageCount + 1;
+    }
+    return self;
+}
+
+- (instancetype)initWithContentsOfFileAtPath:(NSString *)path error:(NSError **)error {
+    self = [super init];
+    if (self) {
+        _ownership = StaticMemoryStorageOwnershipMappedFile;
+        
+        int fileDescriptor = open(path.fileSystemRepresentation, O_RDONLY);
+        if (fileDescriptor < 0) {
+            return [self failWithErrno:errno path:path error:error];
+        }
+        
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) != 0) {
+            int statErrno = errno;
+            close(fileDescriptor);
+            return [self failWithErrno:statErrno path:path error:error];
+        }
+        
+        if (fileStat.st_size == 0) {
+            // mmap will not map zero bytes, so an empty file is an empty storage
+            close(fileDescriptor);
+            _bytes = 0;
+            _length = 0;
+            return self;
+        }
+        
+        void *mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        int mapErrno = errno;
+        // the mapping keeps its own reference to the file
+        close(fileDescriptor);
+        if (mapping == MAP_FAILED) {
+            return [self failWithErrno:mapErrno path:path error:error];
+        }
+        
+        _bytes = mapping;
+        _length = (NSUInteger)fileStat.st_size;
+    }
+    return self;
+}
+
+- (instancetype)failWithErrno:(int)errorNumber path:(NSString *)path error:(NSError **)error {
+    _bytes = 0;
+    _length = 0;
+    if (error != NULL) {
+        *error = [NSError errorWithDomain:NSPOSIXErrorDomain
+                                     code:errorNumber
+                                 userInfo:@{ NSFilePathErrorKey: path }];
+    }
+    return nil;
+}
+
+- (NSUInteger)documentLength {
+    return _precedingLength + _length;
+}
+
+- (BOOL)isDocumentPrefixOfBytes:(const void *)bytes length:(NSUInteger)length {
+    NSUInteger remainingLength = self.documentLength;
+    if (remainingLength > length) {
+        return NO;
+    }
+    // each storage holds the document from `_precedingLength` on, but a following storage may only use part of it
+    for (StaticMemoryStorage *storage = self; storage != nil && remainingLength > 0; storage = storage->_precedingStorage) {
+        if (remainingLength > storage->_precedingLength) {
+            NSUInteger usedLength = MIN(remainingLength - storage->_precedingLength, storage->_length);
+            if (usedLength > 0 && memcmp((const char *)bytes + storage->_precedingLength, storage->_bytes, usedLength) != 0) {
+                return NO;
+            }
+            remainingLength = storage->_precedingLength;
+        }
+    }
+    return remainingLength == 0;
+}
+
+- (NSUInteger)documentOffsetOfPointer:(const void *)pointer {
+    NSUInteger remainingLength = self.documentLength;
+    for (StaticMemoryStorage *storage = self; storage != nil && remainingLength > 0; storage = storage->_precedingStorage) {
+        if (remainingLength > storage->_precedingLength &&
+            storage->_bytes != NULL &&
+            (const char *)pointer >= (const char *)storage->_bytes &&
+            (const char *)pointer < (const char *)storage->_bytes + storage->_length) {
+            
+            NSUInteger offset = storage->_precedingLength + (NSUInteger)((const char *)pointer - (const char *)storage->_bytes);
+            // memory of a preceding storage that a following storage does not use is not in our document
+            return offset < remainingLength ? offset : NSNotFound;
+        }
+        remainingLength = MIN(remainingLength, storage->_precedingLength);
+    }
+    return NSNotFound;
+}
+
 - (void)dealloc
 {
     if (_bytes > 0) {
-        free((void *)_bytes);
+        switch (_ownership) {
+            case StaticMemoryStorageOwnershipMalloc:
+                free((void *)_bytes);
+                break;
+            case StaticMemoryStorageOwnershipData:
+                _data = nil;
+                break;
+            case StaticMemoryStorageOwnershipMappedFile:
+                munmap((void *)_bytes, _length);
+                break;
+        }
         _bytes = 0;
     }
     _length = 0;
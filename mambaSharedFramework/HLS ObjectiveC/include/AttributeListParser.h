@@ -0,0 +1,54 @@
+//
+//  AttributeListParser.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#ifndef AttributeListParser_h
+#define AttributeListParser_h
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ One `<key>=<value>` pair of an attribute list, as offsets into the bytes that were parsed.
+ 
+ Both spans have had surrounding whitespace trimmed, and the value has had surrounding double quotes trimmed if it was quote escaped.
+ */
+typedef struct {
+    uint64_t keyStart;
+    uint64_t keyLength;
+    uint64_t valueStart;
+    uint64_t valueLength;
+    bool quoteEscaped;
+} AttributeListEntry;
+
+/**
+ Parses an attribute list in the format `<key1>=<value1>,<key2>="<value2>"` in one pass, without allocating.
+ 
+ Quotes escape commas and equals, so `key1=value1,key2="value2,value3=value4"` has the two keys `key1` and `key2`.
+ 
+ @param bytes The UTF-8 bytes of the attribute list. This does not need to be null-terminated.
+ @param length The number of bytes in `bytes`.
+ @param entries An array to write the entries into, in the order found. May be NULL if `capacity` is 0.
+ @param capacity The number of entries that `entries` can hold.
+ @return The number of entries in the attribute list, which may be more than `capacity`, in which case only the first `capacity`
+ entries were written and the caller should try again with a larger array. Returns -1 if the attribute list is malformed.
+ */
+int64_t mamba_parseAttributeList(const char * _Nullable bytes, uint64_t length, AttributeListEntry * _Nullable entries, uint64_t capacity);
+
+#endif /* AttributeListParser_h */
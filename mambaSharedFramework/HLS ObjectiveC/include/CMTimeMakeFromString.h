@@ -36,4 +36,29 @@
  */
 CMTime mamba_CMTimeMakeFromString(const char * _Nullable string, uint8_t decimal_places, const char * _Nullable * _Nullable remainder);
 
+/// The number of decimal places, and the timescale, of #EXTINF durations
+enum {
+    mamba_EXTINFDurationDecimalPlaces = 5,
+    mamba_EXTINFDurationTimescale = 100000
+};
+
+/**
+ Interprets the duration of an #EXTINF tag from the tag body (i.e. "5.005,Title") as a number of 1/100000 second ticks.
+ @param bytes The UTF-8 bytes of the #EXTINF tag body. This does not need to be null-terminated.
+ @param length The number of bytes in `bytes`.
+ @return The duration in units of 1/`mamba_EXTINFDurationTimescale` seconds, or -1 if the duration is missing, negative, or is not
+ followed by a comma or the end of the string.
+ @note Only the first 7 bytes are examined. This does not allocate or depend on the C locale, so the rapid parser calls it as it scans.
+ */
+int64_t mamba_EXTINFDurationTicks(const char * _Nullable bytes, size_t length);
+
+/**
+ Interprets the duration of an #EXTINF tag from the tag body (i.e. "5.005,Title").
+ @param bytes The UTF-8 bytes of the #EXTINF tag body. This does not need to be null-terminated.
+ @param length The number of bytes in `bytes`.
+ @return A CMTime value with a timescale of 100000, or an invalid CMTime if the duration is missing, negative, or is not followed by
+ a comma or the end of the string. See `mamba_EXTINFDurationTicks`.
+ */
+CMTime mamba_CMTimeMakeFromEXTINFDuration(const char * _Nullable bytes, size_t length);
+
 #endif /* CMTimeMakeFromString_h */
@@ -0,0 +1,44 @@
+//
+//  ISO8601DateParser.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#ifndef ISO8601DateParser_h
+#define ISO8601DateParser_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ Parses an RFC 3339 date and time, the format of #EXT-X-PROGRAM-DATE-TIME and the dates in #EXT-X-DATERANGE
+ (i.e. "2010-02-19T14:54:23.031+08:00").
+ 
+ Accepts any number of fractional second digits (only the first nine are used), and a time zone of "Z", "±hh",
+ "±hhmm" or "±hh:mm". Parsing does not allocate or depend on the C locale.
+ 
+ Playlists usually have many dates on the same day, so the most recent day parsed on each thread is remembered
+ and its date math is skipped when the next date is on the same day.
+ 
+ @param bytes The UTF-8 bytes of the date. This does not need to be null-terminated.
+ @param length The number of bytes in `bytes`.
+ @param timeIntervalSince1970 On success, set to the number of seconds since 00:00:00 UTC on 1 January 1970.
+ @return true if the entire string is a valid date, false otherwise.
+ */
+bool mamba_parseISO8601Date(const char * _Nullable bytes, size_t length, double * _Nonnull timeIntervalSince1970);
+
+#endif /* ISO8601DateParser_h */
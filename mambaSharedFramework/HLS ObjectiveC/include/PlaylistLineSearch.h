@@ -0,0 +1,41 @@
+//
+//  PlaylistLineSearch.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#ifndef PlaylistLineSearch_h
+#define PlaylistLineSearch_h
+
+#include <stdint.h>
+
+/**
+ Searches a playlist backwards from the end for the last line that is exactly `line`, without allocating.
+ 
+ Lines end with `\n` or `\r`. The line is compared byte for byte, so no whitespace is trimmed, which matches how
+ the rapid parser finds URL lines.
+ 
+ @param bytes The UTF-8 bytes of the playlist. This does not need to be null-terminated.
+ @param length The number of bytes in `bytes`.
+ @param line The UTF-8 bytes of the line to find, without a line ending.
+ @param lineLength The number of bytes in `line`. Must be more than 0.
+ @return The offset of the first byte after the line (i.e. of its line ending, or `length` if it is the last line),
+ or -1 if the line was not found.
+ */
+int64_t mamba_offsetAfterLastLineMatching(const char * _Nonnull bytes, uint64_t length, const char * _Nonnull line, uint64_t lineLength);
+
+#endif /* PlaylistLineSearch_h */
@@ -20,11 +20,74 @@
 @import Foundation;
 #include "RapidParserError.h"
 #include "StaticMemoryStorage.h"
+#include "RapidParserCancellation.h"
 
 @protocol RapidParserCallback;
+@protocol RapidParserLineRecordCallback;
 
 @interface RapidParser : NSObject
 
+/**
+ If set, a parse stops early once this is cancelled or its deadline passes, and the callback is sent
+ `parseError:errorNumber:` with `RapidParserErrorCancelled` or `RapidParserErrorTimedOut`.
+ 
+ This is checked as the playlist is scanned, so set it before starting a parse. The incremental parse
+ does not check it, as the caller decides when to feed it.
+ */
+@property (nonatomic, strong, nullable) RapidParserCancellation *cancellation;
+
 - (void)parseHLSData:(StaticMemoryStorage * _Nonnull)storage callback:(id<RapidParserCallback> _Nonnull)callback;
 
+/**
+ Parses the playlist into a flat array of `RapidParserLineRecord`s, which are handed to the
+ callback in a single call when the parse is complete.
+ 
+ This avoids an Objective-C message and up to three `MambaStringRef` allocations per line.
+ Unlike `parseHLSData:callback:`, there is no way to exit early, so the entire playlist is always parsed.
+ */
+- (void)parseHLSDataToLineRecords:(StaticMemoryStorage * _Nonnull)storage callback:(id<RapidParserLineRecordCallback> _Nonnull)callback;
+
+/**
+ Parses the playlist into line records, as `parseHLSDataToLineRecords:callback:` does, but splits the playlist
+ at line boundaries into `partitionCount` partitions that are scanned concurrently.
+ 
+ The callback receives exactly the same records, in the same order, as it would from a serial parse.
+ A `partitionCount` of 0 or 1 is a serial parse.
+ */
+- (void)parseHLSDataToLineRecords:(StaticMemoryStorage * _Nonnull)storage partitionCount:(NSUInteger)partitionCount callback:(id<RapidParserLineRecordCallback> _Nonnull)callback;
+
+/**
+ Parses the playlist into line records, as `parseHLSDataToLineRecords:partitionCount:callback:` does, but on the
+ calling thread. The callback has been sent `parsedLineRecords:count:` or `parseError:errorNumber:` by the time
+ this method returns.
+ 
+ The parser's own dispatch queue is only created by the asynchronous methods, so a parser that is only used
+ through this method never creates one.
+ */
+- (void)parseHLSDataToLineRecordsSynchronously:(StaticMemoryStorage * _Nonnull)storage partitionCount:(NSUInteger)partitionCount callback:(id<RapidParserLineRecordCallback> _Nonnull)callback NS_SWIFT_NAME(parseHLSDataToLineRecordsSynchronously(_:partitionCount:callback:));
+
+/**
+ Begins a forward scanning parse of a playlist that will be fed to us in chunks as it arrives.
+ 
+ Like `parseHLSDataToLineRecordsSynchronously:partitionCount:callback:`, the incremental parse runs on the calling thread, and all three
+ methods must be called from the same thread (or otherwise serialized).
+ 
+ The callback will receive line records in document order. The record offsets are offsets into the
+ concatenation of all the data passed to `feedIncrementalParse:`.
+ */
+- (void)beginIncrementalParseWithCallback:(id<RapidParserLineRecordCallback> _Nonnull)callback;
+
+/**
+ Scans the next chunk of the playlist. Only bytes that have not been fed before should be passed in.
+ 
+ @return NO if the parse has already failed (the callback has been sent `parseError:errorNumber:`)
+ or has been finished, in which case the data is ignored.
+ */
+- (BOOL)feedIncrementalParse:(NSData * _Nonnull)data;
+
+/**
+ Completes the final line of the playlist and sends the line records to the callback.
+ */
+- (void)finishIncrementalParse;
+
 @end
@@ -0,0 +1,64 @@
+//
+//  RapidParserCancellation.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ A cancellation flag and optional deadline that a `RapidParser` checks while it scans.
+ 
+ The scan checks every few kilobytes of playlist, so a parse stops very soon after it is cancelled
+ or its deadline passes. The callback is then sent `parseError:errorNumber:` with
+ `RapidParserErrorCancelled` or `RapidParserErrorTimedOut`.
+ 
+ A cancellation may be shared by any number of parses, and `cancel` may be called from any thread.
+ */
+@interface RapidParserCancellation : NSObject
+
+/**
+ Instantiates a cancellation with no deadline.
+ */
+- (instancetype _Nonnull)init;
+
+/**
+ Instantiates a cancellation that also stops parses once `deadline` has passed.
+ */
+- (instancetype _Nonnull)initWithDeadline:(dispatch_time_t)deadline NS_DESIGNATED_INITIALIZER;
+
+/**
+ The deadline. `DISPATCH_TIME_FOREVER` if there is none.
+ */
+@property (nonatomic, readonly) dispatch_time_t deadline;
+
+/**
+ YES once `cancel` has been called.
+ */
+@property (nonatomic, readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ Stops any parses using this cancellation. Calling this more than once has no further effect.
+ */
+- (void)cancel;
+
+/**
+ Returns 0 if parsing should go on, or the error number (`RapidParserErrorCancelled` or
+ `RapidParserErrorTimedOut`) of the reason parsing should stop.
+ */
+- (uint32_t)stopErrorNumber;
+
+@end
@@ -27,8 +27,16 @@ extern const uint32_t RapidParserErrorMissingTagData;
 
 extern const uint32_t RapidParserErrorMissingTagDataForEXTINF;
 
+extern const uint32_t RapidParserErrorCancelled;
+
+extern const uint32_t RapidParserErrorTimedOut;
+
 extern const char * RapidParserErrorMissingTagData_Message;
 
 extern const char * RapidParserErrorMissingTagDataForEXTINF_Message;
 
+extern const char * RapidParserErrorCancelled_Message;
+
+extern const char * RapidParserErrorTimedOut_Message;
+
 #endif /* RapidParserError_h */
@@ -0,0 +1,89 @@
+//
+//  RapidParserLineRecord.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+@import Foundation;
+#import "RapidParserTagID.h"
+#import "CMTimeMakeFromString.h"
+
+/**
+ The kind of line described by a `RapidParserLineRecord`.
+ */
+typedef NS_ENUM(uint8_t, RapidParserLineRecordKind) {
+    /// A tag with data after the colon. The name and data spans are set.
+    RapidParserLineRecordKindTag = 0,
+    /// A tag with no colon. Only the name span is set.
+    RapidParserLineRecordKindNoDataTag,
+    /// A #EXTINF tag. The name, data and duration spans are set.
+    RapidParserLineRecordKindEXTINFTag NS_SWIFT_NAME(extinfTag),
+    /// A comment line. The data span holds the entire comment.
+    RapidParserLineRecordKindComment,
+    /// A URL line. The data span holds the entire URL.
+    RapidParserLineRecordKindURL NS_SWIFT_NAME(url)
+};
+
+/// Special values of `RapidParserLineRecord.durationTicks`
+enum {
+    /// The #EXTINF duration is not valid, see `mamba_EXTINFDurationTicks`
+    RapidParserLineRecordDurationInvalid = -1,
+    /// The #EXTINF duration was not decoded during the scan, and should be decoded from the duration span
+    RapidParserLineRecordDurationNotDecoded = -2
+};
+
+/**
+ A flat description of a single line found by the rapid parser.
+
+ All starts are byte offsets into the `StaticMemoryStorage` that was parsed. Spans that do not
+ apply to the `kind` of line have a zero length.
+
+ For tag lines, `tagID` is the `RapidParserTagID` of the tag name, or `RapidParserTagIDNone` if the name
+ is not one the parser recognizes. Incremental parses do not recognize tag names and always report
+ `RapidParserTagIDNone`.
+ 
+ For #EXTINF lines, `durationTicks` is the duration decoded during the scan by `mamba_EXTINFDurationTicks`, in units of
+ 1/`mamba_EXTINFDurationTimescale` seconds, or `RapidParserLineRecordDurationInvalid`. Incremental parses do not decode
+ durations and always report `RapidParserLineRecordDurationNotDecoded`.
+ */
+typedef struct {
+    uint64_t nameStart;
+    uint64_t nameLength;
+    uint64_t dataStart;
+    uint64_t dataLength;
+    uint64_t durationStart;
+    uint64_t durationLength;
+    int64_t durationTicks;
+    RapidParserLineRecordKind kind;
+    uint8_t tagID;
+} RapidParserLineRecord;
+
+@protocol RapidParserLineRecordCallback <NSObject>
+
+/**
+ Called once when parsing completes successfully.
+
+ @param records The line records found, in the order the parser found them. Note that
+ `parseHLSDataToLineRecords:callback:` scans backwards, so the first record is the last line in the
+ playlist, while an incremental parse scans forwards and delivers records in document order.
+
+ @warning `records` is only valid for the duration of this call.
+ */
+- (void)parsedLineRecords:(const RapidParserLineRecord * _Nonnull)records count:(NSUInteger)count;
+
+- (void)parseError:(NSString * _Nonnull)error errorNumber:(UInt32)errorNumber;
+
+@end
@@ -0,0 +1,77 @@
+//
+//  RapidParserTagID.h
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+
+#ifndef RapidParserTagID_h
+#define RapidParserTagID_h
+
+#include <stdint.h>
+
+/*
+ Small integer IDs for the tag names that the rapid parser recognizes as it scans.
+ 
+ These are the tags of `PantosTag`, in the same order that `PantosTag` declares them.
+ The Swift side maps the IDs back to `PantosTag` values by name, see `PantosTag.descriptor(forRapidParserTagID:)`.
+ */
+typedef enum {
+    // the tag name is not one we recognize
+    RapidParserTagIDNone = 0,
+    RapidParserTagIDEXTM3U,
+    RapidParserTagIDEXT_X_VERSION,
+    RapidParserTagIDEXT_X_MEDIA,
+    RapidParserTagIDEXT_X_STREAM_INF,
+    RapidParserTagIDEXT_X_I_FRAME_STREAM_INF,
+    RapidParserTagIDEXT_X_SESSION_DATA,
+    RapidParserTagIDEXT_X_SESSION_KEY,
+    RapidParserTagIDEXT_X_CONTENT_STEERING,
+    RapidParserTagIDEXT_X_TARGETDURATION,
+    RapidParserTagIDEXT_X_MEDIA_SEQUENCE,
+    RapidParserTagIDEXT_X_ENDLIST,
+    RapidParserTagIDEXT_X_PLAYLIST_TYPE,
+    RapidParserTagIDEXT_X_I_FRAMES_ONLY,
+    RapidParserTagIDEXT_X_ALLOW_CACHE,
+    RapidParserTagIDEXT_X_INDEPENDENT_SEGMENTS,
+    RapidParserTagIDEXT_X_START,
+    RapidParserTagIDEXTINF,
+    RapidParserTagIDEXT_X_BITRATE,
+    RapidParserTagIDEXT_X_BYTERANGE,
+    RapidParserTagIDEXT_X_KEY,
+    RapidParserTagIDEXT_X_MAP,
+    RapidParserTagIDEXT_X_PROGRAM_DATE_TIME,
+    RapidParserTagIDEXT_X_DISCONTINUITY,
+    RapidParserTagIDEXT_X_DISCONTINUITY_SEQUENCE,
+    RapidParserTagIDEXT_X_DATERANGE,
+    RapidParserTagIDEXT_X_SKIP,
+    // THIS NEEDS TO BE LAST IN THE TAG ID LIST
+    numberOfRapidParserTagIDs
+} RapidParserTagID;
+
+/**
+ Looks up the ID of a tag name, including the leading '#' (i.e. "#EXT-X-VERSION").
+ 
+ @return The tag ID, or `RapidParserTagIDNone` if the name is not recognized.
+ */
+RapidParserTagID rapidParserTagIDForTagName(const unsigned char * _Nonnull name, uint64_t length);
+
+/**
+ @return The tag name for a tag ID, including the leading '#', or NULL for `RapidParserTagIDNone` or an out of range ID.
+ */
+const char * _Nullable rapidParserTagNameForTagID(uint8_t tagID);
+
+#endif /* RapidParserTagID_h */
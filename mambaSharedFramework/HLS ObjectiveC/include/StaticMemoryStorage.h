@@ -22,10 +22,11 @@
 /**
  Minimal memory storage wrapper.
  
- This class takes a NSData instance and makes a static copy of the memory for reference.
+ This class takes a NSData instance and makes a static copy of the memory for reference. It can also
+ reference the memory of an immutable NSData, or a memory mapped file, without a copy.
  
- StaticMemoryStorage will allocate and deallocate this memory on initialization and deinitialization,
- respectively.
+ StaticMemoryStorage will allocate (or map) and deallocate (or unmap) this memory on initialization and
+ deinitialization, respectively.
  
  This is done so that mamba can construct `HLSStringRef` objects that refer to this static memory
  storage. See `HLSPlaylistCore` for where we keep a reference to this `StaticMemoryStorage` object.
@@ -38,11 +39,64 @@
  */
 - (instancetype _Nonnull)initWithData:(NSData * _Nonnull)data;
 
+/**
+ Instantiates an StaticMemoryStorage that refers to the memory of the provided NSData without copying it.
+ The StaticMemoryStorage keeps a reference to an immutable copy of the data, which for an immutable NSData
+ is the same object, so no bytes are copied.
+ 
+ Use this for large playlists that are already in memory (i.e. from a web request).
+ */
+- (instancetype _Nonnull)initWithDataNoCopy:(NSData * _Nonnull)data;
+
+/**
+ Instantiates an StaticMemoryStorage that maps the file at `path` into memory read-only. The file is
+ unmapped when the StaticMemoryStorage is deallocated.
+ 
+ The file must not be modified or truncated while this object is alive, or the caller will get undefined behavior.
+ 
+ @param error If the file cannot be opened or mapped, set to an error in the `NSPOSIXErrorDomain`.
+ 
+ @return nil if the file cannot be opened or mapped.
+ */
+- (instancetype _Nullable)initWithContentsOfFileAtPath:(NSString * _Nonnull)path error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Instantiates an StaticMemoryStorage with a copy of `length` bytes that continue a document held by another
+ StaticMemoryStorage. The new storage keeps a reference to `precedingStorage`, so memory that refers to
+ any storage in the chain stays valid as long as the last storage is alive.
+ 
+ This is used to update a playlist when only the end of it has changed, without copying or parsing the
+ part we already have.
+
+ Every storage in the chain is searched by `isDocumentPrefixOfBytes:length:` and `documentOffsetOfPointer:`,
+ and releasing the last storage releases the chain recursively, so callers should keep chains short
+ (see `precedingStorageCount`) and start again with a single storage of the whole document once they get long.
+ 
+ @param precedingLength The number of bytes of the document of `precedingStorage` that come before these
+ bytes. Must not be more than `precedingStorage.documentLength`.
+ */
+- (instancetype _Nonnull)initWithBytes:(const void * _Nullable)bytes
+                                length:(NSUInteger)length
+                      precedingStorage:(StaticMemoryStorage * _Nonnull)precedingStorage
+                       precedingLength:(NSUInteger)precedingLength;
+
 /**
  Instantiates an empty StaticMemoryStorage. `length` and `bytes` will be zero.
  */
 - (instancetype _Nonnull)init;
 
+/**
+ Returns YES if the document of this storage (see `documentLength`) is identical to the first
+ `documentLength` bytes of `bytes`.
+ */
+- (BOOL)isDocumentPrefixOfBytes:(const void * _Nonnull)bytes length:(NSUInteger)length;
+
+/**
+ Returns the offset in the document of this storage (see `documentLength`) of `pointer`, which must point
+ into the memory of this storage or a preceding storage. Returns NSNotFound if it does not.
+ */
+- (NSUInteger)documentOffsetOfPointer:(const void * _Nonnull)pointer;
+
 /**
  Length of the internal buffer in bytes.
  */
@@ -57,4 +111,20 @@
  */
 @property (nonatomic, readonly) const void * _Nullable bytes;
 
+/**
+ The storage holding the start of the document that this storage continues, or nil.
+ */
+@property (nonatomic, readonly, nullable) StaticMemoryStorage *precedingStorage;
+
+/**
+ The number of storages before this one in the chain of `precedingStorage`s. This is 0 if there is no `precedingStorage`.
+ */
+@property (nonatomic, readonly) NSUInteger precedingStorageCount;
+
+/**
+ The length of the document that this storage holds the end of: `length` plus the number of bytes
+ of the document of `precedingStorage` that come before it. This is `length` if there is no `precedingStorage`.
+ */
+@property (nonatomic, readonly) NSUInteger documentLength;
+
 @end
@@ -21,13 +21,18 @@
 #include "RapidParserNewTagCallbacks.h"
 #include "RapidParserState.h"
 #include "RapidParserLineState.h"
-#include "RapidParserMasterParseArray.h"
+#include "RapidParserByteClassStateMachine.h"
+#include "RapidParserScanAhead.h"
 #include "RapidParserDebug.h"
 
+// the number of bytes we scan between checks of `ParseShouldContinue`, which is a few hundred lines of a typical playlist
+static const uint64_t parseContinueCheckInterval = 16 * 1024;
+
 void parseHLS(const void *parentparser, const unsigned char *bytes, const uint64_t length) {
     
     uint64_t index = length;
     uint8_t state = Scanning;
+    uint64_t nextContinueCheck = length > parseContinueCheckInterval ? length - parseContinueCheckInterval : 0;
     
     struct LineState lineState;
     initializeLineState(&lineState);
@@ -37,9 +42,25 @@ void parseHLS(const void *parentparser, const unsigned char *bytes, const uint64
     
     while (index > 0 && state < numberOfScanningParseStates) {
         
+        if (index < nextContinueCheck) {
+            if (!ParseShouldContinue(parentparser)) {
+                state = EarlyExit;
+                break;
+            }
+            nextContinueCheck = index > parseContinueCheckInterval ? index - parseContinueCheckInterval : 0;
+        }
+        
+        if (state == Scanning) {
+            // most bytes are no-ops in the Scanning state, so skip straight to the next one that matters
+            index = skipBackwardsToInterestingByteForScanningState(bytes, index);
+            if (index == 0) {
+                break;
+            }
+        }
+        
         index -= 1;
         
-        state = (*masterParseArray[state][bytes[index]]) (parentparser, bytes[index], index, state, &lineState);
+        state = byteClassParseStep(parentparser, bytes[index], index, state, &lineState);
         
         rapid_parser_debug_print("State %i after processing character %c at index %llu\n", (int)state, bytes[index], index);
     }
@@ -48,11 +69,12 @@ void parseHLS(const void *parentparser, const unsigned char *bytes, const uint64
     if (index == 0 && state < numberOfScanningParseStates) {
         // handle the final line, force a line completion
         // note that we pass "-1" as the index, because we are pretending that there is a newline at position -1
-        (*masterParseArray[state]['\n']) (parentparser, '\n', -1, state, &lineState);
+        byteClassParseStep(parentparser, '\n', -1, state, &lineState);
     }
     
     // if we are in ErrorEarlyExit another part of the code already called ParseError to exit out
-    // if we are in EarlyExit, its because the client has asked us to exit and they know that parsing is complete
+    // if we are in EarlyExit, its because the client has asked us to exit and they know that parsing is complete,
+    // or `ParseShouldContinue` has asked us to stop and called ParseError
     if (state < numberOfScanningParseStates) {
         
         rapid_parser_debug_print("Ending parse of hls data with length %llu\n", length);
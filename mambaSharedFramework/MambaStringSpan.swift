@@ -0,0 +1,220 @@
+//
+//  MambaStringSpan.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import CoreMedia
+
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
+/**
+ A value type equivalent of a `MambaStringRef` created with `initWithBytesNoCopy:length:`.
+ 
+ The parser creates one of these for every tag name, tag value, comment and URL it finds, so
+ it must not allocate. A span is just a pointer into the `StaticMemoryStorage` of the playlist
+ being parsed and a length.
+ 
+ Equality, hashing and `stringValue()` match `MambaStringRef`, so a span and a `MambaStringRef`
+ with the same bytes are interchangeable.
+ 
+ *Important memory safety note:* As with `MambaStringRef`, a span does not keep its memory alive.
+ See `PlaylistTag` for the rules.
+ */
+public struct MambaStringSpan {
+    
+    let bytes: UnsafePointer<CChar>?
+    
+    /// Length of the UTF-8 bytes.
+    public let length: Int
+    
+    init(bytes: UnsafePointer<CChar>, length: Int) {
+        self.bytes = length > 0 ? bytes : nil
+        self.length = length
+    }
+    
+    /// An empty span.
+    public init() {
+        self.bytes = nil
+        self.length = 0
+    }
+    
+    /// Creates a `String` from the bytes. This will allocate, so take care when calling.
+    public func stringValue() -> String {
+        return withUTF8Bytes { String(decoding: $0, as: UTF8.self) }
+    }
+    
+    /**
+     Creates a `MambaStringRef` pointing to the same bytes. This will allocate, so take care when calling.
+     */
+    public func stringRef() -> MambaStringRef {
+        guard let bytes = bytes else {
+            return MambaStringRef()
+        }
+        return MambaStringRef(bytesNoCopy: bytes, length: UInt(length))
+    }
+    
+    /// Specialized value getter for segment duration values in #EXTINF tags. See `MambaStringRef.extinfSegmentDuration()`.
+    public func extinfSegmentDuration() -> CMTime {
+        return mamba_CMTimeMakeFromEXTINFDuration(bytes, length)
+    }
+    
+    func withUTF8Bytes<Result>(_ body: (UnsafeBufferPointer<UInt8>) throws -> Result) rethrows -> Result {
+        guard let bytes = bytes else {
+            return try body(UnsafeBufferPointer(start: nil, count: 0))
+        }
+        return try bytes.withMemoryRebound(to: UInt8.self, capacity: length) {
+            try body(UnsafeBufferPointer(start: $0, count: length))
+        }
+    }
+}
+
+extension MambaStringSpan: Hashable {
+    
+    public static func ==(lhs: MambaStringSpan, rhs: MambaStringSpan) -> Bool {
+        return lhs.withUTF8Bytes { lhsBytes in rhs.withUTF8Bytes { rhsBytes in mambaStringBytesEqual(lhsBytes, rhsBytes) } }
+    }
+    
+    public func hash(into hasher: inout Hasher) {
+        // `NSObject` hashes as its `hash`, so this hashes the same as a `MambaStringRef` with the same bytes
+        hasher.combine(withUTF8Bytes(mambaStringHash))
+    }
+}
+
+public func == (lhs: MambaStringSpan, rhs: String) -> Bool {
+    return lhs.stringValue() == rhs
+}
+
+public func != (lhs: MambaStringSpan, rhs: String) -> Bool {
+    return !(lhs == rhs)
+}
+
+extension MambaStringSpan: CustomDebugStringConvertible {
+    public var debugDescription: String {
+        return "\(stringValue()) HASH:\(withUTF8Bytes(mambaStringHash))"
+    }
+}
+
+/**
+ The string storage of a `PlaylistTag`. Tags built by the parser hold spans, everything else holds `MambaStringRef`s.
+ 
+ Equality and hashing are by bytes, so the two cases compare equal when they hold the same string.
+ */
+enum PlaylistTagString {
+    case span(MambaStringSpan)
+    case stringRef(MambaStringRef)
+    
+    static let empty = PlaylistTagString.span(MambaStringSpan())
+    
+    var length: Int {
+        switch self {
+        case .span(let span):
+            return span.length
+        case .stringRef(let stringRef):
+            return Int(stringRef.length)
+        }
+    }
+    
+    /// The memory this holds outside of the playlist data, which is a `MambaStringRef` if it has one
+    var estimatedHeapByteCount: Int {
+        switch self {
+        case .span:
+            return 0
+        case .stringRef:
+            return PlaylistTag.estimatedObjectByteCount
+        }
+    }
+    
+    /// Returns the `MambaStringRef`, or creates one (which allocates) if this is a span.
+    var stringRef: MambaStringRef {
+        switch self {
+        case .span(let span):
+            return span.stringRef()
+        case .stringRef(let stringRef):
+            return stringRef
+        }
+    }
+    
+    func stringValue() -> String {
+        switch self {
+        case .span(let span):
+            return span.stringValue()
+        case .stringRef(let stringRef):
+            return stringRef.stringValue()
+        }
+    }
+    
+    /// `body` must not let the bytes escape.
+    func withUTF8Bytes<Result>(_ body: (UnsafeBufferPointer<UInt8>) throws -> Result) rethrows -> Result {
+        switch self {
+        case .span(let span):
+            return try span.withUTF8Bytes(body)
+        case .stringRef(let stringRef):
+            let length = Int(stringRef.length)
+            guard length > 0 else {
+                return try body(UnsafeBufferPointer(start: nil, count: 0))
+            }
+            return try stringRef.utf8Bytes().withMemoryRebound(to: UInt8.self, capacity: length) {
+                try body(UnsafeBufferPointer(start: $0, count: length))
+            }
+        }
+    }
+}
+
+extension PlaylistTagString: Hashable {
+    
+    static func ==(lhs: PlaylistTagString, rhs: PlaylistTagString) -> Bool {
+        switch (lhs, rhs) {
+        case (.stringRef(let lhsStringRef), .stringRef(let rhsStringRef)):
+            return lhsStringRef == rhsStringRef
+        default:
+            return lhs.withUTF8Bytes { lhsBytes in rhs.withUTF8Bytes { rhsBytes in mambaStringBytesEqual(lhsBytes, rhsBytes) } }
+        }
+    }
+    
+    func hash(into hasher: inout Hasher) {
+        switch self {
+        case .span(let span):
+            span.hash(into: &hasher)
+        case .stringRef(let stringRef):
+            // uses the cached hash of the `MambaStringRef`
+            hasher.combine(stringRef)
+        }
+    }
+}
+
+private func mambaStringBytesEqual(_ lhs: UnsafeBufferPointer<UInt8>, _ rhs: UnsafeBufferPointer<UInt8>) -> Bool {
+    guard lhs.count == rhs.count else {
+        return false
+    }
+    guard let lhsBase = lhs.baseAddress, let rhsBase = rhs.baseAddress else {
+        // both are empty
+        return true
+    }
+    return memcmp(lhsBase, rhsBase, lhs.count) == 0
+}
+
+/// The djb2 hash used by `-[MambaStringRef hash]`, which treats each byte as a signed `char`.
+private func mambaStringHash(_ bytes: UnsafeBufferPointer<UInt8>) -> Int {
+    var hash: UInt = 5381
+    for byte in bytes {
+        hash = (hash &<< 5) &+ hash &+ UInt(bitPattern: Int(Int8(bitPattern: byte)))
+    }
+    return Int(bitPattern: hash)
+}
@@ -24,7 +24,7 @@ import Foundation
     `#EXT-X-MEDIA:TYPE=AUDIO,GROUP-ID="g104000",NAME="English",LANGUAGE="en",DEFAULT=YES,AUTOSELECT=YES`,
  where there is a tag with a set of key=value pairs as part of the payload
  */
-public class GenericDictionaryTagParser: PlaylistTagParser {
+public class GenericDictionaryTagParser: PlaylistTagParser, PlaylistTagUTF8Parser {
     
     let tag: PlaylistTagDescriptor
     
@@ -46,4 +46,8 @@ public class GenericDictionaryTagParser: PlaylistTagParser {
             throw error
         }
     }
+    
+    func parseTag(fromUTF8Bytes bytes: UnsafeBufferPointer<UInt8>) throws -> PlaylistTagDictionary {
+        return try GenericDictionaryTagParserHelper.parseTag(fromUTF8Bytes: bytes, tag: tag)
+    }
 }
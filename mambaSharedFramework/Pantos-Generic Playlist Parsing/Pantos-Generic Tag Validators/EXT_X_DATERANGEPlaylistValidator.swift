@@ -25,19 +25,12 @@ import Foundation
 ///
 ///     Clients SHOULD ignore EXT-X-DATERANGE tags with illegal syntax.
 ///
-class EXT_X_DATERANGEPlaylistValidator: VariantPlaylistValidator {
+class EXT_X_DATERANGEPlaylistValidator: TagsByDescriptorVariantPlaylistValidator {
     
-    static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
         
-        var programDateTimeTagsCount = 0
-        var daterangeTags = [PlaylistTag]()
-        for tag in variantPlaylist.tags {
-            if tag.tagDescriptor == PantosTag.EXT_X_PROGRAM_DATE_TIME {
-                programDateTimeTagsCount += 1
-            } else if tag.tagDescriptor == PantosTag.EXT_X_DATERANGE {
-                daterangeTags.append(tag)
-            }
-        }
+        let programDateTimeTagsCount = tagsByDescriptor.count(forDescriptor: PantosTag.EXT_X_PROGRAM_DATE_TIME)
+        let daterangeTags = tagsByDescriptor.tags(forDescriptor: PantosTag.EXT_X_DATERANGE)
         
         var validationIssues = [PlaylistValidationIssue]()
         validationIssues.append(contentsOf: validateProgramDateTime(programDateTimeTagsCount: programDateTimeTagsCount, daterangeTagsCount: daterangeTags.count))
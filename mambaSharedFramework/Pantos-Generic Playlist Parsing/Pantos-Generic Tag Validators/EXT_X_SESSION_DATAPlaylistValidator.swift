@@ -19,12 +19,12 @@
 
 import Foundation
 
-final class EXT_X_SESSION_DATAPlaylistValidator: MasterPlaylistValidator {
-    static func validate(masterPlaylist: any MasterPlaylistInterface) -> [PlaylistValidationIssue] {
+final class EXT_X_SESSION_DATAPlaylistValidator: TagsByDescriptorMasterPlaylistValidator {
+    static func validate(masterPlaylist: any MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
         var issues = [PlaylistValidationIssue]()
 
         if let issue = duplicateIssue(
-            tags: masterPlaylist.tags.filter { $0.tagDescriptor == PantosTag.EXT_X_SESSION_DATA }
+            tags: tagsByDescriptor.tags(forDescriptor: PantosTag.EXT_X_SESSION_DATA)
         ) {
             issues.append(issue)
         }
@@ -29,11 +29,11 @@ class  EXT_X_STARTTimeOffsetValidator: VariantPlaylistValidator {
         var startTag, targetDurationTag: PlaylistTag?
         var endListExist = false
         if let range = variantPlaylist.footer?.range {
-            let footerTags = variantPlaylist.tags[range]
+            let footerTags = variantPlaylist.tagCollection[range]
             endListExist = footerTags.contains(where: { (tag) -> Bool in return tag.tagDescriptor == PantosTag.EXT_X_ENDLIST })
         }
         if let header = variantPlaylist.header {
-            let headerTags = variantPlaylist.tags[header.range]
+            let headerTags = variantPlaylist.tagCollection[header.range]
             for tag in headerTags {
                 if tag.tagDescriptor == PantosTag.EXT_X_START {
                     startTag = tag
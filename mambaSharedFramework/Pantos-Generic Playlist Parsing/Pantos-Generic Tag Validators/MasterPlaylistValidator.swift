@@ -32,6 +32,22 @@ public protocol MasterPlaylistValidator {
     static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue]
 }
 
+/**
+ A `MasterPlaylistValidator` that finds the tags it needs in a `PlaylistTagsByDescriptor`. An `ExtensibleMasterPlaylistValidator`
+ builds one `PlaylistTagsByDescriptor` for all of these validators, so they do not each need a pass over the playlist tags.
+ */
+protocol TagsByDescriptorMasterPlaylistValidator: MasterPlaylistValidator {
+    
+    static func validate(masterPlaylist: MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue]
+}
+
+extension TagsByDescriptorMasterPlaylistValidator {
+    
+    static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
+        return validate(masterPlaylist: masterPlaylist, tagsByDescriptor: PlaylistTagsByDescriptor(tags: masterPlaylist.tags))
+    }
+}
+
 /// A protocol for MasterPlaylistValidator that combines other MasterPlaylistValidator's in a superset
 public protocol ExtensibleMasterPlaylistValidator: MasterPlaylistValidator {
     /// An array of MasterPlaylistValidator types that will be used to validate playlists
@@ -50,9 +66,19 @@ public extension ExtensibleMasterPlaylistValidator {
     static func combinedValidation(ofMasterPlaylist masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
         
         var issues = [PlaylistValidationIssue]()
+        var tagsByDescriptor: PlaylistTagsByDescriptor? = nil
         
         for validator in masterPlaylistValidators {
-            let newIssues = validator.validate(masterPlaylist: masterPlaylist)
+            let newIssues: [PlaylistValidationIssue]
+            if let validator = validator as? TagsByDescriptorMasterPlaylistValidator.Type {
+                // built once, the first time a validator needs it
+                let sharedTagsByDescriptor = tagsByDescriptor ?? PlaylistTagsByDescriptor(tags: masterPlaylist.tags)
+                tagsByDescriptor = sharedTagsByDescriptor
+                newIssues = validator.validate(masterPlaylist: masterPlaylist, tagsByDescriptor: sharedTagsByDescriptor)
+            }
+            else {
+                newIssues = validator.validate(masterPlaylist: masterPlaylist)
+            }
             issues += newIssues
         }
         
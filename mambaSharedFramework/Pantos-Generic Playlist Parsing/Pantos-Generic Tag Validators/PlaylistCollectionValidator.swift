@@ -21,9 +21,9 @@ import Foundation
 
 typealias TagIdentifierPair = (tagDescriptor: PlaylistTagDescriptor, valueIdentifier: PlaylistTagValueIdentifier)
 
-protocol MasterPlaylistCollectionValidator: MasterPlaylistValidator, BasePlaylistCollectionValidator {}
+protocol MasterPlaylistCollectionValidator: TagsByDescriptorMasterPlaylistValidator, BasePlaylistCollectionValidator {}
 
-protocol VariantPlaylistCollectionValidator: VariantPlaylistValidator, BasePlaylistCollectionValidator {}
+protocol VariantPlaylistCollectionValidator: TagsByDescriptorVariantPlaylistValidator, BasePlaylistCollectionValidator {}
 
 protocol TagIdentifierPairsOwner {
     static var tagIdentifierPairs: [TagIdentifierPair] { get }
@@ -40,6 +40,11 @@ extension BasePlaylistCollectionValidator {
         }
     }
     
+    /// The tags that `filter` matches, in playlist order
+    internal static func filteredTags(from tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistTag] {
+        return tagsByDescriptor.tags(forDescriptors: tagIdentifierPairs.map { $0.tagDescriptor })
+    }
+    
     internal static func tagIdentifierPairsWithDefaultValueIdentifier(descriptors:[PlaylistTagDescriptor]) -> [TagIdentifierPair] {
         return descriptors.map { (descriptor) -> TagIdentifierPair in
             return TagIdentifierPair(descriptor,PantosValue.groupId)
@@ -48,15 +53,13 @@ extension BasePlaylistCollectionValidator {
 }
 
 extension MasterPlaylistCollectionValidator {
-    static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
-        let tags = (try? masterPlaylist.tags.filter(filter)) ?? []
-        return validation(tags)
+    static func validate(masterPlaylist: MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        return validation(filteredTags(from: tagsByDescriptor))
     }
 }
 
 extension VariantPlaylistCollectionValidator {
-    static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
-        let tags = (try? variantPlaylist.tags.filter(filter)) ?? []
-        return validation(tags)
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        return validation(filteredTags(from: tagsByDescriptor))
     }
 }
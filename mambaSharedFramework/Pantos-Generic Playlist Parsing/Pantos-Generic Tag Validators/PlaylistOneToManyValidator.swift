@@ -33,24 +33,22 @@ extension CorePlaylistOneToManyValidator {
     }
 }
 
-protocol MasterPlaylistOneToManyValidator: MasterPlaylistValidator, CorePlaylistOneToManyValidator {}
+protocol MasterPlaylistOneToManyValidator: TagsByDescriptorMasterPlaylistValidator, CorePlaylistOneToManyValidator {}
 
 extension MasterPlaylistOneToManyValidator {
-    static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
-        let many = try? masterPlaylist.tags.filter(self.filter)
-        var one: PlaylistTag?
-        for tag in masterPlaylist.tags { if tag.tagDescriptor == self.oneTagDescriptor { one = tag; break } }
+    static func validate(masterPlaylist: MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        let many = tagsByDescriptor.tags(forDescriptor: self.manyTagDescriptor)
+        let one = tagsByDescriptor.firstTag(forDescriptor: self.oneTagDescriptor)
         return validation(one, many)
     }
 }
 
-protocol VariantPlaylistOneToManyValidator: VariantPlaylistValidator, CorePlaylistOneToManyValidator {}
+protocol VariantPlaylistOneToManyValidator: TagsByDescriptorVariantPlaylistValidator, CorePlaylistOneToManyValidator {}
 
 extension VariantPlaylistOneToManyValidator {
-    static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
-        let many = try? variantPlaylist.tags.filter(self.filter)
-        var one: PlaylistTag?
-        for tag in variantPlaylist.tags { if tag.tagDescriptor == self.oneTagDescriptor { one = tag; break } }
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        let many = tagsByDescriptor.tags(forDescriptor: self.manyTagDescriptor)
+        let one = tagsByDescriptor.firstTag(forDescriptor: self.oneTagDescriptor)
         return validation(one, many)
     }
 }
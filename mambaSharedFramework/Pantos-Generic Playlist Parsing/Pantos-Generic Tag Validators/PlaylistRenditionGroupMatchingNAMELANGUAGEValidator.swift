@@ -26,9 +26,8 @@ class PlaylistRenditionGroupMatchingNAMELANGUAGEValidator: MasterPlaylistTagGrou
     private static let standardError = PlaylistValidationIssue(description: IssueDescription.PlaylistRenditionGroupMatchingNAMELANGUAGEValidator,
                                                                severity: IssueSeverity.error)
     
-    static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
-        let tags = (try? masterPlaylist.tags.filter(self.filter)) ?? []
-        let groups = groupBy(tags: tags)
+    static func validate(masterPlaylist: MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        let groups = groupBy(tags: filteredTags(from: tagsByDescriptor))
         return crossGroupValidation(groups)
     }
 
@@ -20,7 +20,7 @@
 import Foundation
 
 // This is an aggregate validator that encapsulates all of the Cardinality validations so that for efficiencies sake, we are only filtering over the tags once.
-class PlaylistAggregateTagCardinalityValidator: VariantPlaylistValidator {
+class PlaylistAggregateTagCardinalityValidator: TagsByDescriptorVariantPlaylistValidator {
     
     static let validations: [PlaylistTagCardinalityValidation.Type] = [EXT_X_MEDIA_SEQUENCEValidation.self,
                                                                        EXT_X_DISCONTINUITY_SEQUENCEValidation.self,
@@ -29,12 +29,11 @@ class PlaylistAggregateTagCardinalityValidator: VariantPlaylistValidator {
                                                                        EXT_X_TARGETDURATIONValidation.self]
     
     
-    public static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
         var issues = [PlaylistValidationIssue]()
         let validator = PlaylistCardinalityValidator()
-        let tags = variantPlaylist.tags.filter { (tag) -> Bool in validations.contains(where: { $0.tagDescriptor == tag.tagDescriptor }) }
         for validation in validations {
-            if let issue = validator.validate(validation: validation, tags: tags) { issues.append(issue) }
+            if let issue = validator.validate(validation: validation, count: tagsByDescriptor.count(forDescriptor: validation.tagDescriptor)) { issues.append(issue) }
         }
         return issues
 
@@ -46,6 +45,11 @@ class PlaylistCardinalityValidator {
     func validate(validation: PlaylistTagCardinalityValidation.Type, tags: [PlaylistTag]) -> PlaylistValidationIssue? {
 
         let count = tags.filter { (tag) -> Bool in tag.tagDescriptor == validation.tagDescriptor }.count
+        return validate(validation: validation, count: count)
+    }
+    
+    func validate(validation: PlaylistTagCardinalityValidation.Type, count: Int) -> PlaylistValidationIssue? {
+        
         if count < validation.min || count > validation.max {
             return PlaylistValidationIssue(description: validation.description, severity: IssueSeverity.error)
         }
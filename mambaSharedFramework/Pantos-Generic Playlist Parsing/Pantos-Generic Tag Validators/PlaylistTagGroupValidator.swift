@@ -23,14 +23,24 @@ protocol CorePlaylistGroupByValidator: TagIdentifierPairsOwner {}
 
 extension CorePlaylistGroupByValidator {
     internal static func groupBy(tags: [PlaylistTag]) -> [String:[PlaylistTag]] {
-        var groups = [String:[PlaylistTag]]()
+        return Dictionary(uniqueKeysWithValues: orderedGroupBy(tags: tags).map { ($0.groupId, $0.tags) })
+    }
+    
+    /// The groups in the order of their first tag, so that we report issues in the same order every time
+    internal static func orderedGroupBy(tags: [PlaylistTag]) -> [(groupId: String, tags: [PlaylistTag])] {
+        var groups = [(groupId: String, tags: [PlaylistTag])]()
+        var groupIndexes = [String: Int]()
         for tag in tags {
             for pair in Self.tagIdentifierPairs {
                 if pair.tagDescriptor == tag.tagDescriptor {
                     if let groupId: String = tag.value(forValueIdentifier: pair.valueIdentifier) {
-                        var group = groups[groupId] ?? [PlaylistTag]()
-                        group.append(tag)
-                        groups[groupId] = group
+                        if let groupIndex = groupIndexes[groupId] {
+                            groups[groupIndex].tags.append(tag)
+                        }
+                        else {
+                            groupIndexes[groupId] = groups.count
+                            groups.append((groupId: groupId, tags: [tag]))
+                        }
                         break
                     }
                 }
@@ -45,12 +55,11 @@ protocol MasterPlaylistTagGroupValidator: MasterPlaylistCollectionValidator, Cor
 
 extension MasterPlaylistTagGroupValidator {
     
-    static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
-        let tags = (try? masterPlaylist.tags.filter(self.filter)) ?? []
-        let groups = groupBy(tags: tags)
+    static func validate(masterPlaylist: MasterPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        let groups = orderedGroupBy(tags: filteredTags(from: tagsByDescriptor))
         var issues = [PlaylistValidationIssue]()
         for group in groups {
-            let groupIssues = validation(group.value)
+            let groupIssues = validation(group.tags)
             issues += groupIssues
         }
         return issues
@@ -62,12 +71,11 @@ protocol VariantPlaylistTagGroupValidator: VariantPlaylistCollectionValidator, C
 
 extension VariantPlaylistTagGroupValidator {
     
-    static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
-        let tags = (try? variantPlaylist.tags.filter(self.filter)) ?? []
-        let groups = groupBy(tags: tags)
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue] {
+        let groups = orderedGroupBy(tags: filteredTags(from: tagsByDescriptor))
         var issues = [PlaylistValidationIssue]()
         for group in groups {
-            let groupIssues = validation(group.value)
+            let groupIssues = validation(group.tags)
             issues += groupIssues
         }
         return issues
@@ -0,0 +1,66 @@
+//
+//  PlaylistTagsByDescriptor.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ The tags of a playlist grouped by descriptor, in playlist order.
+ 
+ Playlist validators that need only a few kinds of tag find them here, so that all of them together make
+ one pass over the playlist rather than one pass each.
+ */
+struct PlaylistTagsByDescriptor {
+    
+    private let tags: [PlaylistTag]
+    private let indexes: [PlaylistTagDescriptorKey: [Int]]
+    
+    init(tags: [PlaylistTag]) {
+        var indexes = [PlaylistTagDescriptorKey: [Int]]()
+        for (index, tag) in tags.enumerated() {
+            indexes[PlaylistTagDescriptorKey(tag.tagDescriptor), default: []].append(index)
+        }
+        self.tags = tags
+        self.indexes = indexes
+    }
+    
+    /// All tags with the descriptor, in playlist order
+    func tags(forDescriptor descriptor: PlaylistTagDescriptor) -> [PlaylistTag] {
+        return indexes[PlaylistTagDescriptorKey(descriptor)]?.map { tags[$0] } ?? []
+    }
+    
+    /// All tags with any of the descriptors, in playlist order
+    func tags(forDescriptors descriptors: [PlaylistTagDescriptor]) -> [PlaylistTag] {
+        let keys = Set(descriptors.map { PlaylistTagDescriptorKey($0) })
+        guard keys.count > 1 else {
+            return descriptors.first.map { tags(forDescriptor: $0) } ?? []
+        }
+        let matchingIndexes = keys.flatMap { indexes[$0] ?? [] }.sorted()
+        return matchingIndexes.map { tags[$0] }
+    }
+    
+    /// The first tag with the descriptor
+    func firstTag(forDescriptor descriptor: PlaylistTagDescriptor) -> PlaylistTag? {
+        return indexes[PlaylistTagDescriptorKey(descriptor)]?.first.map { tags[$0] }
+    }
+    
+    /// The number of tags with the descriptor
+    func count(forDescriptor descriptor: PlaylistTagDescriptor) -> Int {
+        return indexes[PlaylistTagDescriptorKey(descriptor)]?.count ?? 0
+    }
+}
@@ -27,26 +27,50 @@ public extension ExtensiblePlaylistValidator {
      Runs all playlist tags through their respective validators (if present) and returns
      all found issues.
      
+     Large playlists are validated on several threads at once, so `PlaylistTagValidator`s must be
+     safe to call from any thread. Issues are returned in playlist order either way.
+     
      - parameter playlist: A `PlaylistInterface` to validate
      
      - returns: An array of `PlaylistValidationIssue`s. Will be empty if no issues are found.
      */
     static func validateTags(fromPlaylist playlist: PlaylistInterface) -> [PlaylistValidationIssue] {
         
-        var issues = [PlaylistValidationIssue]()
+        let tags = playlist.tagCollection
+        let registeredPlaylistTags = playlist.registeredPlaylistTags
+        let count = tags.count
+        let sliceCount = max(min(count / PlaylistTagValidationSlicing.minimumTagsPerSlice,
+                                 PlaylistTagValidationSlicing.maximumSliceCount), 1)
         
-        for tag in playlist.tags {
-            guard let validator = playlist.registeredPlaylistTags.validator(forTag: tag.tagDescriptor) else {
-                continue
+        func validateTags(inRange range: Range<Int>) -> [PlaylistValidationIssue] {
+            var issues = [PlaylistValidationIssue]()
+            for tag in tags[range] {
+                guard let validator = registeredPlaylistTags.validator(forTag: tag.tagDescriptor) else {
+                    continue
+                }
+                guard let newIssues = validator.validate(tag: tag) else {
+                    continue
+                }
+                
+                issues.append(contentsOf: newIssues)
             }
-            guard let newIssues = validator.validate(tag: tag) else {
-                continue
+            return issues
+        }
+        
+        guard sliceCount > 1 else {
+            return validateTags(inRange: 0..<count)
+        }
+        
+        // each thread takes a contiguous slice of the tags, and the slices are joined in order,
+        // so the issues are in the same order as a serial validation
+        var sliceIssues = [[PlaylistValidationIssue]](repeating: [], count: sliceCount)
+        sliceIssues.withUnsafeMutableBufferPointer { sliceIssuesBuffer in
+            DispatchQueue.concurrentPerform(iterations: sliceCount) { slice in
+                sliceIssuesBuffer[slice] = validateTags(inRange: (count * slice / sliceCount)..<(count * (slice + 1) / sliceCount))
             }
-            
-            issues += newIssues
         }
-
-        return issues
+        
+        return Array(sliceIssues.joined())
     }
     
     static func validate(masterPlaylist: MasterPlaylistInterface) -> [PlaylistValidationIssue] {
@@ -58,6 +82,15 @@ public extension ExtensiblePlaylistValidator {
     }
 }
 
+/// How `ExtensiblePlaylistValidator.validateTags(fromPlaylist:)` splits a playlist between threads
+enum PlaylistTagValidationSlicing {
+    
+    /// Playlists with fewer than twice this many tags are validated on a single thread
+    static let minimumTagsPerSlice = 2048
+    
+    static let maximumSliceCount = ProcessInfo.processInfo.activeProcessorCount
+}
+
 public class PlaylistValidator: ExtensiblePlaylistValidator {
     
     public static let masterPlaylistValidators: [MasterPlaylistValidator.Type] = [PlaylistRenditionGroupValidator.self,
@@ -32,6 +32,22 @@ public protocol VariantPlaylistValidator {
     static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue]
 }
 
+/**
+ A `VariantPlaylistValidator` that finds the tags it needs in a `PlaylistTagsByDescriptor`. An `ExtensibleVariantPlaylistValidator`
+ builds one `PlaylistTagsByDescriptor` for all of these validators, so they do not each need a pass over the playlist tags.
+ */
+protocol TagsByDescriptorVariantPlaylistValidator: VariantPlaylistValidator {
+    
+    static func validate(variantPlaylist: VariantPlaylistInterface, tagsByDescriptor: PlaylistTagsByDescriptor) -> [PlaylistValidationIssue]
+}
+
+extension TagsByDescriptorVariantPlaylistValidator {
+    
+    static func validate(variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
+        return validate(variantPlaylist: variantPlaylist, tagsByDescriptor: PlaylistTagsByDescriptor(tags: variantPlaylist.tags))
+    }
+}
+
 /// A protocol for VariantPlaylistValidator that combines other VariantPlaylistValidator's in a superset
 public protocol ExtensibleVariantPlaylistValidator: VariantPlaylistValidator {
     /// An array of VariantPlaylistValidator types that will be used to validate playlists
@@ -50,9 +66,19 @@ public extension ExtensibleVariantPlaylistValidator {
     static func combinedValidation(ofVariantPlaylist variantPlaylist: VariantPlaylistInterface) -> [PlaylistValidationIssue] {
         
         var issues = [PlaylistValidationIssue]()
+        var tagsByDescriptor: PlaylistTagsByDescriptor? = nil
         
         for validator in variantPlaylistValidators {
-            let newIssues = validator.validate(variantPlaylist: variantPlaylist)
+            let newIssues: [PlaylistValidationIssue]
+            if let validator = validator as? TagsByDescriptorVariantPlaylistValidator.Type {
+                // built once, the first time a validator needs it
+                let sharedTagsByDescriptor = tagsByDescriptor ?? PlaylistTagsByDescriptor(tags: variantPlaylist.tags)
+                tagsByDescriptor = sharedTagsByDescriptor
+                newIssues = validator.validate(variantPlaylist: variantPlaylist, tagsByDescriptor: sharedTagsByDescriptor)
+            }
+            else {
+                newIssues = validator.validate(variantPlaylist: variantPlaylist)
+            }
             issues += newIssues
         }
         
@@ -20,30 +20,36 @@
 import Foundation
 
 /// Generic writer for dictionary style tags
-public struct GenericDictionaryTagWriter: PlaylistTagWriter {
+public struct GenericDictionaryTagWriter: PlaylistTagBufferWriter {
     
     public init() {}
     
     public func write(tag: PlaylistTag, toStream stream: OutputStream) throws {
-        try stream.write(stringRef: tag.tagName!)
+        try writeThroughBuffer(tag: tag, toStream: stream)
+    }
+    
+    func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws {
+        buffer.append(tagString: tag.tagNameString!)
         
-        if tag.keys.count > 0 {
-            try stream.write(unicodeScalar: PlaylistTagWritingSeparators.colon)
-            let pairs = tag.keys.map { key -> String in
-                var str = key
-                str.append("=")
-                let value = tag.valueData(forKey: key)! // safe because we just got the list of keys
-                if value.quoteEscaped {
-                    str.append("\"")
-                }
-                str.append(value.value)
-                if value.quoteEscaped {
-                    str.append("\"")
-                }
-                return str
+        let keys = tag.keys
+        guard keys.count > 0 else {
+            return
+        }
+        try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.colon)
+        for (index, key) in keys.enumerated() {
+            if index > 0 {
+                try buffer.append(unicodeScalar: ",")
+            }
+            buffer.append(string: key)
+            try buffer.append(unicodeScalar: "=")
+            let value = tag.valueData(forKey: key)! // safe because we just got the list of keys
+            if value.quoteEscaped {
+                try buffer.append(unicodeScalar: "\"")
+            }
+            buffer.append(string: value.value)
+            if value.quoteEscaped {
+                try buffer.append(unicodeScalar: "\"")
             }
-            let body = pairs.joined(separator: ",")
-            try stream.write(string: body)
         }
     }
 }
@@ -20,7 +20,7 @@
 import Foundation
 
 /// Generic writer for playlist tags that have just one single value (e.g. `#EXT-X-TARGETDURATION:10`)
-public struct GenericSingleTagWriter: PlaylistTagWriter {
+public struct GenericSingleTagWriter: PlaylistTagBufferWriter {
     
     fileprivate let singleTagValueIdentifier: PlaylistTagValueIdentifier
     
@@ -29,6 +29,10 @@ public struct GenericSingleTagWriter: PlaylistTagWriter {
     }
     
     public func write(tag: PlaylistTag, toStream stream: OutputStream) throws {
+        try writeThroughBuffer(tag: tag, toStream: stream)
+    }
+    
+    func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws {
         
         guard tag.keys.count == 1 else {
             throw OutputStreamError.invalidData(description:"\(tag.tagDescriptor.toString()) PlaylistTag requires a \(singleTagValueIdentifier.toString()) value. Found \(tag.keys.count) values instead. Keys found: \(tag.keys)")
@@ -38,8 +42,8 @@ public struct GenericSingleTagWriter: PlaylistTagWriter {
             throw OutputStreamError.invalidData(description:"\(tag.tagDescriptor.toString()) PlaylistTag requires a \(singleTagValueIdentifier.toString()) value. The key found instead was \"\(tag.keys[0])\"")
         }
         
-        try stream.write(stringRef: tag.tagName!)
-        try stream.write(unicodeScalar: PlaylistTagWritingSeparators.colon)
-        try stream.write(string: value)
+        buffer.append(tagString: tag.tagNameString!)
+        try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.colon)
+        buffer.append(string: value)
     }
 }
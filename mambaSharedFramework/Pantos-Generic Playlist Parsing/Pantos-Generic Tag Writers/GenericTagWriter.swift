@@ -21,24 +21,26 @@ import Foundation
 
 /// A generic writer for tags that pays no attention to structure. It will just take the tag and any data and write it directly to stream.
 /// This is useful for `PantosTag.UnknownTag` type tags where we do not recognize the type.
-struct GenericTagWriter: PlaylistTagWriter {
+struct GenericTagWriter: PlaylistTagBufferWriter {
     
     func write(tag: PlaylistTag, toStream stream: OutputStream) throws {
-        try GenericTagWriter.write(tag: tag, toStream: stream)
+        try writeThroughBuffer(tag: tag, toStream: stream)
     }
     
-    static func write(tag: PlaylistTag, toStream stream: OutputStream) throws {
+    func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws {
+        try GenericTagWriter.write(tag: tag, toBuffer: buffer)
+    }
+    
+    static func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws {
         assert(!tag.isDirty, "GenericTagWriter cannot write dirty tags")
         
-        if let name = tag.tagName, name.length > 0 {
-            try stream.write(stringRef: name)
-            if tag.tagData.length > 0 {
-                try stream.write(unicodeScalar: PlaylistTagWritingSeparators.colon)
+        if let name = tag.tagNameString, name.length > 0 {
+            buffer.append(tagString: name)
+            if tag.tagDataString.length > 0 {
+                try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.colon)
             }
         }
         
-        if tag.tagData.length > 0 {
-            try stream.write(stringRef: tag.tagData)
-        }
+        buffer.append(tagString: tag.tagDataString)
     }
 }
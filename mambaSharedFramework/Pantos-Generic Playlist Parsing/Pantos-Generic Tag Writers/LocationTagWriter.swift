@@ -20,12 +20,13 @@
 import Foundation
 
 /// A tag writer for `PantosTag.Location` tags.
-struct LocationTagWriter: PlaylistTagWriter {
+struct LocationTagWriter: PlaylistTagBufferWriter {
     
     func write(tag: PlaylistTag, toStream stream: OutputStream) throws {
-        
-        if tag.tagData.length > 0 {
-            try stream.write(stringRef: tag.tagData)
-        }
+        try writeThroughBuffer(tag: tag, toStream: stream)
+    }
+    
+    func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws {
+        buffer.append(tagString: tag.tagDataString)
     }
 }
@@ -39,7 +39,7 @@ import HLSObjectiveC
  `.EXTINF`: Since this is such a common tag and appears in great numbers, the duration is available as a direct
  property on `PlaylistTag`. This allows us to speed parsing of these tags.
  */
-public enum PantosTag: String {
+public enum PantosTag: String, CaseIterable {
     
     // MARK: special tags
     
@@ -87,7 +87,11 @@ public enum PantosTag: String {
     case EXT_X_SKIP = "EXT-X-SKIP"
 }
 
-extension PantosTag: PlaylistTagDescriptor, Equatable {
+extension PantosTag: PlaylistTagDescriptorEnumerable, Equatable {
+    
+    public static var allTagDescriptors: [PlaylistTagDescriptor] {
+        return allCases
+    }
     
     public static func constructTag(tag: String) -> PlaylistTagDescriptor? {
         return PantosTag(rawValue: tag)
@@ -621,4 +625,79 @@ extension PantosTag: PlaylistTagDescriptor, Equatable {
         
         return dictionary
     }()
+    
+    /**
+     Returns the `PantosTag` for a tag name that the rapid parser recognized while scanning.
+     
+     - parameter forRapidParserTagID: The `tagID` of a `RapidParserLineRecord`
+     
+     - returns: The matching `PantosTag`, or nil for `RapidParserTagIDNone` (the caller should look up the tag name instead)
+     */
+    static func descriptor(forRapidParserTagID tagID: UInt8) -> PantosTag? {
+        let index = Int(tagID)
+        guard index < rapidParserTagIDLookup.count else {
+            return nil
+        }
+        return rapidParserTagIDLookup[index]
+    }
+    
+    /// The ID the rapid parser gives this tag, or `RapidParserTagIDNone` for the special tags it does not scan for
+    var rapidParserTagID: RapidParserTagID {
+        switch self {
+        case .Comment, .UnknownTag, .Location: return RapidParserTagIDNone
+        case .EXTM3U: return RapidParserTagIDEXTM3U
+        case .EXT_X_VERSION: return RapidParserTagIDEXT_X_VERSION
+        case .EXT_X_MEDIA: return RapidParserTagIDEXT_X_MEDIA
+        case .EXT_X_STREAM_INF: return RapidParserTagIDEXT_X_STREAM_INF
+        case .EXT_X_I_FRAME_STREAM_INF: return RapidParserTagIDEXT_X_I_FRAME_STREAM_INF
+        case .EXT_X_SESSION_DATA: return RapidParserTagIDEXT_X_SESSION_DATA
+        case .EXT_X_SESSION_KEY: return RapidParserTagIDEXT_X_SESSION_KEY
+        case .EXT_X_CONTENT_STEERING: return RapidParserTagIDEXT_X_CONTENT_STEERING
+        case .EXT_X_TARGETDURATION: return RapidParserTagIDEXT_X_TARGETDURATION
+        case .EXT_X_MEDIA_SEQUENCE: return RapidParserTagIDEXT_X_MEDIA_SEQUENCE
+        case .EXT_X_ENDLIST: return RapidParserTagIDEXT_X_ENDLIST
+        case .EXT_X_PLAYLIST_TYPE: return RapidParserTagIDEXT_X_PLAYLIST_TYPE
+        case .EXT_X_I_FRAMES_ONLY: return RapidParserTagIDEXT_X_I_FRAMES_ONLY
+        case .EXT_X_ALLOW_CACHE: return RapidParserTagIDEXT_X_ALLOW_CACHE
+        case .EXT_X_INDEPENDENT_SEGMENTS: return RapidParserTagIDEXT_X_INDEPENDENT_SEGMENTS
+        case .EXT_X_START: return RapidParserTagIDEXT_X_START
+        case .EXTINF: return RapidParserTagIDEXTINF
+        case .EXT_X_BITRATE: return RapidParserTagIDEXT_X_BITRATE
+        case .EXT_X_BYTERANGE: return RapidParserTagIDEXT_X_BYTERANGE
+        case .EXT_X_KEY: return RapidParserTagIDEXT_X_KEY
+        case .EXT_X_MAP: return RapidParserTagIDEXT_X_MAP
+        case .EXT_X_PROGRAM_DATE_TIME: return RapidParserTagIDEXT_X_PROGRAM_DATE_TIME
+        case .EXT_X_DISCONTINUITY: return RapidParserTagIDEXT_X_DISCONTINUITY
+        case .EXT_X_DISCONTINUITY_SEQUENCE: return RapidParserTagIDEXT_X_DISCONTINUITY_SEQUENCE
+        case .EXT_X_DATERANGE: return RapidParserTagIDEXT_X_DATERANGE
+        case .EXT_X_SKIP: return RapidParserTagIDEXT_X_SKIP
+        }
+    }
+    
+    /**
+     A small integer for this tag, for indexing arrays instead of hashing the tag name. This is the rapid
+     parser's tag ID, or for the special tags that do not have one, an index after the last ID.
+     */
+    var tagIndex: Int {
+        switch self {
+        case .Comment: return Int(numberOfRapidParserTagIDs.rawValue)
+        case .UnknownTag: return Int(numberOfRapidParserTagIDs.rawValue) + 1
+        case .Location: return Int(numberOfRapidParserTagIDs.rawValue) + 2
+        default: return Int(rapidParserTagID.rawValue)
+        }
+    }
+    
+    /// One more than the largest `tagIndex`
+    static let tagIndexCount = Int(numberOfRapidParserTagIDs.rawValue) + 3
+    
+    static let rapidParserTagIDLookup: [PantosTag?] = {
+        
+        return (0..<UInt8(numberOfRapidParserTagIDs.rawValue)).map { tagID in
+            guard let name = rapidParserTagNameForTagID(tagID) else {
+                return nil
+            }
+            // the rapid parser's names include the leading "#"
+            return PantosTag(rawValue: String(String(cString: name).dropFirst()))
+        }
+    }()
 }
@@ -0,0 +1,85 @@
+//
+//  FrozenPlaylist.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
+/**
+ An immutable snapshot of a `PlaylistCore`, made by `PlaylistCore.frozen()`.
+ 
+ Reading a `PlaylistCore` goes through the queue of its structure, which builds the structure the first time
+ it is read after an edit. A frozen playlist is fully built when it is made: its tags, media groups, spans and
+ timeline lookups are all plain values, and tag values deferred by the parser have already been parsed (a tag
+ whose values failed to parse keeps the error, settled so that it is read without a lock). Reading it takes no
+ lock and never changes it, so any number of threads may read the same frozen playlist at once.
+ 
+ Use `PlaylistCore.init(_:)` to get an editable playlist back. That does not rebuild the structure.
+ */
+public struct FrozenPlaylist<PT>: PlaylistTagSource, RegisteredPlaylistTagsProvider where PT: PlaylistTypeInterface, PT.playlistStructureType: FreezablePlaylistStructure {
+    
+    /// A read-only array of the `PlaylistTag`s in this playlist.
+    public var tags: [PlaylistTag] {
+        return structure.tags
+    }
+    
+    /// The `PlaylistTag`s in this playlist, read without building an `Array`.
+    public var tagCollection: PlaylistTagCollection {
+        return structure.tagCollection
+    }
+    
+    /// custom playlist data
+    public let customData: PT.customPlaylistDataType
+    
+    /// Many of the tags in this playlist contain `MambaStringRef`s with pointers to memory within a `Data` object.
+    /// This reference is here to assure that the data will not go out of scope.
+    public let playlistMemoryStorage: StaticMemoryStorage
+    
+    /// The registered tag types for this playlist
+    public let registeredPlaylistTags: RegisteredPlaylistTags
+    
+    let structure: PT.playlistStructureType.FrozenStructureType
+    
+    /**
+     Grab a PlaylistTagCollection representing the given PlaylistTag Group.
+     
+     - parameter forMediaGroup: The media group that is used for the tag selection.
+     
+     - returns: A PlaylistTagCollection of the tags in the given media group.
+     */
+    public func tags(forMediaGroup group: PlaylistTagGroupProtocol) -> PlaylistTagCollection {
+        return tagCollection[group.range]
+    }
+    
+    /**
+     Write a playlist.
+     
+     - throws: Errors from a `PlaylistWriter` whilst attempting to write
+     - returns: `Data` if successful
+     */
+    public func write() throws -> Data {
+        
+        let writer = PlaylistWriter()
+        return try writer.write(tagSource: self)
+    }
+}
+
+extension FrozenPlaylist: PlaylistMemoryStorageSource {}
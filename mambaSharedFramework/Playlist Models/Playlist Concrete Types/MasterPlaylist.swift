@@ -28,6 +28,15 @@ extension PlaylistCore: MasterPlaylistTagGroupProvider, MasterStreamSummaryCalcu
     public var variantTagGroups: [VariantTagGroup] { return structure.variantTagGroups }
 }
 
+/**
+ `FrozenMasterPlaylist` is an immutable snapshot of a `MasterPlaylist`. See `FrozenPlaylist`.
+ */
+public typealias FrozenMasterPlaylist = FrozenPlaylist<MasterPlaylistType>
+
+extension FrozenPlaylist: MasterPlaylistTagGroupProvider where PT == MasterPlaylistType {
+    public var variantTagGroups: [VariantTagGroup] { return structure.variantTagGroups }
+}
+
 /**
  This is a protocol that defines the standard `MasterPlaylist` interface.
  
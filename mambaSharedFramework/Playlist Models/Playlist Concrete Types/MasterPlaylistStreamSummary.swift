@@ -38,6 +38,7 @@ extension PlaylistCore where PT == MasterPlaylistType {
     
     public func calculateStreamSummary() -> Result<PlaylistStreamSummary, StreamSummaryError> {
         
+        let tags = tagCollection
         var streams = [PlaylistStream]()
         var nonStreamMediaGroupInfo = [NonStreamMediaGroupInfo]()
         
@@ -125,7 +126,7 @@ extension PlaylistCore where PT == MasterPlaylistType {
             guard let bandwidth: Int = streamInfTag.value(forValueIdentifier: PantosValue.bandwidthBPS) else {
                 return .failure(.invalidMasterPlaylistError(errorText: "Bandwidth is required for streamInf tags"))
             }
-            let uri = locationTag.tagData.stringValue()
+            let uri = locationTag.tagDataString.stringValue()
             
             // make the complicated decision about if we are muxed or not
             let streamInfContainsAudio = containsMediaInfo(forStreamContents: .audio,
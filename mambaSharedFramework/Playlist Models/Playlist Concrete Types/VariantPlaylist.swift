@@ -92,43 +92,99 @@ extension PlaylistCore: PlaylistTypeDetermination, PlaylistTimelineTranslator, V
     }
     
     public func mediaGroup(forTime time: CMTime) -> MediaSegmentPlaylistTagGroup? {
-        let segments = mediaSegmentGroups.filter { $0.timeRange.containsTime(time) }
-        
-        guard let segment = segments.first else {
-            // if we ask for a time that is our playlist's end time, we should return the last segment
-            if CMTimeCompare(endTime, time) == 0 {
-                return mediaSegmentGroups.last
-            }
-            return nil
-        }
-        
-        return segment
+        return structure.structureData.mediaSegmentGroup(forTime: time)
     }
     
     public func mediaGroup(forTagIndex tagIndex: Int) -> MediaSegmentPlaylistTagGroup? {
-        let segments = mediaSegmentGroups.filter { $0.startIndex <= tagIndex && $0.endIndex >= tagIndex }
-        
-        guard let segment = segments.first else { return nil }
-        
-        return segment
+        return structure.structureData.mediaSegmentGroup(forTagIndex: tagIndex)
     }
     
     public func mediaGroup(forMediaSequence mediaSequence: MediaSequence) -> MediaSegmentPlaylistTagGroup? {
-        let segments = mediaSegmentGroups.filter { $0.mediaSequence == mediaSequence }
-        
-        guard let segment = segments.first else { return nil }
-        
-        return segment
+        return structure.structureData.mediaSegmentGroup(forMediaSequence: mediaSequence)
     }
     
     public func segmentName(forMediaSequence mediaSequence: MediaSequence) -> String? {
         guard let group = mediaGroup(forMediaSequence: mediaSequence) else {
             return nil
         }
-        guard let locationTag = Array(tags[group.range]).filter({ $0.tagDescriptor == PantosTag.Location }).first else {
+        guard let locationTag = tagCollection[group.range].filter({ $0.tagDescriptor == PantosTag.Location }).first else {
+            return nil
+        }
+        return locationTag.tagDataString.stringValue()
+    }
+}
+
+/**
+ `FrozenVariantPlaylist` is an immutable snapshot of a `VariantPlaylist`. See `FrozenPlaylist`.
+ */
+public typealias FrozenVariantPlaylist = FrozenPlaylist<VariantPlaylistType>
+
+extension FrozenPlaylist: PlaylistTypeDetermination, PlaylistTimelineTranslator, VariantPlaylistStructureInterface where PT == VariantPlaylistType {
+    
+    // MARK: VariantPlaylistStructureInterface
+    
+    public var header: PlaylistTagGroup? { return structure.header }
+    public var mediaSegmentGroups: [MediaSegmentPlaylistTagGroup] { return structure.mediaSegmentGroups }
+    public var footer: PlaylistTagGroup? { return structure.footer }
+    public var mediaSpans: [PlaylistTagSpan] { return structure.mediaSpans }
+    
+    // MARK: PlaylistTypeDetermination
+    
+    public var playlistType: PlaylistType {
+        return structure.playlistType
+    }
+    
+    internal func canQueryTimeline() -> Bool {
+        return playlistType == .vod
+    }
+    
+    // MARK: PlaylistTimelineTranslator
+    
+    public func mediaSequence(forTime time: CMTime) -> MediaSequence? {
+        guard canQueryTimeline() else { return nil }
+        return mediaGroup(forTime: time)?.mediaSequence
+    }
+    
+    public func mediaSequence(forTagIndex tagIndex: Int) -> MediaSequence? {
+        return mediaGroup(forTagIndex: tagIndex)?.mediaSequence
+    }
+    
+    public func timeRange(forTagIndex tagIndex: Int) -> CMTimeRange? {
+        guard canQueryTimeline() else { return nil }
+        return mediaGroup(forTagIndex: tagIndex)?.timeRange
+    }
+    
+    public func timeRange(forMediaSequence mediaSequence: MediaSequence) -> CMTimeRange? {
+        guard canQueryTimeline() else { return nil }
+        return mediaGroup(forMediaSequence: mediaSequence)?.timeRange
+    }
+    
+    public func tagIndexes(forMediaSequence mediaSequence: MediaSequence) -> PlaylistTagIndexRange? {
+        return mediaGroup(forMediaSequence: mediaSequence)?.range
+    }
+    
+    public func tagIndexes(forTime time: CMTime) -> PlaylistTagIndexRange? {
+        guard canQueryTimeline() else { return nil }
+        return mediaGroup(forTime: time)?.range
+    }
+    
+    public func mediaGroup(forTime time: CMTime) -> MediaSegmentPlaylistTagGroup? {
+        return structure.structureData.mediaSegmentGroup(forTime: time)
+    }
+    
+    public func mediaGroup(forTagIndex tagIndex: Int) -> MediaSegmentPlaylistTagGroup? {
+        return structure.structureData.mediaSegmentGroup(forTagIndex: tagIndex)
+    }
+    
+    public func mediaGroup(forMediaSequence mediaSequence: MediaSequence) -> MediaSegmentPlaylistTagGroup? {
+        return structure.structureData.mediaSegmentGroup(forMediaSequence: mediaSequence)
+    }
+    
+    public func segmentName(forMediaSequence mediaSequence: MediaSequence) -> String? {
+        guard let group = mediaGroup(forMediaSequence: mediaSequence) else {
             return nil
         }
-        return locationTag.tagData.stringValue()
+        return tagCollection[group.range].first(where: { $0.tagDescriptor == PantosTag.Location })?.tagDataString.stringValue()
     }
 }
 
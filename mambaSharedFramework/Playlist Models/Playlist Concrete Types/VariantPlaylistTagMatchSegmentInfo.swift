@@ -71,6 +71,7 @@ extension PlaylistCore where PT == VariantPlaylistType {
     public func getPlaylistSegmentMatches(usingPredicate predicate: VariantPlaylistTagMatchPredicate,
                                           withMatchesInHeaderMatchingToFirstMediaSegment matchesInHeaderMatchToFirst: Bool = true) -> [VariantPlaylistTagMatchSegmentInfo] {
         
+        let tags = tagCollection
         let matchingTagIndices = tags.indices.filter { predicate(tags[$0]) }
         
         var matches = [VariantPlaylistTagMatchSegmentInfo]()
@@ -0,0 +1,42 @@
+//
+//  FrozenPlaylistStructure.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ An immutable, fully built copy of the tags and structure of a `PlaylistStructureCore`, made by
+ `PlaylistStructureCore.frozen()`.
+ 
+ `PlaylistStructureCore` builds its structure the first time it is read after an edit, so every read goes
+ through its queue. Nothing in a frozen structure is built lazily, and tag values that were deferred by the
+ parser have already been parsed (or, if they failed to parse, their errors settled), so reading it takes no
+ lock and never changes it. Any number of threads may read the same frozen structure at once.
+ 
+ Use `PlaylistStructureCore.init(withFrozenStructure:)` to edit it again.
+ */
+public struct FrozenPlaylistStructure<PSD: PlaylistStructureDelegate>: PlaylistTagSource {
+    
+    /// A read-only array of the `PlaylistTag`s in this playlist.
+    public let tags: [PlaylistTag]
+    
+    /// The same tags, in chunks, so that thawing this structure shares them.
+    public let tagCollection: PlaylistTagCollection
+    
+    let structureData: PSD.StructureType
+}
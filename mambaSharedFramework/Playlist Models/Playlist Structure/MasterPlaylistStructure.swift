@@ -54,6 +54,11 @@ extension PlaylistStructureCore: MasterPlaylistTagGroupProvider where PSD == Mas
     public var variantTagGroups: [VariantTagGroup] { return structureData.variantTagGroups }
 }
 
+extension FrozenPlaylistStructure: MasterPlaylistTagGroupProvider where PSD == MasterPlaylistStructureDelegate {
+    
+    public var variantTagGroups: [VariantTagGroup] { return structureData.variantTagGroups }
+}
+
 public struct VariantTagGroup: PlaylistTagGroupProtocol, CustomDebugStringConvertible {
     
     public var range: PlaylistTagIndexRange
@@ -21,11 +21,14 @@ import Foundation
 import CoreMedia
 
 
-public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: PlaylistStructureInterface {
+public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: FreezablePlaylistStructure {
     
     private var structureState: StructureState = .dirtyRequiresRebuild
     
-    private var _tags: [PlaylistTag]
+    // Chunked, so that a copy of this structure (see `init(withStructure:)`) shares the tags it does not edit
+    private var _tags: ChunkedArray<PlaylistTag>
+    // `_tags` as an array, built the first time `tags` is read after an edit, so that reading `tags` stays O(1)
+    private var _tagArray: [PlaylistTag]?
     private let delegate: PSD
     
     var _structureData: PSD.StructureType
@@ -39,24 +42,57 @@ public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: Playli
                   withStructureData: PSD.StructureType())
     }
     
-    init(withTags tags: [PlaylistTag],
-         withDelegate delegate: PSD,
-         withStructureData structureData: PSD.StructureType) {
+    convenience init(withTags tags: [PlaylistTag],
+                     withDelegate delegate: PSD,
+                     withStructureData structureData: PSD.StructureType) {
+        self.init(withChunkedTags: ChunkedArray(tags),
+                  tagArray: tags,
+                  withDelegate: delegate,
+                  withStructureData: structureData)
+    }
+    
+    private init(withChunkedTags tags: ChunkedArray<PlaylistTag>,
+                 tagArray: [PlaylistTag]?,
+                 withDelegate delegate: PSD,
+                 withStructureData structureData: PSD.StructureType) {
         self._tags = tags
+        self._tagArray = tagArray
         self.delegate = delegate
         self._structureData = structureData
     }
     
     required public init(withStructure structure: PlaylistStructureCore) {
-        self._tags = structure.tags
+        let (tags, tagArray) = structure.queue.sync {
+            return (structure._tags, structure._tagArray)
+        }
+        self._tags = tags
+        self._tagArray = tagArray
         self.delegate = structure.delegate
         self.structureState = structure.structureState
         self._structureData = structure._structureData
     }
     
+    /// Our tags as an `Array`. The array is built the first time this is read after an edit, and shared after that.
     public var tags: [PlaylistTag] {
         return queue.sync {
-            return _tags
+            return tagArray
+        }
+    }
+    
+    // only call on `queue`
+    private var tagArray: [PlaylistTag] {
+        if let tagArray = _tagArray {
+            return tagArray
+        }
+        let tagArray = _tags.array
+        _tagArray = tagArray
+        return tagArray
+    }
+    
+    /// Our tags, read straight from the chunks they are stored in. This is O(1).
+    public var tagCollection: PlaylistTagCollection {
+        return queue.sync {
+            return PlaylistTagCollection(_tags)
         }
     }
 
@@ -67,9 +103,36 @@ public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: Playli
         }
     }
 
+    public typealias FrozenStructureType = FrozenPlaylistStructure<PSD>
+    
+    /**
+     Returns a fully built, immutable copy of our tags and structure, which any number of threads may read without locking.
+     
+     This rebuilds our structure if required and parses any tag values that have not been parsed yet, so it is O(n).
+     */
+    public func frozen() -> FrozenPlaylistStructure<PSD> {
+        return queue.sync {
+            rebuildIfRequired()
+            let tags = _tags.map { $0.resolvingDeferredValues() }
+            return FrozenPlaylistStructure(tags: tags.array,
+                                           tagCollection: PlaylistTagCollection(tags),
+                                           structureData: _structureData.frozen())
+        }
+    }
+    
+    /// Creates an editable structure from a frozen one. The structure is not rebuilt.
+    public convenience init(withFrozenStructure structure: FrozenPlaylistStructure<PSD>) {
+        self.init(withChunkedTags: structure.tagCollection.chunkedArray,
+                  tagArray: structure.tags,
+                  withDelegate: PSD(),
+                  withStructureData: structure.structureData)
+        self.structureState = .clean
+    }
+    
     public func insert(tag: PlaylistTag, atIndex index: Int) {
         queue.sync {
-            _tags.insert(tag, at: index)
+            _tags.insert(contentsOf: [tag], at: index)
+            _tagArray = nil
             added(tags: [tag], atIndex: index)
         }
     }
@@ -77,6 +140,7 @@ public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: Playli
     public func insert(tags: [PlaylistTag], atIndex index: Int) {
         queue.sync {
             self._tags.insert(contentsOf: tags, at: index)
+            _tagArray = nil
             added(tags: tags, atIndex: index)
         }
     }
@@ -84,22 +148,43 @@ public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: Playli
     public func delete(atIndex index: Int) {
         queue.sync {
             deleted(numberOfTags: 1, atIndex: index)
-            _tags.remove(at: index)
+            _tags.removeSubrange(index..<(index + 1))
+            _tagArray = nil
         }
     }
     
     public func delete(atRange range: PlaylistTagIndexRange) {
         queue.sync {
             deleted(numberOfTags: range.count, atIndex: range.lowerBound)
-            _tags.removeSubrange(range)
+            _tags.removeSubrange(Range(range))
+            _tagArray = nil
         }
     }
     
     public func transform(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws {
         try queue.sync {
-            _tags = try _tags.map(mapping)
+            transformed(toTags: try _tags.map(mapping))
+        }
+    }
+    
+    public func transformConcurrently(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws {
+        try queue.sync {
+            transformed(toTags: try _tags.concurrentMap(mapping))
+        }
+    }
+    
+    /**
+     Replaces our tags with the result of a `transform`. The structure is only rebuilt if the delegate
+     finds a structural change, so rewriting tags such as segment URLs keeps it.
+     
+     Only call on `queue`.
+     */
+    private func transformed(toTags tags: ChunkedArray<PlaylistTag>) {
+        if structureState != .dirtyRequiresRebuild && zip(_tags, tags).contains(where: { delegate.isStructuralChange(from: $0, to: $1) }) {
             structureState = .dirtyRequiresRebuild
         }
+        _tags = tags
+        _tagArray = nil
     }
     
     /**
@@ -115,18 +200,17 @@ public final class PlaylistStructureCore<PSD: PlaylistStructureDelegate>: Playli
             return
         case .dirtyWithTagChanges(let tagChanges):
             for tagChange in tagChanges {
-                let result = delegate.changed(numberOfTags: tagChange.tagChangeCount,
-                                              atIndex: tagChange.index,
-                                              inTagArray: _tags,
-                                              withInitialStructure: _structureData)
-                _structureData = result.structure
-                if result.hadToRebuildFromScratch {
+                let hadToRebuildFromScratch = delegate.changed(numberOfTags: tagChange.tagChangeCount,
+                                                               atIndex: tagChange.index,
+                                                               inTagArray: tagArray,
+                                                               updatingStructure: &_structureData)
+                if hadToRebuildFromScratch {
                     // we can early exit since we've already done a full rebuild
                     return
                 }
             }
         case .dirtyRequiresRebuild:
-            _structureData = delegate.rebuild(usingTagArray: _tags)
+            _structureData = delegate.rebuild(usingTagArray: tagArray)
         }
     }
     
@@ -203,6 +287,19 @@ public protocol PlaylistStructureDelegate: class {
      */
     func isTagStructural(_ tag: PlaylistTag) -> Bool
     
+    /**
+     Return true if a `transform` that changed `oldTag` into `newTag` means the structure must be rebuilt.
+     
+     The default implementation returns true if either tag is structural and the tag has changed, or if
+     the scope of the tag has changed.
+     
+     - parameter from: The tag before the transform
+     - parameter to: The tag after the transform
+     
+     - returns: True if the structure must be rebuilt.
+     */
+    func isStructuralChange(from oldTag: PlaylistTag, to newTag: PlaylistTag) -> Bool
+    
     /**
      `PlaylistStructureCore` has determined that the structure has changed so much that a
      complete rebuild is required.
@@ -228,6 +325,51 @@ public protocol PlaylistStructureDelegate: class {
                  atIndex index: Int,
                  inTagArray tags: [PlaylistTag],
                  withInitialStructure structure: StructureType) -> PlaylistStructureChangeResult<StructureType>
+    
+    /**
+     `PlaylistStructureCore` has noted a minor change to the tag array and requests that
+     we update the structure in place.
+     
+     Implement this if your structure can be updated without copying it. The default
+     implementation calls `changed(numberOfTags:atIndex:inTagArray:withInitialStructure:)`.
+     
+     - parameter numberOfTags: The number of tags added or deleted at our index point. Will be negative for deleted tags.
+     - parameter atIndex: The insertion or deletion point.
+     - parameter inTagArray: The list of tags that defines our playlist. This may be O(n) to evaluate, so only do so if needed.
+     - parameter updatingStructure: The existing structure to be updated.
+     
+     - returns: `false` if we were able to fix up ourselves, `true` if we had to rebuild structure from scratch
+     */
+    func changed(numberOfTags alterCount: Int,
+                 atIndex index: Int,
+                 inTagArray tags: @autoclosure () -> [PlaylistTag],
+                 updatingStructure structure: inout StructureType) -> Bool
+}
+
+extension PlaylistStructureDelegate {
+    
+    public func isStructuralChange(from oldTag: PlaylistTag, to newTag: PlaylistTag) -> Bool {
+        return tagChangeAffectsStructure(from: oldTag, to: newTag)
+    }
+    
+    /// The default `isStructuralChange(from:to:)`, for delegates that only special case some tags
+    func tagChangeAffectsStructure(from oldTag: PlaylistTag, to newTag: PlaylistTag) -> Bool {
+        guard isTagStructural(oldTag) || isTagStructural(newTag) else {
+            // the header and footer end at the first and last `.mediaSegment` tags
+            return oldTag.scope() != newTag.scope()
+        }
+        // tag equality does not cover edited values or durations
+        return oldTag != newTag || newTag.isDirty || oldTag.duration != newTag.duration
+    }
+    
+    public func changed(numberOfTags alterCount: Int,
+                        atIndex index: Int,
+                        inTagArray tags: @autoclosure () -> [PlaylistTag],
+                        updatingStructure structure: inout StructureType) -> Bool {
+        let result = changed(numberOfTags: alterCount, atIndex: index, inTagArray: tags(), withInitialStructure: structure)
+        structure = result.structure
+        return result.hadToRebuildFromScratch
+    }
 }
 
 public struct PlaylistStructureChangeResult<StructureType> {
@@ -455,4 +597,19 @@ struct PlaylistStructureConstructor {
 
 public protocol PlaylistStructure {
     init()
+    
+    /**
+     Returns this structure with anything it builds lazily already built, so that reading it takes no lock
+     and does not change it. Used by `PlaylistStructureCore.frozen()`.
+     
+     The default implementation returns `self`.
+     */
+    func frozen() -> Self
+}
+
+extension PlaylistStructure {
+    
+    public func frozen() -> Self {
+        return self
+    }
 }
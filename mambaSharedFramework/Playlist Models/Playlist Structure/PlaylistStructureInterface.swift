@@ -34,6 +34,11 @@ public protocol PlaylistStructureInterface: class {
      */
     var tags: [PlaylistTag] { get }
     
+    /**
+     The same tags as `tags`, read without building an `Array`.
+     */
+    var tagCollection: PlaylistTagCollection { get }
+    
     /**
      Insert a single tag.
      
@@ -73,4 +78,36 @@ public protocol PlaylistStructureInterface: class {
      - parameter: The mapping closure to use during the map.
      */
     func transform(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws
+    
+    /**
+     Perform a map on every tag in the tags array, as `transform` does, splitting the tags between threads.
+     
+     - parameter: The mapping closure to use during the map. It must be safe to call from any thread.
+     */
+    func transformConcurrently(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws
+}
+
+extension PlaylistStructureInterface {
+    
+    public func transformConcurrently(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws {
+        try transform(mapping)
+    }
+    
+    public var tagCollection: PlaylistTagCollection {
+        return PlaylistTagCollection(tags)
+    }
+}
+
+/**
+ A `PlaylistStructureInterface` that can make an immutable copy of itself. `PlaylistCore.frozen()` requires this.
+ */
+public protocol FreezablePlaylistStructure: PlaylistStructureInterface {
+    
+    associatedtype FrozenStructureType: PlaylistTagSource
+    
+    /// Returns a fully built, immutable copy of this structure, which any number of threads may read without locking.
+    func frozen() -> FrozenStructureType
+    
+    /// Creates an editable structure from a frozen one.
+    init(withFrozenStructure structure: FrozenStructureType)
 }
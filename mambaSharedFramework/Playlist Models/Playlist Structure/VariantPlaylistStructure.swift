@@ -77,6 +77,15 @@ extension PlaylistStructureCore: PlaylistTagSource, PlaylistTypeDetermination, V
     public var playlistType: PlaylistType { return structureData.playlistType }
 }
 
+extension FrozenPlaylistStructure: PlaylistTypeDetermination, VariantPlaylistStructureInterface where PSD == VariantPlaylistStructureDelegate {
+    
+    public var header: PlaylistTagGroup? { return structureData.header }
+    public var mediaSegmentGroups: [MediaSegmentPlaylistTagGroup] { return structureData.mediaSegmentGroups }
+    public var footer: PlaylistTagGroup? { return structureData.footer }
+    public var mediaSpans: [PlaylistTagSpan] { return structureData.mediaSpans }
+    public var playlistType: PlaylistType { return structureData.playlistType }
+}
+
 public protocol VariantPlaylistStructureInterface: PlaylistTagSource, PlaylistTypeDetermination {
     /**
      The `header` is all tags that describe the playlist initially. All `PlaylistTag`s at the top of the playlist that
@@ -145,15 +154,16 @@ extension VariantPlaylistStructureInterface {
     public func mediaSegmentGroups<T:Sequence>(containingTagsNamed tagNames: T) -> [MediaSegmentPlaylistTagGroup]
         where T.Iterator.Element == MambaStringRef
     {
-        let queryTagNameSet = Set(tagNames)
+        let queryTagNameSet = Set(tagNames.map { PlaylistTagString.stringRef($0) })
         
         var results = [MediaSegmentPlaylistTagGroup]()
+        let tags = tagCollection
         
         for group in mediaSegmentGroups {
             #if swift(>=4.1)
-            let tagNames: Set<MambaStringRef> = Set(tags[group.range].compactMap { $0.tagName })
+            let tagNames: Set<PlaylistTagString> = Set(tags[group.range].compactMap { $0.tagNameString })
             #else
-            let tagNames: Set<MambaStringRef> = Set(tags[group.range].flatMap { $0.tagName })
+            let tagNames: Set<PlaylistTagString> = Set(tags[group.range].flatMap { $0.tagNameString })
             #endif
             
             if queryTagNameSet.intersection(tagNames).count > 0 {
@@ -164,35 +174,35 @@ extension VariantPlaylistStructureInterface {
     }
     
     /**
-     Grab a ArraySlice representing the given PlaylistTag Group.
+     Grab a PlaylistTagCollection representing the given PlaylistTag Group.
      
      - parameter forMediaGroupIndex: The index of the media group used for the tag selection.
      
-     - returns: An ArraySlice of the tags in the given media group.
+     - returns: A PlaylistTagCollection of the tags in the given media group.
      */
-    public func tags(forMediaGroupIndex index: Int) -> ArraySlice<PlaylistTag> {
+    public func tags(forMediaGroupIndex index: Int) -> PlaylistTagCollection {
         guard let range = mediaSegmentGroups[safe: index]?.range else {
-            return ArraySlice<PlaylistTag>()
+            return PlaylistTagCollection([])
         }
-        return tags[range]
+        return tagCollection[range]
     }
 }
 
 public struct MediaPlaylistStructureData: PlaylistStructure, PlaylistTypeDetermination {
     public init() {
-        self.header = nil
-        self.mediaSegmentGroups = [MediaSegmentPlaylistTagGroup]()
-        self.footer = nil
-        self.mediaSpans = [PlaylistTagSpan]()
-        self.playlistType = .live
+        self.init(header: nil,
+                  mediaSegmentGroups: [MediaSegmentPlaylistTagGroup](),
+                  footer: nil,
+                  mediaSpans: [PlaylistTagSpan](),
+                  playlistType: .live)
     }
     /// Use this constructor if we are unable to figure out structure
     public init(tags: [PlaylistTag]) {
-        self.header = PlaylistTagGroup(range: tags.startIndex...(tags.endIndex - 1))
-        self.mediaSegmentGroups = [MediaSegmentPlaylistTagGroup]()
-        self.footer = nil
-        self.mediaSpans = [PlaylistTagSpan]()
-        self.playlistType = _playlistType(fromTags: tags)
+        self.init(header: PlaylistTagGroup(range: tags.startIndex...(tags.endIndex - 1)),
+                  mediaSegmentGroups: [MediaSegmentPlaylistTagGroup](),
+                  footer: nil,
+                  mediaSpans: [PlaylistTagSpan](),
+                  playlistType: _playlistType(fromTags: tags))
     }
     public init(header: PlaylistTagGroup?,
                 mediaSegmentGroups: [MediaSegmentPlaylistTagGroup],
@@ -200,16 +210,400 @@ public struct MediaPlaylistStructureData: PlaylistStructure, PlaylistTypeDetermi
                 mediaSpans: [PlaylistTagSpan],
                 playlistType: PlaylistType) {
         self.header = header
-        self.mediaSegmentGroups = mediaSegmentGroups
+        self.builtMediaSegmentGroups = mediaSegmentGroups
+        self.mediaSegmentGroupTagRanges = MediaSegmentGroupTagRanges(mediaSegmentGroups: mediaSegmentGroups)
+        self.mediaSegmentGroupsCache = MediaSegmentGroupsCache(mediaSegmentGroups: nil)
+        self.timelineIndex = MediaSegmentTimelineIndex(mediaSegmentGroups: mediaSegmentGroups)
         self.footer = footer
         self.mediaSpans = mediaSpans
         self.playlistType = playlistType
     }
     var header: PlaylistTagGroup?
-    var mediaSegmentGroups: [MediaSegmentPlaylistTagGroup]
+    /// The media segment groups. After tags are inserted or deleted, this is rebuilt the first time it is read.
+    var mediaSegmentGroups: [MediaSegmentPlaylistTagGroup] {
+        guard haveMovedTagRanges, let tagRanges = mediaSegmentGroupTagRanges else {
+            // nothing to build, so no lock either
+            return builtMediaSegmentGroups
+        }
+        let builtMediaSegmentGroups = self.builtMediaSegmentGroups
+        return mediaSegmentGroupsCache.mediaSegmentGroups {
+            var mediaSegmentGroups = builtMediaSegmentGroups
+            for (groupIndex, range) in tagRanges.ranges.enumerated() {
+                mediaSegmentGroups[groupIndex].range = range
+            }
+            return mediaSegmentGroups
+        }
+    }
     var footer: PlaylistTagGroup?
     var mediaSpans: [PlaylistTagSpan]
     public var playlistType: PlaylistType
+    
+    // The media segment groups as they were built. Inserting and deleting tags only moves their tag ranges, which we
+    // keep in `mediaSegmentGroupTagRanges` if the groups are contiguous, and otherwise update in these groups.
+    private var builtMediaSegmentGroups: [MediaSegmentPlaylistTagGroup]
+    private var mediaSegmentGroupTagRanges: MediaSegmentGroupTagRanges?
+    private var mediaSegmentGroupsCache: MediaSegmentGroupsCache
+    // `true` once `mediaSegmentGroupTagRanges` no longer matches `builtMediaSegmentGroups`
+    private var haveMovedTagRanges = false
+    
+    // lookup tables for `mediaSegmentGroups`, rebuilt on every `rebuild`. Times and media sequences are not changed by
+    // inserting and deleting tags, and we only use `startIndexes` if there is no `mediaSegmentGroupTagRanges`.
+    private(set) var timelineIndex: MediaSegmentTimelineIndex
+    
+    /// The number of media segment groups
+    var mediaSegmentGroupCount: Int {
+        return builtMediaSegmentGroups.count
+    }
+    
+    /// Returns `mediaSegmentGroups[groupIndex]` without building `mediaSegmentGroups`
+    func mediaSegmentGroup(at groupIndex: Int) -> MediaSegmentPlaylistTagGroup {
+        var group = builtMediaSegmentGroups[groupIndex]
+        if let tagRanges = mediaSegmentGroupTagRanges {
+            group.range = tagRanges.range(ofGroupAt: groupIndex)
+        }
+        return group
+    }
+    
+    /// Returns the index into `mediaSegmentGroups` of the first group that contains `time`
+    func mediaSegmentGroupIndex(forTime time: CMTime) -> Int? {
+        guard timelineIndex.hasOrderedTimes else {
+            return builtMediaSegmentGroups.firstIndex(where: { $0.timeRange.containsTime(time) })
+        }
+        // the groups are in time order and do not overlap, so only the first group that ends after `time` can contain it
+        let index = timelineIndex.endTimes.partitioningIndex(where: { CMTimeCompare($0, time) > 0 })
+        guard index < builtMediaSegmentGroups.endIndex, builtMediaSegmentGroups[index].timeRange.containsTime(time) else {
+            return nil
+        }
+        return index
+    }
+    
+    /// Returns the index into `mediaSegmentGroups` of the first group that contains `tagIndex`
+    func mediaSegmentGroupIndex(forTagIndex tagIndex: Int) -> Int? {
+        if let tagRanges = mediaSegmentGroupTagRanges {
+            return tagRanges.groupIndex(containingTagIndex: tagIndex)
+        }
+        guard timelineIndex.hasOrderedTagIndexes else {
+            return builtMediaSegmentGroups.firstIndex(where: { $0.startIndex <= tagIndex && $0.endIndex >= tagIndex })
+        }
+        // the groups are in tag order and do not overlap, so only the last group that starts at or before `tagIndex` can contain it
+        let index = timelineIndex.startIndexes.partitioningIndex(where: { $0 > tagIndex }) - 1
+        guard index >= 0, builtMediaSegmentGroups[index].endIndex >= tagIndex else {
+            return nil
+        }
+        return index
+    }
+    
+    /// Returns the index into `mediaSegmentGroups` of the first group with `mediaSequence`
+    func mediaSegmentGroupIndex(forMediaSequence mediaSequence: MediaSequence) -> Int? {
+        guard let firstMediaSequence = timelineIndex.firstConsecutiveMediaSequence else {
+            return builtMediaSegmentGroups.firstIndex(where: { $0.mediaSequence == mediaSequence })
+        }
+        let (index, overflow) = mediaSequence.subtractingReportingOverflow(firstMediaSequence)
+        return !overflow && builtMediaSegmentGroups.indices.contains(index) ? index : nil
+    }
+    
+    /// The media segment group that contains `time`, or the last group if `time` is its end time
+    func mediaSegmentGroup(forTime time: CMTime) -> MediaSegmentPlaylistTagGroup? {
+        guard let index = mediaSegmentGroupIndex(forTime: time) else {
+            // if we ask for a time that is our playlist's end time, we should return the last segment
+            if mediaSegmentGroupCount > 0 {
+                let lastGroup = mediaSegmentGroup(at: mediaSegmentGroupCount - 1)
+                if CMTimeCompare(lastGroup.timeRange.end, time) == 0 {
+                    return lastGroup
+                }
+            }
+            return nil
+        }
+        return mediaSegmentGroup(at: index)
+    }
+    
+    func mediaSegmentGroup(forTagIndex tagIndex: Int) -> MediaSegmentPlaylistTagGroup? {
+        guard let index = mediaSegmentGroupIndex(forTagIndex: tagIndex) else { return nil }
+        return mediaSegmentGroup(at: index)
+    }
+    
+    func mediaSegmentGroup(forMediaSequence mediaSequence: MediaSequence) -> MediaSegmentPlaylistTagGroup? {
+        guard let index = mediaSegmentGroupIndex(forMediaSequence: mediaSequence) else { return nil }
+        return mediaSegmentGroup(at: index)
+    }
+    
+    /// Rebuilds us from `mediaSegmentGroups` if tags have been inserted or deleted, and parses the values of our span tags
+    public func frozen() -> MediaPlaylistStructureData {
+        let mediaSpans = self.mediaSpans.map { PlaylistTagSpan(parentTag: $0.parentTag.resolvingDeferredValues(), tagMediaSpan: $0.tagMediaSpan) }
+        guard haveMovedTagRanges else {
+            var structure = self
+            structure.mediaSpans = mediaSpans
+            return structure
+        }
+        return MediaPlaylistStructureData(header: header,
+                                          mediaSegmentGroups: mediaSegmentGroups,
+                                          footer: footer,
+                                          mediaSpans: mediaSpans,
+                                          playlistType: playlistType)
+    }
+    
+    /**
+     Moves the header, media segment groups and footer for `alterCount` non-structural tags inserted (or deleted,
+     if negative) at `index`. No group is added or removed, so `mediaSpans` and the groups' times and media
+     sequences do not change.
+     
+     This is O(log n) in the number of media segment groups, as long as the groups are contiguous (which they
+     are when we build them).
+     
+     Only tag ranges are kept in the tree. Structural inserts and deletes (segment locations, `EXTINF`s and other
+     tags that `VariantPlaylistStructureDelegate.isTagStructural(_:)` reports) add, remove or retime groups, so they
+     never come here and the structure is rebuilt in O(n) instead. Group times are stored in each group rather than
+     as running totals in the tree, so they cannot be moved in O(log n) either.
+     
+     - returns: `false` if the tags were deleted out of the end of the header, a group or the footer, in which case
+     the structure must be rebuilt.
+     */
+    mutating func moveTagRanges(forChangedNumberOfTags alterCount: Int, atIndex index: Int) -> Bool {
+        
+        var foundChangePoint = false
+        
+        // is the change in the header?
+        if var header = header, header.range.contains(index) {
+            if alterCount < 0 && !header.range.contains(index - alterCount) {
+                // deleted out of the header
+                return false
+            }
+            header.range = header.startIndex...(header.endIndex + alterCount)
+            self.header = header
+            foundChangePoint = true
+        }
+        
+        // is the change in one of the media groups?
+        if mediaSegmentGroupTagRanges != nil {
+            // mutated in place through the optional, so that we do not copy the tree
+            guard mediaSegmentGroupTagRanges?.moveTagRanges(forChangedNumberOfTags: alterCount,
+                                                            atIndex: index,
+                                                            foundChangePoint: &foundChangePoint) == true else {
+                // deleted out of the group
+                return false
+            }
+            mediaSegmentGroupsCache = MediaSegmentGroupsCache(mediaSegmentGroups: nil)
+            haveMovedTagRanges = true
+        }
+        else {
+            for groupIndex in builtMediaSegmentGroups.indices {
+                let range = builtMediaSegmentGroups[groupIndex].range
+                if foundChangePoint {
+                    builtMediaSegmentGroups[groupIndex].range = (range.lowerBound + alterCount)...(range.upperBound + alterCount)
+                }
+                else if alterCount < 0 && range.contains(index) && !range.contains(index - alterCount) {
+                    // deleted out of the group
+                    return false
+                }
+                else if range.contains(index) {
+                    foundChangePoint = true
+                    builtMediaSegmentGroups[groupIndex].range = range.lowerBound...(range.upperBound + alterCount)
+                }
+            }
+            timelineIndex = MediaSegmentTimelineIndex(mediaSegmentGroups: builtMediaSegmentGroups)
+        }
+        
+        // is the change in the footer?
+        if var footer = footer {
+            if foundChangePoint {
+                footer.range = (footer.startIndex + alterCount)...(footer.endIndex + alterCount)
+            }
+            else if alterCount < 0
+                && footer.range.contains(index)
+                && !footer.range.contains(index - alterCount) {
+                // deleted out of the footer
+                return false
+            }
+            else if footer.range.contains(index) {
+                footer.range = footer.startIndex...(footer.endIndex + alterCount)
+            }
+            self.footer = footer
+        }
+        
+        return true
+    }
+}
+
+/**
+ Lookup tables that let us find a media segment group by time, tag index or media sequence without scanning
+ every group. The parser always builds groups that are in order, but `MediaPlaylistStructureData` can be
+ constructed with any groups, so we note which tables can be searched and fall back to a linear search otherwise.
+ */
+struct MediaSegmentTimelineIndex {
+    
+    /// The end time of each media segment group
+    let endTimes: [CMTime]
+    
+    /// The first tag index of each media segment group
+    let startIndexes: [Int]
+    
+    /// `true` if each group starts at or after the end of the previous group and has a positive duration, so `endTimes` is sorted
+    let hasOrderedTimes: Bool
+    
+    /// `true` if each group starts after the end of the previous group, so `startIndexes` is sorted
+    let hasOrderedTagIndexes: Bool
+    
+    /// The media sequence of the first group, if each group's media sequence is one more than the previous group's
+    let firstConsecutiveMediaSequence: MediaSequence?
+    
+    init(mediaSegmentGroups: [MediaSegmentPlaylistTagGroup]) {
+        
+        var endTimes = [CMTime]()
+        endTimes.reserveCapacity(mediaSegmentGroups.count)
+        var startIndexes = [Int]()
+        startIndexes.reserveCapacity(mediaSegmentGroups.count)
+        var hasOrderedTimes = true
+        var hasOrderedTagIndexes = true
+        var hasConsecutiveMediaSequences = true
+        
+        var previousGroup: MediaSegmentPlaylistTagGroup? = nil
+        for group in mediaSegmentGroups {
+            let timeRange = group.timeRange
+            if !(timeRange.isValid && timeRange.start.isNumeric && timeRange.duration.isNumeric && CMTimeCompare(timeRange.duration, CMTime.zero) > 0) {
+                hasOrderedTimes = false
+            }
+            if let previousGroup = previousGroup {
+                if hasOrderedTimes && CMTimeCompare(timeRange.start, previousGroup.timeRange.end) < 0 {
+                    hasOrderedTimes = false
+                }
+                if group.startIndex <= previousGroup.endIndex {
+                    hasOrderedTagIndexes = false
+                }
+                if group.mediaSequence != previousGroup.mediaSequence &+ 1 {
+                    hasConsecutiveMediaSequences = false
+                }
+            }
+            endTimes.append(timeRange.end)
+            startIndexes.append(group.startIndex)
+            previousGroup = group
+        }
+        
+        self.endTimes = endTimes
+        self.startIndexes = startIndexes
+        self.hasOrderedTimes = hasOrderedTimes
+        self.hasOrderedTagIndexes = hasOrderedTagIndexes
+        self.firstConsecutiveMediaSequence = hasConsecutiveMediaSequences ? mediaSegmentGroups.first?.mediaSequence : nil
+    }
+}
+
+/**
+ The tag ranges of a run of contiguous media segment groups, kept as the first tag index and a `FenwickTree`
+ of the group lengths. Finding a group's range, finding the group containing a tag, and growing or shrinking
+ a group (which moves every group after it) are all O(log n).
+ 
+ Adding or removing a group is not supported. That takes a structural edit, which rebuilds the structure.
+ */
+struct MediaSegmentGroupTagRanges {
+    
+    /// The first tag index of the first group
+    private(set) var startIndex: Int
+    
+    private var lengths: FenwickTree
+    
+    /// Fails if there are no groups, or if each group does not start right after the previous group.
+    init?(mediaSegmentGroups: [MediaSegmentPlaylistTagGroup]) {
+        guard let firstGroup = mediaSegmentGroups.first else {
+            return nil
+        }
+        var lengths = [Int]()
+        lengths.reserveCapacity(mediaSegmentGroups.count)
+        var nextStartIndex = firstGroup.startIndex
+        for group in mediaSegmentGroups {
+            guard group.startIndex == nextStartIndex else {
+                return nil
+            }
+            lengths.append(group.range.count)
+            nextStartIndex = group.endIndex + 1
+        }
+        self.startIndex = firstGroup.startIndex
+        self.lengths = FenwickTree(lengths)
+    }
+    
+    /// The tag range of each group, in O(n)
+    var ranges: [PlaylistTagIndexRange] {
+        var ranges = [PlaylistTagIndexRange]()
+        ranges.reserveCapacity(lengths.count)
+        var groupStartIndex = startIndex
+        for length in lengths.elements {
+            ranges.append(groupStartIndex...(groupStartIndex + length - 1))
+            groupStartIndex += length
+        }
+        return ranges
+    }
+    
+    func range(ofGroupAt groupIndex: Int) -> PlaylistTagIndexRange {
+        let groupStartIndex = startIndex + lengths.prefixSum(groupIndex)
+        let nextGroupStartIndex = startIndex + lengths.prefixSum(groupIndex + 1)
+        return groupStartIndex...(nextGroupStartIndex - 1)
+    }
+    
+    func groupIndex(containingTagIndex tagIndex: Int) -> Int? {
+        guard tagIndex >= startIndex else {
+            return nil
+        }
+        // every group has at least one tag, so the groups before ours are the longest run that ends at or before `tagIndex`
+        let groupIndex = lengths.prefixCount(withSumNotExceeding: tagIndex - startIndex)
+        return groupIndex < lengths.count ? groupIndex : nil
+    }
+    
+    /**
+     The media segment group part of `MediaPlaylistStructureData.moveTagRanges(forChangedNumberOfTags:atIndex:)`.
+     
+     If `foundChangePoint` is already `true`, the change was before the groups and they all move. Otherwise it is
+     set to `true` if the change was in one of the groups.
+     
+     - returns: `false` if the tags were deleted out of the end of a group
+     */
+    mutating func moveTagRanges(forChangedNumberOfTags alterCount: Int, atIndex index: Int, foundChangePoint: inout Bool) -> Bool {
+        if foundChangePoint {
+            startIndex += alterCount
+            return true
+        }
+        guard let groupIndex = groupIndex(containingTagIndex: index) else {
+            return true
+        }
+        if alterCount < 0 && !range(ofGroupAt: groupIndex).contains(index - alterCount) {
+            return false
+        }
+        lengths.add(alterCount, at: groupIndex)
+        foundChangePoint = true
+        return true
+    }
+}
+
+/**
+ `MediaPlaylistStructureData.mediaSegmentGroups`, built the first time it is read after tags are inserted or deleted.
+ 
+ Structure data is read from many threads, so the groups are guarded by a lock, as in `DeferredPlaylistTagValues`.
+ Each cache has its own lock. The groups are built outside the lock.
+ */
+private final class MediaSegmentGroupsCache {
+    
+    private var _mediaSegmentGroups: [MediaSegmentPlaylistTagGroup]?
+    
+    private let lock = NSLock()
+    
+    init(mediaSegmentGroups: [MediaSegmentPlaylistTagGroup]?) {
+        self._mediaSegmentGroups = mediaSegmentGroups
+    }
+    
+    func mediaSegmentGroups(orBuild build: () -> [MediaSegmentPlaylistTagGroup]) -> [MediaSegmentPlaylistTagGroup] {
+        lock.lock()
+        let cachedMediaSegmentGroups = _mediaSegmentGroups
+        lock.unlock()
+        
+        if let cachedMediaSegmentGroups = cachedMediaSegmentGroups {
+            return cachedMediaSegmentGroups
+        }
+        
+        let mediaSegmentGroups = build()
+        
+        lock.lock()
+        _mediaSegmentGroups = mediaSegmentGroups
+        lock.unlock()
+        
+        return mediaSegmentGroups
+    }
 }
 
 public final class VariantPlaylistStructureDelegate: PlaylistStructureDelegate {
@@ -226,6 +620,18 @@ public final class VariantPlaylistStructureDelegate: PlaylistStructureDelegate {
             tag.tagDescriptor == PantosTag.EXT_X_DISCONTINUITY
     }
     
+    public func isStructuralChange(from oldTag: PlaylistTag, to newTag: PlaylistTag) -> Bool {
+        if oldTag.tagDescriptor == PantosTag.Location && newTag.tagDescriptor == PantosTag.Location {
+            // only where the segment URLs are matters to the structure, so rewriting them keeps it
+            return false
+        }
+        if decidesPlaylistType(oldTag) || decidesPlaylistType(newTag) {
+            // a transform does not go through `changed`, so a rebuild is how we find `playlistType` again
+            return oldTag != newTag || newTag.isDirty
+        }
+        return tagChangeAffectsStructure(from: oldTag, to: newTag)
+    }
+    
     public func rebuild(usingTagArray tags: [PlaylistTag]) -> MediaPlaylistStructureData {
         do {
             let constructor = PlaylistStructureConstructor(withTagDescriptorForMediaGroupBoundaries: PantosTag.EXTINF)
@@ -252,84 +658,29 @@ public final class VariantPlaylistStructureDelegate: PlaylistStructureDelegate {
                         atIndex index: Int,
                         inTagArray tags: [PlaylistTag],
                         withInitialStructure structure: MediaPlaylistStructureData) -> PlaylistStructureChangeResult<MediaPlaylistStructureData> {
+        var structure = structure
+        let hadToRebuildFromScratch = changed(numberOfTags: alterCount, atIndex: index, inTagArray: tags, updatingStructure: &structure)
+        return PlaylistStructureChangeResult<MediaPlaylistStructureData>(hadToRebuildFromScratch: hadToRebuildFromScratch, structure: structure)
+    }
+    
+    public func changed(numberOfTags alterCount: Int,
+                        atIndex index: Int,
+                        inTagArray tags: @autoclosure () -> [PlaylistTag],
+                        updatingStructure structure: inout MediaPlaylistStructureData) -> Bool {
         
-        // Fix up groups
-        
-        var foundChangePoint = false
-        
-        var calc_header: PlaylistTagGroup? = nil
-        var calc_mediaSegmentGroups = structure.mediaSegmentGroups
-        var calc_footer: PlaylistTagGroup? = nil
-
-        // is the insert in the header?
-        if var header = structure.header {
-            if header.range.contains(index) {
-                if alterCount < 0 && !header.range.contains(index - alterCount) {
-                    // deleted out of the header
-                    let structure = rebuild(usingTagArray: tags)
-                    return PlaylistStructureChangeResult<MediaPlaylistStructureData>(hadToRebuildFromScratch: true, structure: structure)
-                }
-                header.range = header.startIndex...(header.endIndex + alterCount)
-                foundChangePoint = true
-            }
-            calc_header = header
-        }
-        
-        // is the insert in one of the media groups?
-        for (groupIndex, _) in structure.mediaSegmentGroups.enumerated() {
-            if foundChangePoint {
-                calc_mediaSegmentGroups[groupIndex].range = (calc_mediaSegmentGroups[groupIndex].startIndex + alterCount)...(calc_mediaSegmentGroups[groupIndex].endIndex + alterCount)
-            }
-            else if alterCount < 0
-                && calc_mediaSegmentGroups[groupIndex].range.contains(index)
-                && !calc_mediaSegmentGroups[groupIndex].range.contains(index - alterCount) {
-                // deleted out of the group
-                let structure = rebuild(usingTagArray: tags)
-                return PlaylistStructureChangeResult<MediaPlaylistStructureData>(hadToRebuildFromScratch: true, structure: structure)
-            }
-            else if calc_mediaSegmentGroups[groupIndex].range.contains(index) {
-                foundChangePoint = true
-                calc_mediaSegmentGroups[groupIndex].range = calc_mediaSegmentGroups[groupIndex].startIndex...(calc_mediaSegmentGroups[groupIndex].endIndex + alterCount)
-            }
-        }
-        
-        // is the insert in the footer?
-        if var footer = structure.footer {
-            if foundChangePoint {
-                footer.range = (footer.startIndex + alterCount)...(footer.endIndex + alterCount)
-            }
-            else if alterCount < 0
-                && footer.range.contains(index)
-                && !footer.range.contains(index - alterCount) {
-                // deleted out of the footer
-                let structure = rebuild(usingTagArray: tags)
-                return PlaylistStructureChangeResult<MediaPlaylistStructureData>(hadToRebuildFromScratch: true, structure: structure)
-            }
-            else if footer.range.contains(index) {
-                footer.range = footer.startIndex...(footer.endIndex + alterCount)
-            }
-            calc_footer = footer
-        }
-        
-        let mediaSpans: [PlaylistTagSpan]
-        do {
-            mediaSpans = try PlaylistStructureConstructor.generateMediaSpans(fromTags: tags,
-                                                                             header: calc_header,
-                                                                             mediaSegmentGroups: calc_mediaSegmentGroups)
-        }
-        catch {
-            mediaSpans = [PlaylistTagSpan]()
+        // The changed tags are not structural, so only tag ranges move. The media spans are in terms of
+        // media segment groups, so they do not change.
+        guard structure.moveTagRanges(forChangedNumberOfTags: alterCount, atIndex: index) else {
+            structure = rebuild(usingTagArray: tags())
+            return true
         }
-        
-        let playlistType = _playlistType(fromTags: tags)
-
-        return PlaylistStructureChangeResult<MediaPlaylistStructureData>(hadToRebuildFromScratch: false,
-                                                                         structure: MediaPlaylistStructureData(header: calc_header,
-                                                                                                               mediaSegmentGroups: calc_mediaSegmentGroups,
-                                                                                                               footer: calc_footer,
-                                                                                                               mediaSpans: mediaSpans,
-                                                                                                               playlistType: playlistType))
-        
+        // the changed tags may have been an EXT-X-PLAYLIST-TYPE or an EXT-X-ENDLIST
+        structure.playlistType = _playlistType(fromTags: tags())
+        return false
+    }
+    
+    private func decidesPlaylistType(_ tag: PlaylistTag) -> Bool {
+        return tag.tagDescriptor == PantosTag.EXT_X_PLAYLIST_TYPE || tag.tagDescriptor == PantosTag.EXT_X_ENDLIST
     }
 }
 
@@ -44,6 +44,11 @@ public struct PlaylistCore<PT>: PlaylistInterface, CustomDebugStringConvertible
     public var tags: [PlaylistTag] {
         return structure.tags
     }
+    
+    /// The `PlaylistTag`s in this playlist, read without building an `Array`.
+    public var tagCollection: PlaylistTagCollection {
+        return structure.tagCollection
+    }
         
     /// custom playlist data
     public var customData: PT.customPlaylistDataType
@@ -119,7 +124,29 @@ public struct PlaylistCore<PT>: PlaylistInterface, CustomDebugStringConvertible
     public mutating func transform(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws {
         try mutatingStructure.transform(mapping)
     }
+    
+    /**
+     Perform a map on every tag in the tags array, splitting the tags between threads. Use this rather
+     than `transform` when the mapping is expensive, such as signing every segment URL.
+     
+     - parameter: The mapping closure to use during the map. It must be safe to call from any thread.
+     If it throws, the tags are left unchanged.
+     */
+    public mutating func transformConcurrently(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws {
+        try mutatingStructure.transformConcurrently(mapping)
+    }
             
+    /**
+     Parses the values of every tag whose values have not been parsed yet, and throws the first error found.
+     
+     Only needed for playlists from a `PlaylistParser` with `deferTagValueParsing` set. See `PlaylistTag.validateParsedValues()`.
+     */
+    public func validateParsedTagValues() throws {
+        for tag in tagCollection {
+            try tag.validateParsedValues()
+        }
+    }
+    
     private var mutatingStructure: PT.playlistStructureType {
         mutating get {
             if !isKnownUniquelyReferenced(&structure) {
@@ -143,14 +170,14 @@ public struct PlaylistCore<PT>: PlaylistInterface, CustomDebugStringConvertible
     }
     
     /**
-     Grab a ArraySlice representing the given PlaylistTag Group.
+     Grab a PlaylistTagCollection representing the given PlaylistTag Group.
      
      - parameter forMediaGroup: The media group that is used for the tag selection.
      
-     - returns: An ArraySlice of the tags in the given media group.
+     - returns: A PlaylistTagCollection of the tags in the given media group.
      */
-    public func tags(forMediaGroup group: PlaylistTagGroupProtocol) -> ArraySlice<PlaylistTag> {
-        return tags[group.range]
+    public func tags(forMediaGroup group: PlaylistTagGroupProtocol) -> PlaylistTagCollection {
+        return tagCollection[group.range]
     }
 
     /**
@@ -165,3 +192,28 @@ public struct PlaylistCore<PT>: PlaylistInterface, CustomDebugStringConvertible
         return try writer.write(playlist: self)
     }
 }
+
+extension PlaylistCore: PlaylistMemoryStorageSource {}
+
+extension PlaylistCore where PT.playlistStructureType: FreezablePlaylistStructure {
+    
+    /**
+     Returns an immutable snapshot of this playlist that any number of threads may read without locking.
+     
+     This builds the structure if required and parses any tag values that have not been parsed yet, so it is O(n).
+     */
+    public func frozen() -> FrozenPlaylist<PT> {
+        return FrozenPlaylist(customData: customData,
+                              playlistMemoryStorage: playlistMemoryStorage,
+                              registeredPlaylistTags: registeredPlaylistTags,
+                              structure: structure.frozen())
+    }
+    
+    /// Initializes an editable PlaylistCore from a frozen playlist, keeping its structure
+    public init(_ frozenPlaylist: FrozenPlaylist<PT>) {
+        self.registeredPlaylistTags = frozenPlaylist.registeredPlaylistTags
+        self.structure = PT.playlistStructureType(withFrozenStructure: frozenPlaylist.structure)
+        self.customData = frozenPlaylist.customData
+        self.playlistMemoryStorage = frozenPlaylist.playlistMemoryStorage
+    }
+}
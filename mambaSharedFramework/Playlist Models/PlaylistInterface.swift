@@ -29,7 +29,7 @@ public protocol PlaylistInterface: RegisteredPlaylistTagsProvider, PlaylistTagSo
     mutating func delete(atIndex index: Int)
     mutating func delete(atRange range: PlaylistTagIndexRange)
     mutating func transform(_ mapping: (PlaylistTag) throws -> (PlaylistTag)) throws
-    func tags(forMediaGroup group: PlaylistTagGroupProtocol) -> ArraySlice<PlaylistTag>
+    func tags(forMediaGroup group: PlaylistTagGroupProtocol) -> PlaylistTagCollection
     func write() throws -> Data
 }
 
@@ -38,4 +38,12 @@ public protocol PlaylistInterface: RegisteredPlaylistTagsProvider, PlaylistTagSo
  */
 public protocol PlaylistTagSource {
     var tags: [PlaylistTag] { get }
+    /// The same tags as `tags`, read without building an `Array`
+    var tagCollection: PlaylistTagCollection { get }
+}
+
+public extension PlaylistTagSource {
+    var tagCollection: PlaylistTagCollection {
+        return PlaylistTagCollection(tags)
+    }
 }
@@ -21,13 +21,15 @@ import Foundation
 import CoreMedia
 
 #if SWIFT_PACKAGE
+import PlaylistParserError
 import HLSObjectiveC
 #endif
 
 /**
  A struct representing a single tag line from a HLS playlist.
  
- *Important memory safety note:* This struct contains `MambaStringRef`s. Those objects
+ *Important memory safety note:* This struct contains `MambaStringRef`s (or, for parsed tags,
+ `MambaStringSpan`s, which `tagName` and `tagData` wrap in a `MambaStringRef` on demand). Those
  may contain unsafe pointers to a external `Data` object (typically this Data object
  is the one parsed by `Parser` to create a playlist containing many
  `PlaylistTag`s). If this Data is deallocted before this `PlaylistTag` is deallocated,
@@ -63,8 +65,12 @@ public struct PlaylistTag: CustomDebugStringConvertible {
      
      * When `tagDescriptor` is `PantosTag.Comment` or `PantosTag.Location`,
      this value will be nil.
+     
+     Note that for parsed tags, this creates a new `MambaStringRef` on each call.
      */
-    public let tagName: MambaStringRef?
+    public var tagName: MambaStringRef? {
+        return tagNameString?.stringRef
+    }
     
     /**
      The data associated with this tag as found in the original HLS Playlist.
@@ -82,8 +88,18 @@ public struct PlaylistTag: CustomDebugStringConvertible {
      `tagData` will be further processed into our local `parsedValues` dictionary,
      and available for reading via the `value` functions and for writing to via
      the `set` function.
+     
+     Note that for parsed tags, this creates a new `MambaStringRef` on each call.
      */
-    public let tagData: MambaStringRef
+    public var tagData: MambaStringRef {
+        return tagDataString.stringRef
+    }
+    
+    /// Storage for `tagName`. Parsed tags hold spans into the playlist data, so they need no allocation.
+    let tagNameString: PlaylistTagString?
+    
+    /// Storage for `tagData`.
+    let tagDataString: PlaylistTagString
     
     /**
      Represents the duration of a segment in a EXTINF tag.
@@ -112,12 +128,62 @@ public struct PlaylistTag: CustomDebugStringConvertible {
                 duration: CMTime = CMTime.invalid) {
         
         self.tagDescriptor = tagDescriptor
-        self.tagData = tagData
-        self.parsedValues = parsedValues
-        self.tagName = tagName
+        self.tagDataString = .stringRef(tagData)
+        self.storedParsedValues = parsedValues
+        self.tagNameString = .stringRef(tagName)
         self.duration = duration
     }
     
+    /**
+     Initializer for creating `PlaylistTag`s from spans while parsing HLS.
+     
+     - parameter tagDescriptor: An PlaylistTagDescriptor.
+     
+     - parameter tagData: The tag data.
+     
+     - parameter tagName: The tag name, or nil for tags that do not have tag names (i.e. PantosTag.Comment and PantosTag.Location)
+     
+     - parameter parsedValues: If the tag has parsedValues, enter those here. Optional.
+     
+     - parameter duration: Duration in seconds for #EXTINF tags. Optional.
+     */
+    init(tagDescriptor: PlaylistTagDescriptor,
+         tagData: PlaylistTagString,
+         tagName: PlaylistTagString?,
+         parsedValues: PlaylistTagDictionary? = nil,
+         duration: CMTime = CMTime.invalid) {
+        
+        self.tagDescriptor = tagDescriptor
+        self.tagDataString = tagData
+        self.storedParsedValues = parsedValues
+        self.tagNameString = tagName
+        self.duration = duration
+    }
+    
+    /**
+     Initializer for creating `PlaylistTag`s while parsing HLS, where the `parsedValues` are not parsed
+     until they are first needed.
+     
+     - parameter tagDescriptor: An PlaylistTagDescriptor.
+     
+     - parameter tagData: The tag data.
+     
+     - parameter tagName: The tag name.
+     
+     - parameter deferredValuesParser: The parser that will parse `tagData` into `parsedValues`.
+     */
+    init(tagDescriptor: PlaylistTagDescriptor,
+         tagData: PlaylistTagString,
+         tagName: PlaylistTagString,
+         deferredValuesParser parser: PlaylistTagParser) {
+        
+        self.tagDescriptor = tagDescriptor
+        self.tagDataString = tagData
+        self.tagNameString = tagName
+        self.duration = CMTime.invalid
+        self.deferredValues = DeferredPlaylistTagValues(tagDescriptor: tagDescriptor, tagData: tagData, parser: parser)
+    }
+    
     /**
      Initializer for creating `PlaylistTag`s while parsing HLS. Specialized for tags that do not have tag
      names (i.e. PantosTag.Comment and PantosTag.Location)
@@ -130,8 +196,8 @@ public struct PlaylistTag: CustomDebugStringConvertible {
                 tagData: MambaStringRef) {
         
         self.tagDescriptor = tagDescriptor
-        self.tagData = tagData
-        self.tagName = nil
+        self.tagDataString = .stringRef(tagData)
+        self.tagNameString = nil
         self.duration = CMTime.invalid
     }
     
@@ -151,14 +217,14 @@ public struct PlaylistTag: CustomDebugStringConvertible {
                 parsedValues: PlaylistTagDictionary? = nil) {
         
         self.tagDescriptor = tagDescriptor
-        self.tagName = MambaStringRef(descriptor: tagDescriptor)
+        self.tagNameString = .stringRef(MambaStringRef(descriptor: tagDescriptor))
         if let tagData = stringTagData {
-            self.tagData = MambaStringRef(string: tagData)
+            self.tagDataString = .stringRef(MambaStringRef(string: tagData))
         }
         else {
-            self.tagData = MambaStringRef()
+            self.tagDataString = .stringRef(MambaStringRef())
         }
-        self.parsedValues = parsedValues
+        self.storedParsedValues = parsedValues
         self.isDirty = parsedValues != nil
         self.duration = CMTime.invalid
     }
@@ -176,6 +242,46 @@ public struct PlaylistTag: CustomDebugStringConvertible {
         return (parsedValues != nil) ? parsedValues!.count : 0
     }
     
+    /**
+     Parses this tag's values if they have not been parsed yet.
+     
+     Tags from a `PlaylistParser` with `deferTagValueParsing` set do not parse their values until they are
+     first read, and a tag whose values fail to parse acts as though it has no values. Call this to find out
+     whether the values parse. It does nothing for other tags.
+     
+     - throws: The `PlaylistParserError` from parsing the values.
+     */
+    public func validateParsedValues() throws {
+        guard let deferredValues = deferredValues else {
+            return
+        }
+        if case .failure(let error) = deferredValues.result {
+            throw error
+        }
+    }
+    
+    /**
+     Returns this tag with its values parsed, if they have not been parsed yet, so that reading them takes no lock.
+     
+     The tag is not marked as edited. A tag whose values fail to parse keeps the error, so that
+     `validateParsedValues()` still throws, but it is held in a `DeferredPlaylistTagValues` that is already
+     settled and is read without its lock.
+     */
+    func resolvingDeferredValues() -> PlaylistTag {
+        guard let deferredValues = deferredValues else {
+            return self
+        }
+        var tag = self
+        switch deferredValues.result {
+        case .success(let parsedValues):
+            tag.storedParsedValues = parsedValues
+            tag.deferredValues = nil
+        case .failure:
+            tag.deferredValues = deferredValues.settled()
+        }
+        return tag
+    }
+    
     // MARK: Value getters
     
     /// An ordered collection of keys in the tag.
@@ -336,43 +442,174 @@ public struct PlaylistTag: CustomDebugStringConvertible {
         self.removeValue(forKey: valueIdentifier.toString())
     }
     
-    private var parsedValues: PlaylistTagDictionary? = nil {
-        didSet {
+    private var parsedValues: PlaylistTagDictionary? {
+        get {
+            if let deferredValues = deferredValues {
+                return try? deferredValues.result.get()
+            }
+            return storedParsedValues
+        }
+        set {
+            storedParsedValues = newValue
+            deferredValues = nil
             isDirty = true
         }
     }
+    private var storedParsedValues: PlaylistTagDictionary? = nil
+    /// Set when our parsedValues have not been parsed from `tagData` yet. Shared between copies of this tag until one of them sets a value.
+    private var deferredValues: DeferredPlaylistTagValues? = nil
     /// true if our parsedValues has been modified since initial set, false otherwise
     internal private(set) var isDirty: Bool = false
     
     public var debugDescription: String {
-        return "PlaylistTag tagDescriptor:\(tagDescriptor.toString()) tagData:\(tagData.stringValue())\n tagName:\((tagName == nil) ? "nil tagName" : tagName!.stringValue())\n       parsedValues:\(String(describing: parsedValues)) isDirty:\(isDirty)"
+        return "PlaylistTag tagDescriptor:\(tagDescriptor.toString()) tagData:\(tagDataString.stringValue())\n tagName:\((tagNameString == nil) ? "nil tagName" : tagNameString!.stringValue())\n       parsedValues:\(String(describing: parsedValues)) isDirty:\(isDirty)"
     }
 }
 
-extension PlaylistTag: Equatable {}
+extension PlaylistTag {
+    
+    /**
+     An estimate of the memory used by this tag: the tag itself, its parsed values and any `MambaStringRef`s
+     it holds. The playlist data that its spans point into is not included.
+     
+     Deferred values are counted as if they had been parsed, as they will be once they are read.
+     */
+    var estimatedByteCount: Int {
+        var byteCount = MemoryLayout<PlaylistTag>.stride
+        byteCount += tagNameString?.estimatedHeapByteCount ?? 0
+        byteCount += tagDataString.estimatedHeapByteCount
+        if let storedParsedValues = storedParsedValues {
+            byteCount += PlaylistTag.estimatedByteCount(ofValueCount: storedParsedValues.count, valueByteCount: tagDataString.length)
+        }
+        else if deferredValues != nil {
+            // a key value tag averages about one value per 16 bytes of data
+            // the `DeferredPlaylistTagValues` and its lock
+            byteCount += 2 * PlaylistTag.estimatedObjectByteCount
+            byteCount += PlaylistTag.estimatedByteCount(ofValueCount: max(tagDataString.length / 16, 1), valueByteCount: tagDataString.length)
+        }
+        return byteCount
+    }
+    
+    /// A small object (i.e. a `MambaStringRef`), including its header and allocation overhead
+    static let estimatedObjectByteCount = 64
+    
+    /// A `PlaylistTagDictionary` holds its keys in an array and in a hash table, and the key and value strings are usually about as long as the tag data
+    private static func estimatedByteCount(ofValueCount valueCount: Int, valueByteCount: Int) -> Int {
+        let keysByteCount = valueCount * MemoryLayout<String>.stride
+        // hash tables are kept at most 3/4 full
+        let tableByteCount = valueCount * (MemoryLayout<String>.stride + MemoryLayout<PlaylistTagValueData>.stride) * 4 / 3
+        return 2 * estimatedObjectByteCount + keysByteCount + tableByteCount + valueByteCount
+    }
+}
 
-private let emptyStringRef = MambaStringRef()
+extension PlaylistTag: Equatable {}
 
 public func ==(lhs: PlaylistTag, rhs: PlaylistTag) -> Bool {
     
-    let lhsTagName: MambaStringRef = lhs.tagName ?? emptyStringRef
-    let rhsTagName: MambaStringRef = rhs.tagName ?? emptyStringRef
+    let lhsTagName: PlaylistTagString = lhs.tagNameString ?? PlaylistTagString.empty
+    let rhsTagName: PlaylistTagString = rhs.tagNameString ?? PlaylistTagString.empty
     
     return lhs.tagDescriptor == rhs.tagDescriptor &&
         lhsTagName == rhsTagName &&
-        lhs.tagData == rhs.tagData
+        lhs.tagDataString == rhs.tagDataString
 }
 
 extension PlaylistTag: Hashable {
     public func hash(into hasher: inout Hasher) {
-        if let tagName = tagName {
-            hasher.combine(tagData)
-            hasher.combine(tagName)
+        if let tagNameString = tagNameString {
+            hasher.combine(tagDataString)
+            hasher.combine(tagNameString)
             tagDescriptor.hash(into: &hasher)
         }
         else {
-            hasher.combine(tagData)
+            hasher.combine(tagDataString)
             tagDescriptor.hash(into: &hasher)
         }
     }
 }
+
+/**
+ The values of a `PlaylistTag`, parsed the first time they are read.
+ 
+ Tags are read from many threads, so the result is guarded by a lock. Each instance has its own lock, so
+ threads reading different tags never wait on each other. The parse itself happens outside the lock. Two
+ threads may both parse the same tag, but they will get the same result.
+ 
+ Frozen playlists hold failed parses in an instance made with `settled()`. Its result is set when it is made
+ and never changes, so it is read without the lock.
+ */
+final class DeferredPlaylistTagValues {
+    
+    private let tagDescriptor: PlaylistTagDescriptor
+    private let tagData: PlaylistTagString
+    private let parser: PlaylistTagParser
+    private var parsedResult: Result<PlaylistTagDictionary, PlaylistParserError>? = nil
+    private let settledResult: Result<PlaylistTagDictionary, PlaylistParserError>?
+    
+    private let lock = NSLock()
+    
+    init(tagDescriptor: PlaylistTagDescriptor, tagData: PlaylistTagString, parser: PlaylistTagParser) {
+        self.tagDescriptor = tagDescriptor
+        self.tagData = tagData
+        self.parser = parser
+        self.settledResult = nil
+    }
+    
+    private init(tagDescriptor: PlaylistTagDescriptor,
+                 tagData: PlaylistTagString,
+                 parser: PlaylistTagParser,
+                 settledResult: Result<PlaylistTagDictionary, PlaylistParserError>) {
+        self.tagDescriptor = tagDescriptor
+        self.tagData = tagData
+        self.parser = parser
+        self.settledResult = settledResult
+    }
+    
+    /// A copy of these values with the result already parsed, which is read without the lock.
+    func settled() -> DeferredPlaylistTagValues {
+        return DeferredPlaylistTagValues(tagDescriptor: tagDescriptor, tagData: tagData, parser: parser, settledResult: result)
+    }
+    
+    var result: Result<PlaylistTagDictionary, PlaylistParserError> {
+        if let settledResult = settledResult {
+            return settledResult
+        }
+        
+        lock.lock()
+        let parsedResult = self.parsedResult
+        lock.unlock()
+        
+        if let parsedResult = parsedResult {
+            return parsedResult
+        }
+        
+        let result = PlaylistTagValuesParsing.parse(tagData: tagData, tagDescriptor: tagDescriptor, parser: parser)
+        
+        lock.lock()
+        self.parsedResult = result
+        lock.unlock()
+        
+        return result
+    }
+}
+
+/// Runs a `PlaylistTagParser` over tag data, preferring the `PlaylistTagUTF8Parser` path where the parser has one.
+enum PlaylistTagValuesParsing {
+    
+    static func parse(tagData: PlaylistTagString,
+                      tagDescriptor descriptor: PlaylistTagDescriptor,
+                      parser: PlaylistTagParser) -> Result<PlaylistTagDictionary, PlaylistParserError> {
+        do {
+            if let parser = parser as? PlaylistTagUTF8Parser {
+                return .success(try tagData.withUTF8Bytes { try parser.parseTag(fromUTF8Bytes: $0) })
+            }
+            return .success(try parser.parseTag(fromTagString: tagData.stringValue()))
+        }
+        catch let error as PlaylistParserError {
+            return .failure(error)
+        }
+        catch {
+            return .failure(PlaylistParserError.unknown(description:"Unknown error: \"\(error)\" while parsing tag \"\(descriptor.toString())\" with body \"\(tagData.stringValue())\""))
+        }
+    }
+}
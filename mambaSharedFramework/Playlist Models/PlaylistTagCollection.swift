@@ -0,0 +1,96 @@
+//
+//  PlaylistTagCollection.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ A read-only collection of the `PlaylistTag`s in a playlist.
+ 
+ A playlist keeps its tags in chunks, so that copies of a playlist share the tags they do not edit. This
+ collection reads those chunks directly: getting it from a playlist is O(1), looking up a tag by index is
+ O(log n), and iterating walks the chunks in order. Unlike `tags`, it does not have to build an `Array` the
+ first time it is read after an edit.
+ 
+ As with `ArraySlice`, a slice of this collection keeps the indices of the collection it was sliced from.
+ */
+public struct PlaylistTagCollection: RandomAccessCollection {
+    
+    private let storage: ChunkedArray<PlaylistTag>
+    
+    public let startIndex: Int
+    public let endIndex: Int
+    
+    public init(_ tags: [PlaylistTag]) {
+        self.init(ChunkedArray(tags))
+    }
+    
+    init(_ storage: ChunkedArray<PlaylistTag>) {
+        self.init(storage: storage, bounds: 0..<storage.count)
+    }
+    
+    private init(storage: ChunkedArray<PlaylistTag>, bounds: Range<Int>) {
+        self.storage = storage
+        self.startIndex = bounds.lowerBound
+        self.endIndex = bounds.upperBound
+    }
+    
+    public subscript(position: Int) -> PlaylistTag {
+        precondition(position >= startIndex && position < endIndex, "Index out of range")
+        return storage[position]
+    }
+    
+    public subscript(bounds: Range<Int>) -> PlaylistTagCollection {
+        precondition(bounds.lowerBound >= startIndex && bounds.upperBound <= endIndex, "Range out of range")
+        return PlaylistTagCollection(storage: storage, bounds: bounds)
+    }
+    
+    /// The tags as an `Array`. This is O(n).
+    public var array: [PlaylistTag] {
+        if startIndex == 0 && endIndex == storage.count {
+            return storage.array
+        }
+        return Array(self)
+    }
+    
+    public func makeIterator() -> Iterator {
+        return Iterator(base: storage.makeIterator(in: startIndex..<endIndex))
+    }
+    
+    public struct Iterator: IteratorProtocol {
+        
+        fileprivate var base: ChunkedArray<PlaylistTag>.Iterator
+        
+        public mutating func next() -> PlaylistTag? {
+            return base.next()
+        }
+    }
+    
+    /// The underlying chunks, for sharing with a new playlist structure. Only valid for an unsliced collection.
+    var chunkedArray: ChunkedArray<PlaylistTag> {
+        precondition(startIndex == 0 && endIndex == storage.count, "Only an unsliced collection shares its chunks")
+        return storage
+    }
+}
+
+extension PlaylistTagCollection: Equatable {
+    
+    public static func ==(lhs: PlaylistTagCollection, rhs: PlaylistTagCollection) -> Bool {
+        return lhs.elementsEqual(rhs)
+    }
+}
@@ -62,6 +62,19 @@ extension PlaylistCore: PlaylistURLDataInterface where PT.customPlaylistDataType
     }
 }
 
+extension FrozenPlaylist where PT.customPlaylistDataType == PlaylistURLData {
+    
+    /// The URL where this playlist is located
+    public var url: URL {
+        return customData.url
+    }
+    
+    /// The time the playlist this was frozen from was created. See `PlaylistURLDataInterface.creationTime`.
+    public var creationTime: TimeInterval {
+        return customData.creationTime
+    }
+}
+
 public protocol PlaylistURLDataInterface {
     /// The URL where this playlist is located
     var url: URL { get set }
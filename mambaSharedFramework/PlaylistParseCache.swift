@@ -0,0 +1,275 @@
+//
+//  PlaylistParseCache.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
+/**
+ A cache of parsed playlists, keyed by URL and the content of the playlist, for a `PlaylistParser`
+ (see `PlaylistParser.init`).
+ 
+ When many clients fetch the same playlist, most of them get byte-identical bodies. With a cache, a parse
+ of a body that has already been parsed for the same URL returns the playlist from the first parse. The
+ playlists share their `StaticMemoryStorage` and tags until one of them is edited, as copies of a playlist do.
+ 
+ Only playlists parsed from `Data` by `PlaylistParser.parse(playlistData:url:...)` are cached. Failed parses are
+ not cached. Parses of the same body that run at the same time will each parse it.
+ 
+ The least recently used playlists are removed to keep the cache within `maximumByteCount` and
+ `maximumPlaylistCount`. The size of a playlist is estimated from the length of its data and the size of its tags,
+ including their parsed (or yet to be parsed) values.
+ 
+ This class is thread safe, and may be shared between parsers.
+ */
+public final class PlaylistParseCache {
+    
+    /// The estimated number of bytes the cached playlists may use
+    public let maximumByteCount: Int
+    
+    /// The number of playlists that may be cached
+    public let maximumPlaylistCount: Int
+    
+    /**
+     Constructs an empty cache.
+     
+     - parameter maximumByteCount: The estimated number of bytes the cached playlists may use. A playlist
+     larger than this is not cached. Defaults to 64 MB.
+     - parameter maximumPlaylistCount: The number of playlists that may be cached. Defaults to 1024.
+     */
+    public init(maximumByteCount: Int = 64 * 1024 * 1024,
+                maximumPlaylistCount: Int = 1024) {
+        self.maximumByteCount = max(maximumByteCount, 0)
+        self.maximumPlaylistCount = max(maximumPlaylistCount, 0)
+    }
+    
+    /// The number of parses that returned a cached playlist
+    public var hitCount: Int {
+        return locked { _hitCount }
+    }
+    
+    /// The number of parses that did not find a cached playlist
+    public var missCount: Int {
+        return locked { _missCount }
+    }
+    
+    /// The number of playlists in the cache
+    public var playlistCount: Int {
+        return locked { entries.count }
+    }
+    
+    /// The estimated number of bytes used by the cached playlists
+    public var byteCount: Int {
+        return locked { _byteCount }
+    }
+    
+    /// Removes every playlist from the cache. The hit and miss counts are kept.
+    public func removeAll() {
+        locked {
+            entries.removeAll()
+            mostRecentlyUsed = nil
+            leastRecentlyUsed = nil
+            _byteCount = 0
+        }
+    }
+    
+    /**
+     What a parse result is cached under. A parser's registered tag types and `deferTagValueParsing` change
+     the tags it parses, so they are part of the key.
+     */
+    struct Key: Hashable {
+        let url: URL
+        let length: Int
+        let contentHash: Int
+        let registeredTagTypes: [ObjectIdentifier]
+        let deferTagValueParsing: Bool
+        
+        init(playlistData data: Data, url: URL, parser: PlaylistParser) {
+            var hasher = Hasher()
+            data.withUnsafeBytes { hasher.combine(bytes: $0) }
+            self.url = url
+            self.length = data.count
+            self.contentHash = hasher.finalize()
+            self.registeredTagTypes = parser.registeredPlaylistTags.registeredTagDescriptors.map { ObjectIdentifier($0) }
+            self.deferTagValueParsing = parser.deferTagValueParsing
+        }
+    }
+    
+    /**
+     Returns the playlist cached for `key`, if its data is `data`, and counts a hit or a miss.
+     
+     The playlist is given new `PlaylistURLData`, so its `creationTime` is now.
+     */
+    func cachedResult(forKey key: Key, playlistData data: Data) -> ParserResult? {
+        
+        let cachedEntry: Entry? = locked {
+            guard let entry = entries[key], entry.playlistMemoryStorage.documentLength == data.count else {
+                _missCount += 1
+                return nil
+            }
+            return entry
+        }
+        guard let entry = cachedEntry else {
+            return nil
+        }
+        
+        // the hash is not proof, so we compare the bytes as well. This is much quicker than a parse, but we do
+        // it outside the lock so other parsers are not held up. The entry keeps the storage alive while we compare
+        let isSameData = data.withUnsafeBytes { bytes -> Bool in
+            guard let baseAddress = bytes.baseAddress else {
+                return data.isEmpty
+            }
+            return entry.playlistMemoryStorage.isDocumentPrefix(ofBytes: baseAddress, length: UInt(bytes.count))
+        }
+        
+        let cachedResult: ParserResult? = locked {
+            guard isSameData else {
+                _missCount += 1
+                return nil
+            }
+            _hitCount += 1
+            // the entry may have been removed while we were comparing
+            if entries[key] === entry {
+                moveToFront(entry)
+            }
+            return entry.result
+        }
+        
+        switch cachedResult {
+        case .parsedMaster(var playlist)?:
+            playlist.customData = PlaylistURLData(url: key.url)
+            return .parsedMaster(playlist)
+        case .parsedVariant(var playlist)?:
+            playlist.customData = PlaylistURLData(url: key.url)
+            return .parsedVariant(playlist)
+        case .parseError?, nil:
+            return nil
+        }
+    }
+    
+    /// Caches `result` under `key` if it is a playlist, removing the least recently used playlists to make room for it
+    func store(_ result: ParserResult, forKey key: Key) {
+        
+        let playlistMemoryStorage: StaticMemoryStorage
+        let tagsByteCount: Int
+        switch result {
+        case .parsedMaster(let playlist):
+            playlistMemoryStorage = playlist.playlistMemoryStorage
+            tagsByteCount = playlist.tagCollection.reduce(0) { $0 + $1.estimatedByteCount }
+        case .parsedVariant(let playlist):
+            playlistMemoryStorage = playlist.playlistMemoryStorage
+            tagsByteCount = playlist.tagCollection.reduce(0) { $0 + $1.estimatedByteCount }
+        case .parseError:
+            return
+        }
+        let byteCount = Int(playlistMemoryStorage.documentLength) + tagsByteCount
+        guard byteCount <= maximumByteCount && maximumPlaylistCount > 0 else {
+            return
+        }
+        
+        let entry = Entry(key: key, result: result, playlistMemoryStorage: playlistMemoryStorage, byteCount: byteCount)
+        
+        locked {
+            if let existingEntry = entries[key] {
+                remove(existingEntry)
+            }
+            while _byteCount + byteCount > maximumByteCount || entries.count >= maximumPlaylistCount, let leastRecentlyUsedEntry = leastRecentlyUsed {
+                remove(leastRecentlyUsedEntry)
+            }
+            entries[key] = entry
+            _byteCount += byteCount
+            moveToFront(entry)
+        }
+    }
+    
+    // MARK: Least recently used list
+    
+    private final class Entry {
+        let key: Key
+        let result: ParserResult
+        let playlistMemoryStorage: StaticMemoryStorage
+        let byteCount: Int
+        // towards `mostRecentlyUsed`
+        weak var previous: Entry?
+        // towards `leastRecentlyUsed`
+        var next: Entry?
+        
+        init(key: Key, result: ParserResult, playlistMemoryStorage: StaticMemoryStorage, byteCount: Int) {
+            self.key = key
+            self.result = result
+            self.playlistMemoryStorage = playlistMemoryStorage
+            self.byteCount = byteCount
+        }
+    }
+    
+    private var entries = [Key: Entry]()
+    private var mostRecentlyUsed: Entry?
+    private weak var leastRecentlyUsed: Entry?
+    private var _hitCount = 0
+    private var _missCount = 0
+    private var _byteCount = 0
+    
+    private let lock = NSLock()
+    
+    private func locked<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer {
+            lock.unlock()
+        }
+        return try body()
+    }
+    
+    // only call while locked
+    private func unlink(_ entry: Entry) {
+        if let previous = entry.previous {
+            previous.next = entry.next
+        }
+        else if mostRecentlyUsed === entry {
+            mostRecentlyUsed = entry.next
+        }
+        if let next = entry.next {
+            next.previous = entry.previous
+        }
+        else if leastRecentlyUsed === entry {
+            leastRecentlyUsed = entry.previous
+        }
+        entry.previous = nil
+        entry.next = nil
+    }
+    
+    // only call while locked
+    private func moveToFront(_ entry: Entry) {
+        unlink(entry)
+        entry.next = mostRecentlyUsed
+        mostRecentlyUsed?.previous = entry
+        mostRecentlyUsed = entry
+        if leastRecentlyUsed == nil {
+            leastRecentlyUsed = entry
+        }
+    }
+    
+    // only call while locked
+    private func remove(_ entry: Entry) {
+        unlink(entry)
+        entries[entry.key] = nil
+        _byteCount -= entry.byteCount
+    }
+}
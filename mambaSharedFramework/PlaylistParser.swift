@@ -19,6 +19,7 @@
 
 import Foundation
 import QuartzCore
+import CoreMedia
 
 #if SWIFT_PACKAGE
 import PlaylistParserError
@@ -32,6 +33,9 @@ public final class PlaylistParser {
     
     internal fileprivate(set) var registeredPlaylistTags = RegisteredPlaylistTags()
     internal let updateEventPlaylistParams: UpdateEventPlaylistParams
+    internal let parallelParseParams: ParallelParsePlaylistParams?
+    internal let deferTagValueParsing: Bool
+    internal let parseCache: PlaylistParseCache?
     
     /**
      Constructs a parser for HLS playlists.
@@ -44,10 +48,27 @@ public final class PlaylistParser {
      behavior when updating an Event style variant playlist. See `UpdateEventPlaylistParams`
      for details. If you are uncertain, the defaults are probably good. Mostly present for
      unit testing purposes.
+     - parameter parallelParseParams: An optional struct that turns on parsing of large playlists
+     on multiple threads. See `ParallelParsePlaylistParams` for details. Parsing is single threaded
+     if this is nil (the default).
+     - parameter deferTagValueParsing: If true, the values of single value and key value tags
+     (i.e. the attributes of a #EXT-X-STREAM-INF tag) are not parsed until they are first read,
+     so callers only pay for the values they use. A tag whose values fail to parse will not fail
+     the playlist parse, but will have no values. Use `PlaylistTag.validateParsedValues()` to
+     find such tags. Defaults to false.
+     - parameter parseCache: An optional cache of parsed playlists. If set, parsing `Data` that this
+     cache has already seen for the same URL returns the cached playlist rather than parsing it again.
+     See `PlaylistParseCache` for details. Defaults to nil.
      */
     public init(tagTypes:[PlaylistTagDescriptor.Type]? = nil,
-                updateEventPlaylistParams: UpdateEventPlaylistParams = UpdateEventPlaylistParams()) {
+                updateEventPlaylistParams: UpdateEventPlaylistParams = UpdateEventPlaylistParams(),
+                parallelParseParams: ParallelParsePlaylistParams? = nil,
+                deferTagValueParsing: Bool = false,
+                parseCache: PlaylistParseCache? = nil) {
         self.updateEventPlaylistParams = updateEventPlaylistParams
+        self.parallelParseParams = parallelParseParams
+        self.deferTagValueParsing = deferTagValueParsing
+        self.parseCache = parseCache
         if let tagTypes = tagTypes {
             for tagType in tagTypes {
                 registerPlaylistTags(tagType: tagType)
@@ -94,16 +115,36 @@ public final class PlaylistParser {
      
      - parameter url: The URL of the original playlist.
      
+     - parameter cancellationToken: An optional token to cancel the parse with, or to give it
+     a deadline. See `PlaylistParserCancellationToken`.
+     
      - parameter callback: A closure callback called with a `PlaylistParserResult` value
-     when complete.
+     when complete. If the playlist is found in our `parseCache`, this is called before this
+     method returns.
      */
     public func parse(playlistData data: Data,
                       url: URL,
+                      cancellationToken: PlaylistParserCancellationToken? = nil,
                       callback: @escaping PlaylistParserResult) {
         
+        var callback = callback
+        if let parseCache = parseCache {
+            let cacheKey = PlaylistParseCache.Key(playlistData: data, url: url, parser: self)
+            if let result = parseCache.cachedResult(forKey: cacheKey, playlistData: data) {
+                callback(result)
+                return
+            }
+            let uncachedCallback = callback
+            callback = { result in
+                parseCache.store(result, forKey: cacheKey)
+                uncachedCallback(result)
+            }
+        }
+        
         parse(playlistData: data,
               customData: PlaylistURLData(url: url),
               playlistConstructor: constructMasterOrVariantPlaylist,
+              cancellationToken: cancellationToken,
               resultCallback: callback)
     }
     
@@ -126,16 +167,104 @@ public final class PlaylistParser {
      
      - parameter url: The URL of the original playlist.
      
-     - parameter timeout: The timeout in seconds. If the timeout is exceeded, an
-     `ParserError` with the `timedOut` code will be thrown.
+     - parameter timeout: The timeout in seconds. The parse stops as soon as it notices the
+     timeout has been exceeded, and a `ParserError` with the `timedOut` code will be returned.
      
      - returns: A `PlaylistParserResult`.
      */
     public func parse(playlistData data: Data, url: URL, timeout: Int = 1) -> ParserResult {
-        return parse(playlistData: data,
-                     customData: PlaylistURLData(url: url),
-                     playlistConstructor: constructMasterOrVariantPlaylist,
-                     timeout: timeout)
+        
+        let cacheKey = parseCache.map { _ in PlaylistParseCache.Key(playlistData: data, url: url, parser: self) }
+        if let cacheKey = cacheKey, let result = parseCache?.cachedResult(forKey: cacheKey, playlistData: data) {
+            return result
+        }
+        
+        let result = parse(playlistData: data,
+                           customData: PlaylistURLData(url: url),
+                           playlistConstructor: constructMasterOrVariantPlaylist,
+                           timeout: timeout)
+        if let cacheKey = cacheKey {
+            parseCache?.store(result, forKey: cacheKey)
+        }
+        return result
+    }
+    
+    /**
+     Parses a HLS playlist file into a `MasterPlaylist` or `VariantPlaylist` structure
+     for editing.
+     
+     Asynchronous version.
+     
+     The file is memory mapped rather than read, so the playlist is never copied, and
+     only the pages that are in use take up memory.
+     
+     - warning: the final playlist keeps the file mapped for as long as the playlist
+     (or any of its `PlaylistTag`s) is alive. If the file is modified or truncated during
+     that time, the caller will get undefined behavior.
+     
+     - parameter fileAt: A file URL of a HLS playlist. This is also used as the URL of the playlist.
+     
+     - parameter cancellationToken: An optional token to cancel the parse with, or to give it
+     a deadline. See `PlaylistParserCancellationToken`.
+     
+     - parameter callback: A closure callback called with a `PlaylistParserResult` value
+     when complete. If the file cannot be read, this is called before this method returns
+     with an `unknown` error.
+     */
+    public func parse(fileAt url: URL,
+                      cancellationToken: PlaylistParserCancellationToken? = nil,
+                      callback: @escaping PlaylistParserResult) {
+        
+        let playlistMemoryStorage: StaticMemoryStorage
+        do {
+            playlistMemoryStorage = try StaticMemoryStorage(contentsOfFileAtPath: url.path)
+        }
+        catch {
+            callback(.parseError(.unknown(description: "Unable to read \(url.path): \(error.localizedDescription)")))
+            return
+        }
+        
+        parse(playlistMemoryStorage: playlistMemoryStorage,
+              customData: PlaylistURLData(url: url),
+              playlistConstructor: constructMasterOrVariantPlaylist,
+              cancellationToken: cancellationToken,
+              resultCallback: callback)
+    }
+    
+    /**
+     Parses a HLS playlist file into a `MasterPlaylist` or `VariantPlaylist` structure
+     for editing.
+     
+     Synchronous version. The playlist is parsed on the calling thread.
+     
+     The file is memory mapped rather than read, so the playlist is never copied, and
+     only the pages that are in use take up memory.
+     
+     - warning: the final playlist keeps the file mapped for as long as the playlist
+     (or any of its `PlaylistTag`s) is alive. If the file is modified or truncated during
+     that time, the caller will get undefined behavior.
+     
+     - parameter fileAt: A file URL of a HLS playlist. This is also used as the URL of the playlist.
+     
+     - parameter timeout: The timeout in seconds. The parse stops as soon as it notices the
+     timeout has been exceeded, and a `ParserError` with the `timedOut` code will be returned.
+     
+     - returns: A `PlaylistParserResult`.
+     */
+    public func parse(fileAt url: URL, timeout: Int = 1) -> ParserResult {
+        
+        let playlistMemoryStorage: StaticMemoryStorage
+        do {
+            playlistMemoryStorage = try StaticMemoryStorage(contentsOfFileAtPath: url.path)
+        }
+        catch {
+            return .parseError(.unknown(description: "Unable to read \(url.path): \(error.localizedDescription)"))
+        }
+        
+        return parseInline(playlistMemoryStorage: playlistMemoryStorage,
+                           customData: PlaylistURLData(url: url),
+                           playlistConstructor: constructMasterOrVariantPlaylist,
+                           cancellationToken: PlaylistParserCancellationToken(timeout: timeout))
     }
     
     /**
@@ -147,7 +276,19 @@ public final class PlaylistParser {
      so you can tune this method if the defaults are not good for you.
      
      It will take care of memory usage, although the rules about not using `PlaylistTag`
-     after the parent playlist is deleted still apply.
+     after the parent playlist is deleted still apply. Only the bytes that are new since
+     `eventVariantPlaylist` was parsed are copied and parsed. The new playlist's
+     `playlistMemoryStorage` holds them and keeps the storage of `eventVariantPlaylist` alive
+     (see `StaticMemoryStorage.precedingStorage`).
+     Once that chain is `UpdateEventPlaylistParams.maximumPrecedingStorageCount` long, the
+     update is a normal parse, which starts a new chain.
+     
+     Only Event playlists are updated this way. A sliding window live playlist drops fragments
+     from its start, so the old playlist is never the start of the new one, and keeping the old
+     tags up to the last fragment would keep fragments the server has dropped. Its new header
+     (with a new `EXT-X-MEDIA-SEQUENCE`) also comes before the fragments we would keep, so they are
+     not a prefix of the new document that a storage chain could continue. Those are always
+     parsed from scratch.
      
      Asynchronous version.
      
@@ -186,10 +327,17 @@ public final class PlaylistParser {
             // check to see if this situation merits an update vs a parse
             data.count > updateEventPlaylistParams.minimalBytesToTriggerUpdate,
             (CACurrentMediaTime() - eventVariantPlaylist.creationTime) < updateEventPlaylistParams.maximumAmountOfTimeBetweenUpdatesToTrigger,
+            // flatten long storage chains with a normal parse
+            Int(eventVariantPlaylist.playlistMemoryStorage.precedingStorageCount) < updateEventPlaylistParams.maximumPrecedingStorageCount,
             // ensure we can get the data we need to do an update
             let lastMediaSegmentGroup = eventVariantPlaylist.mediaSegmentGroups.last,
             let lastFragmentTag = eventVariantPlaylist.tags(forMediaGroup: lastMediaSegmentGroup).filter({ $0.tagDescriptor == PantosTag.Location }).first,
-            !lastFragmentTag.tagData.stringValue().isEmpty else {
+            lastFragmentTag.tagDataString.length > 0,
+            // find out which bytes are new
+            let (keptTagCount, playlistMemoryStorage) = eventVariantUpdateStorage(forEventVariantPlaylist: eventVariantPlaylist,
+                                                                                  lastFragmentTag: lastFragmentTag,
+                                                                                  lastFragmentTagIndex: lastMediaSegmentGroup.endIndex,
+                                                                                  playlistData: data) else {
                 
                 // if we fail preconditions just do a normal parse quietly
                 eventVariantUpdateFallbackToNormalParse(withPlaylistData: data,
@@ -199,14 +347,25 @@ public final class PlaylistParser {
                 return
         }
         
+        guard playlistMemoryStorage.length > 0 else {
+            // nothing new
+            constructAndReturnEventVariantUpdate(fromEventVariantPlaylist: eventVariantPlaylist,
+                                                 keepingTagCount: keptTagCount,
+                                                 appendingNewTags: [],
+                                                 playlistMemoryStorage: playlistMemoryStorage,
+                                                 withSuccessCallback: success)
+            return
+        }
+        
+        // only the new bytes are parsed, and the new tags refer to the new storage without copying
         let worker = ParseWorker(registeredPlaylistTags: registeredPlaylistTags,
-                                 data: data,
+                                 playlistMemoryStorage: playlistMemoryStorage,
                                  parser: self,
-                                 parserMode: .parsingEventPlaylistLookingForFragmentURL(fragmentURL: lastFragmentTag.tagData.stringValue()),
                                  success: { [weak self] (tags, storage) in
                                     self?.constructAndReturnEventVariantUpdate(fromEventVariantPlaylist: eventVariantPlaylist,
-                                                                               insertingNewTags: tags,
-                                                                               afterTagPosition: lastMediaSegmentGroup.endIndex,
+                                                                               keepingTagCount: keptTagCount,
+                                                                               appendingNewTags: tags,
+                                                                               playlistMemoryStorage: storage,
                                                                                withSuccessCallback: success) },
                                  failure: { [weak self] _ in
                                     // try a normal parse
@@ -222,6 +381,70 @@ public final class PlaylistParser {
         worker.startParse()
     }
     
+    /**
+     Finds the bytes of `data` that are new since `eventVariantPlaylist` was parsed, and copies them into a
+     `StaticMemoryStorage` that continues the storage of `eventVariantPlaylist`, so the tags we keep stay valid.
+     
+     Fragments already sent in an event playlist never change <https://tools.ietf.org/html/draft-pantos-hls-rfc8216bis-03#section-6.2.1>,
+     so usually the server has only added lines to the end, the document we already have is the start of `data`,
+     and we keep all our tags. Otherwise, we look for the line of the last fragment we know
+     about, and keep our tags up to and including it.
+     
+     - returns: The number of tags of `eventVariantPlaylist` to keep and the storage of the new bytes, or nil
+     if we cannot tell which bytes are new.
+     */
+    private func eventVariantUpdateStorage(forEventVariantPlaylist eventVariantPlaylist: VariantPlaylist,
+                                           lastFragmentTag: PlaylistTag,
+                                           lastFragmentTagIndex: Int,
+                                           playlistData data: Data) -> (Int, StaticMemoryStorage)? {
+        
+        let previousStorage = eventVariantPlaylist.playlistMemoryStorage
+        
+        return data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> (Int, StaticMemoryStorage)? in
+            
+            guard let bytes = buffer.baseAddress else {
+                return nil
+            }
+            
+            func isLineEnding(_ index: Int) -> Bool {
+                return buffer[index] == UInt8(ascii: "\n") || buffer[index] == UInt8(ascii: "\r")
+            }
+            
+            let previousLength = Int(previousStorage.documentLength)
+            if previousLength > 0 && previousStorage.isDocumentPrefix(ofBytes: bytes, length: UInt(buffer.count)) {
+                if previousLength == buffer.count {
+                    return (eventVariantPlaylist.tagCollection.count, previousStorage)
+                }
+                // our last line must have been complete
+                if isLineEnding(previousLength - 1) || isLineEnding(previousLength) {
+                    return (eventVariantPlaylist.tagCollection.count, StaticMemoryStorage(bytes: bytes + previousLength,
+                                                                                           length: UInt(buffer.count - previousLength),
+                                                                                           precedingStorage: previousStorage,
+                                                                                           precedingLength: UInt(previousLength)))
+                }
+            }
+            
+            // we can only tell where the last fragment ends in our document if it points into our storage
+            guard
+                case .span(let lastFragmentSpan) = lastFragmentTag.tagDataString,
+                let lastFragmentBytes = lastFragmentSpan.bytes else {
+                    return nil
+            }
+            let lastFragmentOffset = previousStorage.documentOffset(ofPointer: lastFragmentBytes)
+            let newBytesOffset = mamba_offsetAfterLastLineMatching(bytes.assumingMemoryBound(to: CChar.self),
+                                                                   UInt64(buffer.count),
+                                                                   lastFragmentBytes,
+                                                                   UInt64(lastFragmentSpan.length))
+            guard lastFragmentOffset != UInt(NSNotFound), newBytesOffset >= 0 else {
+                return nil
+            }
+            return (lastFragmentTagIndex + 1, StaticMemoryStorage(bytes: bytes + Int(newBytesOffset),
+                                                                  length: UInt(buffer.count - Int(newBytesOffset)),
+                                                                  precedingStorage: previousStorage,
+                                                                  precedingLength: lastFragmentOffset + UInt(lastFragmentSpan.length)))
+        }
+    }
+    
     private func eventVariantUpdateFallbackToNormalParse(withPlaylistData data: Data,
                                                          atUrl url: URL,
                                                          withSuccessCallback success: @escaping VariantPlaylistParserSuccess,
@@ -244,16 +467,17 @@ public final class PlaylistParser {
     }
     
     private func constructAndReturnEventVariantUpdate(fromEventVariantPlaylist eventVariantPlaylist: VariantPlaylist,
-                                                      insertingNewTags newTags: [PlaylistTag],
-                                                      afterTagPosition insertTagPosition: Int,
+                                                      keepingTagCount keptTagCount: Int,
+                                                      appendingNewTags newTags: [PlaylistTag],
+                                                      playlistMemoryStorage: StaticMemoryStorage,
                                                       withSuccessCallback success: @escaping VariantPlaylistParserSuccess) {
         
-        var tags = eventVariantPlaylist.tags[0...insertTagPosition]
+        var tags = eventVariantPlaylist.tagCollection[0..<keptTagCount].array
         tags.append(contentsOf: newTags)
         let newPlaylist = VariantPlaylist(url: eventVariantPlaylist.url,
-                                          tags: Array(tags),
+                                          tags: tags,
                                           registeredPlaylistTags: registeredPlaylistTags,
-                                          playlistMemoryStorage: eventVariantPlaylist.playlistMemoryStorage)
+                                          playlistMemoryStorage: playlistMemoryStorage)
         success(newPlaylist)
     }
     
@@ -266,7 +490,19 @@ public final class PlaylistParser {
      so you can tune this method if the defaults are not good for you.
      
      It will take care of memory usage, although the rules about not using `PlaylistTag`
-     after the parent playlist is deleted still apply.
+     after the parent playlist is deleted still apply. Only the bytes that are new since
+     `eventVariantPlaylist` was parsed are copied and parsed. The new playlist's
+     `playlistMemoryStorage` holds them and keeps the storage of `eventVariantPlaylist` alive
+     (see `StaticMemoryStorage.precedingStorage`).
+     Once that chain is `UpdateEventPlaylistParams.maximumPrecedingStorageCount` long, the
+     update is a normal parse, which starts a new chain.
+     
+     Only Event playlists are updated this way. A sliding window live playlist drops fragments
+     from its start, so the old playlist is never the start of the new one, and keeping the old
+     tags up to the last fragment would keep fragments the server has dropped. Its new header
+     (with a new `EXT-X-MEDIA-SEQUENCE`) also comes before the fragments we would keep, so they are
+     not a prefix of the new document that a storage chain could continue. Those are always
+     parsed from scratch.
      
      Synchronous version.
      
@@ -360,14 +596,32 @@ public final class PlaylistParser {
      object, and the playlistData. See the `constructMasterOrVariantPlaylist` function
      for an example.
      
+     - parameter cancellationToken: An optional token to cancel the parse with, or to give it
+     a deadline. See `PlaylistParserCancellationToken`.
+     
      - parameter resultCallback: A closure callback called with a concrete R type that
      the caller has defined.
      */
     public func parse<CD, R>(playlistData data: Data,
                              customData: CD,
                              playlistConstructor: @escaping PlaylistConstructor<CD, R>,
+                             cancellationToken: PlaylistParserCancellationToken? = nil,
                              resultCallback: @escaping (R) -> (Swift.Void)) {
         
+        // the playlist keeps a reference to `data` rather than a copy, see the warning above
+        parse(playlistMemoryStorage: StaticMemoryStorage(dataNoCopy: data),
+              customData: customData,
+              playlistConstructor: playlistConstructor,
+              cancellationToken: cancellationToken,
+              resultCallback: resultCallback)
+    }
+    
+    private func parse<CD, R>(playlistMemoryStorage: StaticMemoryStorage,
+                              customData: CD,
+                              playlistConstructor: @escaping PlaylistConstructor<CD, R>,
+                              cancellationToken: PlaylistParserCancellationToken?,
+                              resultCallback: @escaping (R) -> (Swift.Void)) {
+        
         let registeredPlaylistTagsCopy = registeredPlaylistTags
         
         let success: ParserSuccess = { tags, storage in
@@ -380,8 +634,10 @@ public final class PlaylistParser {
         }
         
         let worker = ParseWorker(registeredPlaylistTags: registeredPlaylistTags,
-                                 data: data,
+                                 playlistMemoryStorage: playlistMemoryStorage,
                                  parser: self,
+                                 partitionCount: parallelParseParams?.partitionCount(forPlaylistLength: Int(playlistMemoryStorage.length)) ?? 1,
+                                 cancellationToken: cancellationToken,
                                  success: success,
                                  failure: failure)
         
@@ -392,6 +648,39 @@ public final class PlaylistParser {
         worker.startParse()
     }
     
+    /**
+     Parses on the calling thread. No dispatch queue is created or hopped to, and nothing waits on a
+     semaphore, so for small playlists this is much cheaper than waiting on an asynchronous parse.
+     */
+    private func parseInline<CD, R>(playlistMemoryStorage: StaticMemoryStorage,
+                                    customData: CD,
+                                    playlistConstructor: PlaylistConstructor<CD, R>,
+                                    cancellationToken: PlaylistParserCancellationToken?) -> R {
+        
+        let registeredPlaylistTagsCopy = registeredPlaylistTags
+        var result: R?
+        
+        withoutActuallyEscaping(playlistConstructor) { playlistConstructor in
+            // the worker calls back before `parseInline` returns, so nothing here outlives this call
+            let worker = ParseWorker(registeredPlaylistTags: registeredPlaylistTagsCopy,
+                                     playlistMemoryStorage: playlistMemoryStorage,
+                                     parser: self,
+                                     partitionCount: parallelParseParams?.partitionCount(forPlaylistLength: Int(playlistMemoryStorage.length)) ?? 1,
+                                     cancellationToken: cancellationToken,
+                                     success: { tags, storage in
+                                        result = playlistConstructor(BaseParserResult.success(tags), customData, registeredPlaylistTagsCopy, storage) },
+                                     failure: { error in
+                                        result = playlistConstructor(BaseParserResult.failure(error), customData, registeredPlaylistTagsCopy, StaticMemoryStorage()) })
+            worker.parseInline()
+        }
+        
+        guard let finalResult = result else {
+            assertionFailure("No error, but playlist was nil!")
+            return playlistConstructor(BaseParserResult.failure(.unknown(description: "No error found, but no playlist was generated.")), customData, registeredPlaylistTagsCopy, StaticMemoryStorage())
+        }
+        return finalResult
+    }
+    
     /**
      Generic synchronous parser for your concrete `PlaylistCore` objects, if you
      need one. Most users will be using the built-in `MasterPlaylist/VariantPlaylist`
@@ -425,8 +714,8 @@ public final class PlaylistParser {
      object, and the playlistData. See the `constructMasterOrVariantPlaylist` function
      for an example.
      
-     - parameter timeout: The timeout in seconds. If the timeout is exceeded, an
-     `ParserError` with the `timedOut` code will be returned.
+     - parameter timeout: The timeout in seconds. The parse stops as soon as it notices the
+     timeout has been exceeded, and a `ParserError` with the `timedOut` code will be returned.
      
      - returns: A "R" value, which the caller has defined.
      */
@@ -435,22 +724,33 @@ public final class PlaylistParser {
                              playlistConstructor: @escaping PlaylistConstructor<CD, R>,
                              timeout: Int = 1) -> R {
         
-        let semaphore = DispatchSemaphore(value: 0)
-        let registeredPlaylistTagsCopy = registeredPlaylistTags
-        var result: R = playlistConstructor(BaseParserResult.failure(.timedOut), customData, registeredPlaylistTagsCopy, StaticMemoryStorage())
-        
-        self.parse(playlistData: playlistData,
-                   customData: customData,
-                   playlistConstructor: playlistConstructor,
-                   resultCallback: { newResult in
-                    result = newResult
-                    semaphore.signal() })
-        
-        if semaphore.wait(timeout: DispatchTime.now() + DispatchTimeInterval.seconds(timeout)) == .timedOut {
-            return result
-        }
-        
-        return result
+        // the playlist keeps a reference to `data` rather than a copy, see the warning above
+        return parseInline(playlistMemoryStorage: StaticMemoryStorage(dataNoCopy: playlistData),
+                           customData: customData,
+                           playlistConstructor: playlistConstructor,
+                           cancellationToken: PlaylistParserCancellationToken(timeout: timeout))
+    }
+    
+    /**
+     Begins an incremental parse of a HLS playlist into a `MasterPlaylist` or `VariantPlaylist`
+     structure for editing.
+     
+     Use this when the playlist is arriving over the network. Feed each chunk to the returned
+     `IncrementalPlaylistParse` as it is received, and call `finish()` when the download is complete.
+     Most of the parsing work happens as the data arrives, so the playlist is ready very soon after
+     the last chunk.
+     
+     - parameter url: The URL of the original playlist.
+     
+     - parameter expectedContentLength: An optional expected length of the playlist in bytes
+     (typically from the `Content-Length` header), used to size buffers up front.
+     
+     - returns: An `IncrementalPlaylistParse` to feed data to.
+     */
+    public func beginIncrementalParse(url: URL, expectedContentLength: Int? = nil) -> IncrementalPlaylistParse {
+        return IncrementalPlaylistParse(parser: self,
+                                        url: url,
+                                        expectedContentLength: expectedContentLength)
     }
     
     private var workers = Set<ParseWorker>()
@@ -463,6 +763,86 @@ public final class PlaylistParser {
     }
 }
 
+/**
+ An in-progress incremental parse of a HLS playlist. Get one from `PlaylistParser.beginIncrementalParse(url:expectedContentLength:)`.
+ 
+ The playlist is scanned forwards as each chunk is fed, on the calling thread. This object is not thread safe,
+ so `feed(playlistData:)` and `finish()` should be called from a single thread or serial queue (for example,
+ from a `URLSessionDataDelegate`).
+ */
+public final class IncrementalPlaylistParse {
+    
+    private let worker: ParseWorker
+    private var playlistData = Data()
+    private var result: ParserResult?
+    
+    fileprivate init(parser: PlaylistParser, url: URL, expectedContentLength: Int?) {
+        
+        if let expectedContentLength = expectedContentLength, expectedContentLength > 0 {
+            playlistData.reserveCapacity(expectedContentLength)
+        }
+        
+        worker = ParseWorker(registeredPlaylistTags: parser.registeredPlaylistTags,
+                             playlistMemoryStorage: StaticMemoryStorage(),
+                             parser: parser,
+                             parserMode: .parsingIncrementally,
+                             success: { _, _ in },
+                             failure: { _ in })
+        
+        let urlData = PlaylistURLData(url: url)
+        let registeredPlaylistTags = parser.registeredPlaylistTags
+        
+        // the worker calls back synchronously from `feed` or `finish`, so we will always be around
+        worker.success = { [unowned self] tags, storage in
+            self.result = constructMasterOrVariantPlaylist(withBaseParserResult: .success(tags),
+                                                           andUrlData: urlData,
+                                                           andRegisteredPlaylistTags: registeredPlaylistTags,
+                                                           andPlaylistMemoryStorage: storage)
+        }
+        worker.failure = { [unowned self] error in
+            self.result = .parseError(error)
+        }
+        worker.startParse()
+    }
+    
+    /**
+     Scans the next chunk of the playlist.
+     
+     - parameter data: The bytes that have arrived since the last call. Data is copied, so the caller
+     may reuse the buffer.
+     
+     - returns: `false` if the parse has already failed, in which case there is no point in feeding
+     any more data. `finish()` will return the error.
+     */
+    @discardableResult
+    public func feed(playlistData data: Data) -> Bool {
+        guard result == nil else {
+            return false
+        }
+        playlistData.append(data)
+        return worker.feedIncrementalParse(data)
+    }
+    
+    /**
+     Completes the parse.
+     
+     - returns: A `ParserResult`. Calling this method more than once returns the same result.
+     */
+    public func finish() -> ParserResult {
+        if let result = result {
+            return result
+        }
+        // we hand our buffer over to the storage, so there is no need for another copy
+        worker.finishIncrementalParse(withStorage: StaticMemoryStorage(dataNoCopy: playlistData))
+        playlistData = Data()
+        guard let finalResult = result else {
+            assertionFailure("No error, but playlist was nil!")
+            return .parseError(.unknown(description: "No error found, but no playlist was generated."))
+        }
+        return finalResult
+    }
+}
+
 public typealias PlaylistParserResult = (ParserResult) -> (Swift.Void)
 
 /// Result from a parse of a HLS playlist
@@ -531,129 +911,159 @@ public typealias VariantPlaylistParserSuccess = (VariantPlaylist) -> (Swift.Void
 public typealias PlaylistParserFailure = (PlaylistParserError) -> (Swift.Void)
 
 
-fileprivate final class ParseWorker: NSObject, RapidParserCallback {
+fileprivate final class ParseWorker: NSObject, RapidParserLineRecordCallback {
     
     let fastParser = RapidParser()
     var tags = [PlaylistTag]()
-    let playlistMemoryStorage: StaticMemoryStorage
+    var playlistMemoryStorage: StaticMemoryStorage
     // strong ref to parent parser while parsing is happening
     // we release when parsing is over to prevent retain cycles
-    // see `parseFail, `parseSuccess` and `parseEventUpdateSuccess` for where we do that.
+    // see `parseFail` and `parseSucceed` for where we do that.
     var parser: PlaylistParser?
     let registeredPlaylistTags: RegisteredPlaylistTags
     var success: ParserSuccess
     var failure: ParserFailure
     let parserMode: ParseWorkerMode
+    // the number of threads to parse on, see `ParallelParsePlaylistParams`
+    let partitionCount: Int
+    // see `PlaylistParser.deferTagValueParsing`
+    let deferTagValueParsing: Bool
+    // checked while scanning and building tags. the incremental parse does not use this.
+    let cancellationToken: PlaylistParserCancellationToken?
+    
+    // the number of tags we build between checks of `cancellationToken`
+    private static let cancellationCheckInterval = 4096
     
     init(registeredPlaylistTags: RegisteredPlaylistTags,
-         data: Data,
+         playlistMemoryStorage: StaticMemoryStorage,
          parser: PlaylistParser,
          parserMode: ParseWorkerMode = .parsingFromScratch,
+         partitionCount: Int = 1,
+         cancellationToken: PlaylistParserCancellationToken? = nil,
          success: @escaping ParserSuccess,
          failure: @escaping ParserFailure) {
         
-        self.playlistMemoryStorage = StaticMemoryStorage(data: data)
+        self.playlistMemoryStorage = playlistMemoryStorage
         self.parser = parser
         self.registeredPlaylistTags = registeredPlaylistTags
         self.parserMode = parserMode
+        self.partitionCount = partitionCount
+        self.cancellationToken = cancellationToken
+        self.deferTagValueParsing = parser.deferTagValueParsing
         self.success = success
         self.failure = failure
     }
     
     func startParse() {
-        fastParser.parseHLSData(self.playlistMemoryStorage, callback: self)
-    }
-    
-    private func scrubMambaStringRef(_ ref: MambaStringRef) -> MambaStringRef {
         switch self.parserMode {
         case .parsingFromScratch:
-            return ref
-        case .parsingEventPlaylistLookingForFragmentURL(_):
-            // if we are parsing through an Event update, we want to only keep the original `Data` from the first parse
-            // so we convert new updates to strings. This is an optimistic assumption that we only have a few
-            // updated tags and the cost of converting the small number to strings will be small.
-            return MambaStringRef(string: ref.stringValue())
+            fastParser.cancellation = cancellationToken?.rapidParserCancellation
+            fastParser.parseHLSData(toLineRecords: self.playlistMemoryStorage, partitionCount: UInt(partitionCount), callback: self)
+        case .parsingIncrementally:
+            fastParser.beginIncrementalParse(withCallback: self)
         }
     }
     
-    // MARK: RapidParserCallback
-    
-    func addedCommentLine(_ comment: MambaStringRef) {
-        tags.append(PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: scrubMambaStringRef(comment)))
+    /**
+     Parses on the calling thread. `success` or `failure` has been called by the time this returns.
+     
+     The parent parser does not keep track of inline workers, so there is nothing to tell it when we are done.
+     */
+    func parseInline() {
+        assert(parserMode == .parsingFromScratch, "Only a parse from scratch can be run inline")
+        parser = nil
+        fastParser.cancellation = cancellationToken?.rapidParserCancellation
+        fastParser.parseHLSDataToLineRecordsSynchronously(playlistMemoryStorage, partitionCount: UInt(partitionCount), callback: self)
     }
     
-    func addedURLLine(_ url: MambaStringRef) -> Bool {
-        switch self.parserMode {
-        case .parsingFromScratch:
-            tags.append(PlaylistTag(tagDescriptor: PantosTag.Location, tagData: url))
-            return true
-        case .parsingEventPlaylistLookingForFragmentURL(let alreadyParsedFragmentURL):
-            let urlString = url.stringValue()
-            if alreadyParsedFragmentURL == urlString {
-                if let error = parseError {
-                    parseFail(error: error)
-                }
-                else {
-                    parseEventUpdateSuccess()
-                }
-                return false
-            }
-            tags.append(PlaylistTag(tagDescriptor: PantosTag.Location, tagData: MambaStringRef(string: urlString)))
-            return true
-        }
+    func feedIncrementalParse(_ data: Data) -> Bool {
+        return fastParser.feedIncrementalParse(data)
     }
     
-    func addedNoValueTag(withName tagName: MambaStringRef) {
-        let descriptor = tagDescriptor(forTagName: tagName)
-        guard descriptor != PantosTag.UnknownTag else {
-            // special case handling for unknown tags
-            tags.append(PlaylistTag(tagDescriptor: descriptor, tagData: MambaStringRef(), tagName: scrubMambaStringRef(tagName)))
-            return
-        }
-        guard descriptor.type() == .noValue else {
-            parseError = PlaylistParserError.mismatchBetweenTagDescriptorAndTagData(description:"The PlaylistTag and the data contained within do not match: tagName:\"\(tagName.stringValue())\" tagValue:<no tag value> descriptor:\(descriptor)")
-            return
-        }
-        tags.append(PlaylistTag(tagDescriptor: descriptor, tagData: MambaStringRef(), tagName: scrubMambaStringRef(tagName)))
+    func finishIncrementalParse(withStorage storage: StaticMemoryStorage) {
+        // the line records are offsets into all the data fed so far, which the caller has collected into `storage`
+        playlistMemoryStorage = storage
+        fastParser.finishIncrementalParse()
     }
     
-    func addedTag(withName tagName: MambaStringRef, value: MambaStringRef) {
-        
-        let descriptor = tagDescriptor(forTagName: tagName)
-        guard descriptor.type() != .noValue else {
-            parseError = PlaylistParserError.mismatchBetweenTagDescriptorAndTagData(description:"The PlaylistTag and the data contained within do not match: tagName:\"\(tagName.stringValue())\" tagValue:\"\(value.stringValue())\" descriptor:\(descriptor)")
-            return
-        }
+    // MARK: RapidParserLineRecordCallback
+    
+    func parsedLineRecords(_ records: UnsafePointer<RapidParserLineRecord>, count: UInt) {
         
-        guard descriptor != PantosTag.UnknownTag else {
-            // special case handling for unknown tags
-            tags.append(PlaylistTag(tagDescriptor: descriptor, tagData: scrubMambaStringRef(value), tagName: scrubMambaStringRef(tagName)))
-            return
-        }
+        let lineRecords = UnsafeBufferPointer(start: records, count: Int(count))
         
-        guard let parsedValues = parseTags(tagValue: value, descriptor: descriptor) else {
-            // the `parseTags` function already set a `parseError` error object for us
-            return
+        if let bytes = playlistMemoryStorage.bytes?.assumingMemoryBound(to: CChar.self) {
+            
+            // spans point into `playlistMemoryStorage`, so building tags from line records allocates no strings
+            func span(start: UInt64, length: UInt64) -> MambaStringSpan {
+                return MambaStringSpan(bytes: bytes + Int(start), length: Int(length))
+            }
+            
+            func duration(fromLineRecord record: RapidParserLineRecord) -> CMTime {
+                switch record.durationTicks {
+                case Int64(RapidParserLineRecordDurationNotDecoded):
+                    return span(start: record.durationStart, length: record.durationLength).extinfSegmentDuration()
+                case Int64(RapidParserLineRecordDurationInvalid):
+                    return CMTime.invalid
+                default:
+                    return CMTimeMake(value: record.durationTicks, timescale: CMTimeScale(mamba_EXTINFDurationTimescale))
+                }
+            }
+            
+            func parsedLine(fromLineRecord record: RapidParserLineRecord) -> ParsedLine {
+                switch record.kind {
+                case .tag:
+                    return parsedTag(withName: .span(span(start: record.nameStart, length: record.nameLength)),
+                                     value: .span(span(start: record.dataStart, length: record.dataLength)),
+                                     tagID: record.tagID)
+                case .noDataTag:
+                    return parsedNoValueTag(withName: .span(span(start: record.nameStart, length: record.nameLength)), tagID: record.tagID)
+                case .extinfTag:
+                    return .tag(PlaylistTag(tagDescriptor: PantosTag.EXTINF,
+                                            tagData: .span(span(start: record.dataStart, length: record.dataLength)),
+                                            tagName: .span(span(start: record.nameStart, length: record.nameLength)),
+                                            duration: duration(fromLineRecord: record)))
+                case .comment:
+                    return .tag(PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: .span(span(start: record.dataStart, length: record.dataLength)), tagName: nil))
+                case .url:
+                    return .tag(PlaylistTag(tagDescriptor: PantosTag.Location, tagData: .span(span(start: record.dataStart, length: record.dataLength)), tagName: nil))
+                @unknown default:
+                    assertionFailure("Found unknown line record kind \(record.kind.rawValue)")
+                    return .error(.unknown(description: "Found unknown line record kind \(record.kind.rawValue)"))
+                }
+            }
+            
+            switch self.parserMode {
+            case .parsingIncrementally:
+                // the incremental parser scans forwards, so the records are already in document order
+                tags.reserveCapacity(lineRecords.count)
+                lineRecords.forEach { add(parsedLine(fromLineRecord: $0)) }
+            case .parsingFromScratch where partitionCount > 1:
+                addConcurrently(backwardsLineRecords: lineRecords, parsedLine: parsedLine(fromLineRecord:))
+            case .parsingFromScratch:
+                // the parser scans backwards, so walking the records in reverse gives us tags in document order
+                tags.reserveCapacity(lineRecords.count)
+                for (documentIndex, record) in lineRecords.reversed().enumerated() {
+                    if documentIndex % ParseWorker.cancellationCheckInterval == 0, let error = cancellationToken?.stopError {
+                        if parseError == nil {
+                            parseError = error
+                        }
+                        break
+                    }
+                    add(parsedLine(fromLineRecord: record))
+                }
+            }
         }
         
-        tags.append(PlaylistTag(tagDescriptor: descriptor, tagData: scrubMambaStringRef(value), tagName: scrubMambaStringRef(tagName), parsedValues: parsedValues))
-    }
-    
-    func addedEXTINFTag(withName tagName: MambaStringRef, duration: MambaStringRef, value: MambaStringRef) {
-        tags.append(PlaylistTag(tagDescriptor: PantosTag.EXTINF, tagData: scrubMambaStringRef(value), tagName: scrubMambaStringRef(tagName), duration: duration.extinfSegmentDuration()))
-    }
-    
-    func parseComplete() {
         if let error = parseError {
             parseFail(error: error)
         }
         else {
-            if let lastTag = tags.last {
-                if lastTag.tagDescriptor == PantosTag.EXTM3U {
-                    tags.removeLast()
+            if let firstTag = tags.first {
+                if firstTag.tagDescriptor == PantosTag.EXTM3U {
+                    tags.removeFirst()
                 }
             }
-            tags = tags.reversed()
             
             parseSucceed(tags: tags)
         }
@@ -668,6 +1078,12 @@ fileprivate final class ParseWorker: NSObject, RapidParserCallback {
         case PlaylistParserInternalErrorCode.missingTagDataForEXTINF.rawValue:
             parsererror = .missingTagDataForEXTINF(description:error)
             break
+        case PlaylistParserInternalErrorCode.cancelled.rawValue:
+            parsererror = .cancelled
+            break
+        case PlaylistParserInternalErrorCode.timedOut.rawValue:
+            parsererror = .timedOut
+            break
         default:
             assertionFailure("Found unknown error code \"\(errorNumber)\" with error string \"\(error)\" in parseError.ParseWorker")
             parsererror = .unknown(description:"\(errorNumber): \(error)")
@@ -678,7 +1094,72 @@ fileprivate final class ParseWorker: NSObject, RapidParserCallback {
     
     // MARK: Parser Helpers
     
+    private func add(_ line: ParsedLine) {
+        switch line {
+        case .tag(let tag):
+            tags.append(tag)
+        case .error(let error):
+            // the first malformed line in the document is the one we report
+            if parseError == nil {
+                parseError = error
+            }
+        }
+    }
+    
+    /**
+     Builds tags from line records on `partitionCount` threads at once. Each thread takes a contiguous slice of
+     the playlist, and the slices are joined in order, so the result is identical to a serial `add` of each line.
+     */
+    private func addConcurrently(backwardsLineRecords lineRecords: UnsafeBufferPointer<RapidParserLineRecord>,
+                                 parsedLine: (RapidParserLineRecord) -> ParsedLine) {
+        
+        let count = lineRecords.count
+        let sliceCount = max(min(partitionCount, count), 1)
+        var sliceTags = [[PlaylistTag]](repeating: [], count: sliceCount)
+        var sliceErrors = [PlaylistParserError?](repeating: nil, count: sliceCount)
+        
+        sliceTags.withUnsafeMutableBufferPointer { sliceTagsBuffer in
+            sliceErrors.withUnsafeMutableBufferPointer { sliceErrorsBuffer in
+                DispatchQueue.concurrentPerform(iterations: sliceCount) { slice in
+                    let documentIndexes = (count * slice / sliceCount)..<(count * (slice + 1) / sliceCount)
+                    var tags = [PlaylistTag]()
+                    tags.reserveCapacity(documentIndexes.count)
+                    for documentIndex in documentIndexes {
+                        if (documentIndex - documentIndexes.lowerBound) % ParseWorker.cancellationCheckInterval == 0,
+                            let error = cancellationToken?.stopError {
+                            if sliceErrorsBuffer[slice] == nil {
+                                sliceErrorsBuffer[slice] = error
+                            }
+                            break
+                        }
+                        // the records are last line first
+                        switch parsedLine(lineRecords[count - 1 - documentIndex]) {
+                        case .tag(let tag):
+                            tags.append(tag)
+                        case .error(let error):
+                            if sliceErrorsBuffer[slice] == nil {
+                                sliceErrorsBuffer[slice] = error
+                            }
+                        }
+                    }
+                    sliceTagsBuffer[slice] = tags
+                }
+            }
+        }
+        
+        tags.reserveCapacity(count)
+        for slice in sliceTags {
+            tags.append(contentsOf: slice)
+        }
+        // a serial parse keeps the first error it finds
+        if let error = sliceErrors.compactMap({ $0 }).first {
+            parseError = error
+        }
+    }
+    
     private func parseFail(error: PlaylistParserError) {
+        // a cancelled parse may have built some tags, which nobody will use
+        tags = []
         failure(error)
         parser?.parseComplete(withWorker: self)
         parser = nil
@@ -690,39 +1171,70 @@ fileprivate final class ParseWorker: NSObject, RapidParserCallback {
         parser = nil
     }
     
-    private func parseEventUpdateSuccess() {
-        tags = tags.reversed()
-        success(tags, playlistMemoryStorage)
-        parser?.parseComplete(withWorker: self)
-        parser = nil
+    private func parsedNoValueTag(withName tagName: PlaylistTagString, tagID: UInt8 = UInt8(RapidParserTagIDNone.rawValue)) -> ParsedLine {
+        let descriptor = tagDescriptor(forTagName: tagName, tagID: tagID)
+        guard descriptor != PantosTag.UnknownTag else {
+            // special case handling for unknown tags
+            return .tag(PlaylistTag(tagDescriptor: descriptor, tagData: PlaylistTagString.empty, tagName: tagName))
+        }
+        guard descriptor.type() == .noValue else {
+            return .error(PlaylistParserError.mismatchBetweenTagDescriptorAndTagData(description:"The PlaylistTag and the data contained within do not match: tagName:\"\(tagName.stringValue())\" tagValue:<no tag value> descriptor:\(descriptor)"))
+        }
+        return .tag(PlaylistTag(tagDescriptor: descriptor, tagData: PlaylistTagString.empty, tagName: tagName))
     }
     
-    private func parseTags(tagValue: MambaStringRef, descriptor: PlaylistTagDescriptor) -> PlaylistTagDictionary? {
+    private func parsedTag(withName tagName: PlaylistTagString, value: PlaylistTagString, tagID: UInt8 = UInt8(RapidParserTagIDNone.rawValue)) -> ParsedLine {
         
-        let parser = registeredPlaylistTags.parser(forTag: descriptor)
-        let tagBody = tagValue.stringValue()
-        do {
-            return try parser.parseTag(fromTagString: tagBody)
+        let descriptor = tagDescriptor(forTagName: tagName, tagID: tagID)
+        guard descriptor.type() != .noValue else {
+            return .error(PlaylistParserError.mismatchBetweenTagDescriptorAndTagData(description:"The PlaylistTag and the data contained within do not match: tagName:\"\(tagName.stringValue())\" tagValue:\"\(value.stringValue())\" descriptor:\(descriptor)"))
         }
-        catch let error as PlaylistParserError {
-            parseError = error
+        
+        guard descriptor != PantosTag.UnknownTag else {
+            // special case handling for unknown tags
+            return .tag(PlaylistTag(tagDescriptor: descriptor, tagData: value, tagName: tagName))
         }
-        catch {
-            parseError = PlaylistParserError.unknown(description:"Unknown error: \"\(error)\" while parsing tag \"\(descriptor.toString())\" with body \"\(String(describing: tagValue))\"")
+        
+        if deferTagValueParsing {
+            return .tag(PlaylistTag(tagDescriptor: descriptor,
+                                    tagData: value,
+                                    tagName: tagName,
+                                    deferredValuesParser: registeredPlaylistTags.parser(forTag: descriptor)))
+        }
+        
+        switch parseTags(tagValue: value, descriptor: descriptor) {
+        case .success(let parsedValues):
+            return .tag(PlaylistTag(tagDescriptor: descriptor, tagData: value, tagName: tagName, parsedValues: parsedValues))
+        case .failure(let error):
+            return .error(error)
         }
-        return nil
+    }
+    
+    private func parseTags(tagValue: PlaylistTagString, descriptor: PlaylistTagDescriptor) -> Result<PlaylistTagDictionary, PlaylistParserError> {
+        
+        return PlaylistTagValuesParsing.parse(tagData: tagValue, tagDescriptor: descriptor, parser: registeredPlaylistTags.parser(forTag: descriptor))
     }
     
     private var parseError: PlaylistParserError? = nil
     
-    private func tagDescriptor(forTagName name: MambaStringRef) -> PlaylistTagDescriptor {
-        if let descriptor = registeredPlaylistTags.tagDescriptor(fromStringRef: name) {
+    private func tagDescriptor(forTagName name: PlaylistTagString, tagID: UInt8) -> PlaylistTagDescriptor {
+        // `PantosTag` is always registered first, so a name the rapid parser recognized needs no registry lookup
+        if let descriptor = PantosTag.descriptor(forRapidParserTagID: tagID) {
+            return descriptor
+        }
+        if let descriptor = registeredPlaylistTags.tagDescriptor(fromStringRef: name.stringRef) {
             return descriptor
         }
         return PantosTag.UnknownTag
     }
 }
 
+/// The tag, or the error, that a `ParseWorker` found for one line of a playlist
+private enum ParsedLine {
+    case tag(PlaylistTag)
+    case error(PlaylistParserError)
+}
+
 /// The mode that this worker is set to run
 private enum ParseWorkerMode {
     
@@ -734,24 +1246,12 @@ private enum ParseWorkerMode {
     case parsingFromScratch
     
     /**
-     "Event style variant" efficiency mode.
-     
-     With event style variant playlists, new fragments are added at the end of the playlist. Any fragments already sent are unchanged.
-     This is a HLS spec requirement. <https://tools.ietf.org/html/draft-pantos-hls-rfc8216bis-03#section-6.2.1>
-     
-     If you are parsing a event playlist that is hours long, it's a lot of work to parse a bunch of identical content over and over
-     for each playlist update.
+     Incremental mode.
      
-     This mode sets the parse worker to look for the last fragment url that we found in the last update. Once found, we stop
-     parsing and return all the "new" tags. (Note that any tags in the "footer" will be reparsed every time).
-     
-     Further note that we actually allocate real memory for all tag strings that is not tied to the `Data` object that we are
-     parsing. It would become unworkable to keep track of the innumerable updates and which memory belongs to which `Data`.
-     
-     It's up to our parent Parser to set this mode with an eye towards performance and memory usage, and to deal with the
-     returned tags appropriately to construct a valid playlist.
+     The playlist is fed to the worker in chunks as it arrives and scanned forwards, so tags are found in document order.
+     See `IncrementalPlaylistParse`.
      */
-    case parsingEventPlaylistLookingForFragmentURL(fragmentURL: String)
+    case parsingIncrementally
 }
 
 /**
@@ -784,10 +1284,116 @@ public struct UpdateEventPlaylistParams {
      smaller.
      */
     let maximumAmountOfTimeBetweenUpdatesToTrigger: TimeInterval
+    
+    /**
+     Each update keeps the storage of the playlist it updates alive (see `StaticMemoryStorage.precedingStorage`).
+     If the playlist to be updated already continues this many storages, `Parser` will do a complete parse,
+     which copies the whole playlist into a single storage and starts a new chain.
+
+     Why? Finding which bytes are new and releasing the playlist both walk the chain, so a long
+     running event would otherwise get slower to update with every update.
+
+     The default value is 8.
+     */
+    let maximumPrecedingStorageCount: Int
 
     public init(minimalBytesToTriggerUpdate: Int = 20000,
-                maximumAmountOfTimeBetweenUpdatesToTrigger: TimeInterval = 60) {
+                maximumAmountOfTimeBetweenUpdatesToTrigger: TimeInterval = 60,
+                maximumPrecedingStorageCount: Int = 8) {
         self.minimalBytesToTriggerUpdate = minimalBytesToTriggerUpdate
         self.maximumAmountOfTimeBetweenUpdatesToTrigger = maximumAmountOfTimeBetweenUpdatesToTrigger
+        self.maximumPrecedingStorageCount = maximumPrecedingStorageCount
+    }
+}
+
+/**
+ Parameters for parsing large playlists on multiple threads. Pass to `PlaylistParser.init` to opt in.
+ 
+ The playlist is split at line boundaries into partitions which are scanned, and have their `PlaylistTag`s
+ built, concurrently. The resulting playlist is identical to a single threaded parse.
+ 
+ Thread startup has a cost, so small playlists are always parsed on a single thread.
+ */
+public struct ParallelParsePlaylistParams {
+    /**
+     The smallest partition of a playlist we will hand to a thread. Playlists smaller than twice this size
+     are parsed on a single thread.
+     
+     The default value is 256 KB, which is roughly 2000 segments.
+     */
+    let minimalBytesPerPartition: Int
+    
+    /**
+     The maximum number of threads to parse on.
+     
+     The default value is the number of active processors.
+     */
+    let maximumPartitionCount: Int
+    
+    public init(minimalBytesPerPartition: Int = 256 * 1024,
+                maximumPartitionCount: Int = ProcessInfo.processInfo.activeProcessorCount) {
+        self.minimalBytesPerPartition = max(minimalBytesPerPartition, 1)
+        self.maximumPartitionCount = max(maximumPartitionCount, 1)
+    }
+    
+    func partitionCount(forPlaylistLength length: Int) -> Int {
+        return max(min(length / minimalBytesPerPartition, maximumPartitionCount), 1)
+    }
+}
+
+/**
+ Cancels a parse, or stops it at a deadline. Pass to `PlaylistParser.parse(playlistData:url:cancellationToken:callback:)`
+ or one of the other asynchronous parse methods.
+ 
+ The parser checks the token every few kilobytes of playlist it scans, and every few thousand tags it builds,
+ so a parse stops soon after `cancel()` is called or the deadline passes, and the memory it was using is
+ released right away. The parse then fails with an `unknown` error whose `isCancelled` is true, or a
+ `timedOut` error if the deadline passed.
+ 
+ A token may be shared by any number of parses, and `cancel()` may be called from any thread.
+ */
+public final class PlaylistParserCancellationToken {
+    
+    let rapidParserCancellation: RapidParserCancellation
+    
+    /**
+     Constructs a token.
+     
+     - parameter deadline: An optional time after which any parse using this token fails with a `timedOut`
+     error. There is no deadline if this is nil (the default).
+     */
+    public init(deadline: DispatchTime? = nil) {
+        if let deadline = deadline {
+            rapidParserCancellation = RapidParserCancellation(deadline: deadline.rawValue)
+        }
+        else {
+            rapidParserCancellation = RapidParserCancellation()
+        }
+    }
+    
+    convenience init(timeout: Int) {
+        self.init(deadline: DispatchTime.now() + DispatchTimeInterval.seconds(timeout))
+    }
+    
+    /// Stops all parses using this token. Calling this more than once has no further effect.
+    public func cancel() {
+        rapidParserCancellation.cancel()
+    }
+    
+    /// True once `cancel()` has been called.
+    public var isCancelled: Bool {
+        return rapidParserCancellation.isCancelled
+    }
+    
+    /// The error a parse using this token should stop with, or nil if it should carry on.
+    var stopError: PlaylistParserError? {
+        switch Int(rapidParserCancellation.stopErrorNumber()) {
+        case 0:
+            return nil
+        case PlaylistParserInternalErrorCode.timedOut.rawValue:
+            return .timedOut
+        default:
+            return .cancelled
+        }
     }
 }
@@ -30,9 +30,28 @@ public enum PlaylistParserError: Error {
     case unexpectedPlaylistType
 }
 
+extension PlaylistParserError {
+    
+    /// The description of the `unknown` error that a parse fails with when its `PlaylistParserCancellationToken` is cancelled
+    static let cancelledDescription = "The parse was cancelled"
+    
+    /// The error that a parse fails with when its `PlaylistParserCancellationToken` is cancelled
+    static let cancelled = PlaylistParserError.unknown(description: cancelledDescription)
+    
+    /// True if this is the error that a parse fails with when its `PlaylistParserCancellationToken` is cancelled
+    public var isCancelled: Bool {
+        guard case .unknown(let description) = self else {
+            return false
+        }
+        return description == PlaylistParserError.cancelledDescription
+    }
+}
+
 /// This enum is present to share error codes between the C Rapid Parser layer and
 /// the Swift PlaylistParser layer.
 @objc public enum PlaylistParserInternalErrorCode: Int {
     case missingTagData = 101
     case missingTagDataForEXTINF = 102
+    case cancelled = 103
+    case timedOut = 104
 }
@@ -79,6 +79,44 @@ public protocol PlaylistTagDescriptor {
     static func constructDescriptor(fromStringRef: MambaStringRef) -> PlaylistTagDescriptor?
 }
 
+/**
+ A `PlaylistTagDescriptor` type that can list every descriptor it describes.
+ 
+ `RegisteredPlaylistTags` asks these types for their parsers, writers and validators once, when they are
+ registered, and shares those instances between all tags. Other descriptor types are asked again for every tag.
+ So the factory methods of an enumerable type must return instances that are safe to share between threads.
+ */
+public protocol PlaylistTagDescriptorEnumerable: PlaylistTagDescriptor {
+    
+    /// Every descriptor of this type
+    static var allTagDescriptors: [PlaylistTagDescriptor] { get }
+}
+
+/**
+ A `Hashable` stand-in for a `PlaylistTagDescriptor`, for use as a dictionary key.
+ 
+ A `PantosTag` is keyed by its `tagIndex`, so making and hashing its key does not build a `String`. Other
+ descriptors are keyed by their type and `toString()`.
+ */
+struct PlaylistTagDescriptorKey: Hashable {
+    
+    private enum Storage: Hashable {
+        case pantos(Int)
+        case other(descriptorType: ObjectIdentifier, name: String)
+    }
+    
+    private let storage: Storage
+    
+    init(_ tagDescriptor: PlaylistTagDescriptor) {
+        if let pantos = tagDescriptor as? PantosTag {
+            storage = .pantos(pantos.tagIndex)
+        }
+        else {
+            storage = .other(descriptorType: ObjectIdentifier(type(of: tagDescriptor)), name: tagDescriptor.toString())
+        }
+    }
+}
+
 public func ==(lhs: PlaylistTagDescriptor, rhs: PlaylistTagDescriptor) -> Bool {
     return lhs.isEqual(toTagDescriptor:rhs)
 }
@@ -47,3 +47,18 @@ public protocol PlaylistTagParser: AnyObject {
      */
     func parseTag(fromTagString: String?) throws -> PlaylistTagDictionary
 }
+
+/**
+ A `PlaylistTagParser` that can also parse straight from the UTF-8 bytes of a tag body.
+ 
+ The parser uses this when it is available so that it does not have to create a `String` for every tag body.
+ */
+protocol PlaylistTagUTF8Parser: PlaylistTagParser {
+    
+    /**
+     Parses an playlist tag from the UTF-8 bytes of the tag body. See `parseTag(fromTagString:)`.
+     
+     - parameter fromUTF8Bytes: The bytes to parse. These are only valid for the duration of the call.
+     */
+    func parseTag(fromUTF8Bytes bytes: UnsafeBufferPointer<UInt8>) throws -> PlaylistTagDictionary
+}
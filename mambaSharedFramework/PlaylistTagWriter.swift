@@ -35,6 +35,32 @@ public protocol PlaylistTagWriter {
     func write(tag: PlaylistTag, toStream: OutputStream) throws
 }
 
+/**
+ A `PlaylistTagWriter` that can also write tags straight into the buffer of a `PlaylistWriter`.
+ 
+ The writer uses this when it is available, so that it does not have to write each tag through an `OutputStream`.
+ */
+protocol PlaylistTagBufferWriter: PlaylistTagWriter {
+    
+    /**
+     Writes the data of the tag to the provided buffer. See `write(tag:toStream:)`.
+     */
+    func write(tag: PlaylistTag, toBuffer buffer: PlaylistWriteBuffer) throws
+}
+
+extension PlaylistTagBufferWriter {
+    
+    /**
+     Writes the tag to a stream through `write(tag:toBuffer:)`, so that a buffer writer has just one
+     implementation for both. Use it to implement `write(tag:toStream:)`.
+     */
+    func writeThroughBuffer(tag: PlaylistTag, toStream stream: OutputStream) throws {
+        let buffer = PlaylistWriteBuffer(capacity: 0, destination: .stream(stream))
+        try write(tag: tag, toBuffer: buffer)
+        try buffer.flush()
+    }
+}
+
 internal struct PlaylistTagWritingSeparators {
     static let hash = UnicodeScalar("#")
     static let colon = UnicodeScalar(":")
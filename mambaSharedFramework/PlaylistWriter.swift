@@ -19,6 +19,10 @@
 
 import Foundation
 
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
 /// Class responsible for writing in memory HLS playlists to concrete playlists suitable for streaming or other parsers
 public class PlaylistWriter {
     
@@ -41,34 +45,148 @@ public class PlaylistWriter {
     /// Writes a object implementing `PlaylistInterface` object to a stream. Caller is assumed to be responsible for opening and closing this stream.
     public func write(playlist: PlaylistInterface, toStream stream: OutputStream) throws {
         
+        let buffer = PlaylistWriteBuffer(capacity: min(estimatedLength(ofPlaylist: playlist), PlaylistWriteBuffer.blockSize * 2),
+                                         destination: .stream(stream))
+        try write(playlist: playlist, toBuffer: buffer)
+        try buffer.flush()
+    }
+    
+    /**
+     Writes a object implementing `PlaylistInterface` object to a file descriptor (for example, an open file or socket).
+     Caller is assumed to be responsible for opening and closing this file descriptor.
+     */
+    public func write(playlist: PlaylistInterface, toFileDescriptor fileDescriptor: Int32) throws {
+        
+        let buffer = PlaylistWriteBuffer(capacity: min(estimatedLength(ofPlaylist: playlist), PlaylistWriteBuffer.blockSize * 2),
+                                         destination: .fileDescriptor(fileDescriptor))
+        try write(playlist: playlist, toBuffer: buffer)
+        try buffer.flush()
+    }
+    
+    public func write(playlist: PlaylistInterface) throws -> Data {
+        return try write(tagSource: playlist)
+    }
+    
+    /// Writes anything with tags and the registered tags to write them with, such as a `FrozenPlaylist`.
+    func write(tagSource: PlaylistWriterTagSource) throws -> Data {
+        
+        // we build the `Data` in place, so it is sized to hold the whole playlist up front
+        let buffer = PlaylistWriteBuffer(capacity: estimatedLength(ofPlaylist: tagSource))
+        try write(playlist: tagSource, toBuffer: buffer)
+        return buffer.takeData()
+    }
+
+    public func write(playlist: PlaylistInterface) throws -> String {
+        let data: Data = try write(playlist: playlist)
+        guard let string = String(data: data, encoding: .utf8) else {
+            throw OutputStreamError.invalidData(description: "Writing playlist fialure: unable to convert to utf8 coded string")
+        }
+        return string
+    }
+    
+    /**
+     Writes the playlist into `buffer`. The caller must flush whatever is left in the buffer afterwards.
+     
+     Runs of unedited tags that are still next to each other in the memory we parsed them from are
+     written out as one block of the original bytes. Only edited or inserted tags are serialized.
+     */
+    private func write(playlist: PlaylistWriterTagSource, toBuffer buffer: PlaylistWriteBuffer) throws {
+        
         // write initial #EXTM3U
-        try write(string: PantosTag.EXTM3U.toString(), toStream: stream)
+        try write(string: PantosTag.EXTM3U.toString(), toBuffer: buffer)
         
         // write HLS comments to identify ourselves
         if let identityString = identityString {
-            try write(string: identityString, toStream: stream)
+            try write(string: identityString, toBuffer: buffer)
         }
         if !suppressMambaIdentityString {
-            try write(string: " Generated by Mamba(\(FrameworkInfo.version)) Copyright (c) 2017 Comcast Corporation", toStream: stream)
+            try write(string: " Generated by Mamba(\(FrameworkInfo.version)) Copyright (c) 2017 Comcast Corporation", toBuffer: buffer)
+        }
+        
+        // the original bytes of the unedited tags we have not written yet
+        var run: (start: UnsafePointer<UInt8>, end: UnsafePointer<UInt8>)? = nil
+        
+        func writeRun() throws {
+            guard let bytes = run else {
+                return
+            }
+            try buffer.append(passthrough: UnsafeBufferPointer(start: bytes.start, count: bytes.end - bytes.start))
+            try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.newline)
+            run = nil
         }
         
         // write tags
-        for tag in playlist.tags {
+        for tag in playlist.tagCollection {
+            if !tag.isDirty, let original = PlaylistWriter.originalBytes(ofTag: tag) {
+                if let bytes = run, original.start == bytes.end + 1, bytes.end.pointee == PlaylistWriter.newlineByte {
+                    run = (bytes.start, original.end)
+                }
+                else {
+                    try writeRun()
+                    run = original
+                }
+                continue
+            }
+            
+            try writeRun()
             if tag.isDirty {
                 guard let writer = playlist.registeredPlaylistTags.writer(forTag: tag.tagDescriptor) else {
                     throw PlaylistWriterError.invalidPlaylist(description: "Cannot write dirty tag with unknown descriptor: \(tag.tagDescriptor.toString())")
                 }
-                try writer.write(tag: tag, toStream: stream)
+                try write(tag: tag, withWriter: writer, toBuffer: buffer)
             }
             else {
-                try GenericTagWriter.write(tag: tag, toStream: stream)
+                try GenericTagWriter.write(tag: tag, toBuffer: buffer)
             }
-            try stream.write(unicodeScalar: PlaylistTagWritingSeparators.newline)
+            try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.newline)
+            try buffer.flushIfFull()
         }
+        try writeRun()
     }
     
-    public func write(playlist: PlaylistInterface) throws -> Data {
+    /**
+     The bytes of an unedited tag in the memory it was parsed from, if they are exactly what `GenericTagWriter`
+     would write for it (the tag name, a colon and the tag data, or just one of name and data).
+     */
+    private static func originalBytes(ofTag tag: PlaylistTag) -> (start: UnsafePointer<UInt8>, end: UnsafePointer<UInt8>)? {
         
+        // only the parser creates spans, and it creates them pointing into the playlist memory
+        guard case .span(let data) = tag.tagDataString else {
+            return nil
+        }
+        let dataBytes = data.bytes.map { UnsafeRawPointer($0).assumingMemoryBound(to: UInt8.self) }
+        
+        guard let tagName = tag.tagNameString, tagName.length > 0 else {
+            // comments and locations
+            guard let dataBytes = dataBytes else {
+                return nil
+            }
+            return (dataBytes, dataBytes + data.length)
+        }
+        guard case .span(let name) = tagName, let nameBytes = name.bytes.map({ UnsafeRawPointer($0).assumingMemoryBound(to: UInt8.self) }) else {
+            return nil
+        }
+        guard let startOfData = dataBytes else {
+            return (nameBytes, nameBytes + name.length)
+        }
+        let endOfName = nameBytes + name.length
+        guard startOfData == endOfName + 1, endOfName.pointee == PlaylistWriter.colonByte else {
+            return nil
+        }
+        return (nameBytes, startOfData + data.length)
+    }
+    
+    private static let newlineByte = UInt8(ascii: PlaylistTagWritingSeparators.newline)
+    private static let colonByte = UInt8(ascii: PlaylistTagWritingSeparators.colon)
+    
+    private func write(tag: PlaylistTag, withWriter writer: PlaylistTagWriter, toBuffer buffer: PlaylistWriteBuffer) throws {
+        
+        if let bufferWriter = writer as? PlaylistTagBufferWriter {
+            try bufferWriter.write(tag: tag, toBuffer: buffer)
+            return
+        }
+        
+        // custom writers only know how to write to a stream
         let stream = OutputStream.toMemory()
         stream.open()
         
@@ -76,32 +194,45 @@ public class PlaylistWriter {
             stream.close()
         }
         
-        try write(playlist: playlist, toStream: stream)
+        try writer.write(tag: tag, toStream: stream)
         if let error = stream.streamError {
             throw OutputStreamError.couldNotWriteToStream(error as NSError)
         }
-        guard let data = stream.property(forKey: .dataWrittenToMemoryStreamKey) as? Data else {
-            assertionFailure("This method is expected to always return an NSData instance. Update this code to throw a more descriptive error.")
-            throw OutputStreamError.couldNotWriteToStream(nil)
+        if let data = stream.property(forKey: .dataWrittenToMemoryStreamKey) as? Data {
+            buffer.append(data: data)
         }
-        return data
     }
 
-    public func write(playlist: PlaylistInterface) throws -> String {
-        let data: Data = try write(playlist: playlist)
-        guard let string = String(data: data, encoding: .utf8) else {
-            throw OutputStreamError.invalidData(description: "Writing playlist fialure: unable to convert to utf8 coded string")
-        }
-        return string
+    private func write(string: String, toBuffer buffer: PlaylistWriteBuffer) throws {
+        
+        try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.hash)
+        buffer.append(string: string)
+        try buffer.append(unicodeScalar: PlaylistTagWritingSeparators.newline)
     }
-
-    private func write(string: String, toStream stream: OutputStream) throws {
+    
+    /**
+     Our best guess at the length of the written playlist, so that we rarely have to grow our buffer. Unedited
+     playlists are written out byte for byte, so this is usually the length of the playlist we parsed.
+     */
+    private func estimatedLength(ofPlaylist playlist: PlaylistWriterTagSource) -> Int {
+        
+        let identityLength = (identityString?.utf8.count ?? 0) + PlaylistWriter.identityCommentLengthEstimate
         
-        try stream.write(unicodeScalar: PlaylistTagWritingSeparators.hash)
-        try stream.write(string: string)
-        try stream.write(unicodeScalar: PlaylistTagWritingSeparators.newline)
+        guard let playlistMemoryStorage = (playlist as? PlaylistMemoryStorageSource)?.playlistMemoryStorage,
+            playlistMemoryStorage.documentLength > 0 else {
+                return playlist.tagCollection.count * PlaylistWriter.tagLengthEstimate + identityLength
+        }
+        // leave a little room for edits
+        let documentLength = Int(playlistMemoryStorage.documentLength)
+        return documentLength + documentLength / 16 + identityLength
     }
     
+    /// A rough guess at the average length of a written tag, for playlists that we did not parse
+    private static let tagLengthEstimate = 48
+    
+    /// A rough guess at the length of the `#EXTM3U` line and our identity comments
+    private static let identityCommentLengthEstimate = 128
+    
     private let identityString: String?
     private let suppressMambaIdentityString: Bool
 }
@@ -111,3 +242,11 @@ public enum PlaylistWriterError: Error {
     case invalidPlaylist(description: String?)
 }
 
+
+/// What `PlaylistWriter` needs to write a playlist: its tags, and the registered tags that know how to write edited ones.
+typealias PlaylistWriterTagSource = PlaylistTagSource & RegisteredPlaylistTagsProvider
+
+/// Playlists that were parsed from a `StaticMemoryStorage`. The writer uses the storage to size its output buffer.
+protocol PlaylistMemoryStorageSource {
+    var playlistMemoryStorage: StaticMemoryStorage { get }
+}
@@ -0,0 +1,221 @@
+//
+//  ChunkedArray.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+
+import Foundation
+
+/**
+ An array that is stored as a list of arrays ("chunks") of up to a few hundred elements each.
+ 
+ As with `Array`, copying a `ChunkedArray` is O(1) and the copies share storage until one of them is changed.
+ Unlike `Array`, changing a copy does not copy every element. It copies the list of chunks and only the chunks
+ that are changed, so many slightly different copies of a large array share most of their memory.
+ 
+ Finding an element by index is O(log n), as the chunk sizes are kept in a `FenwickTree`.
+ */
+struct ChunkedArray<Element> {
+    
+    /// The size of the chunks we build. A chunk is split once it grows past twice this.
+    static var chunkSize: Int {
+        return 256
+    }
+    
+    // there are never any empty chunks
+    private(set) var chunks: [[Element]]
+    private var chunkCounts: FenwickTree
+    
+    /// The number of elements
+    private(set) var count: Int
+    
+    init() {
+        self.init([Element]())
+    }
+    
+    init(_ elements: [Element]) {
+        let chunkSize = ChunkedArray.chunkSize
+        let chunks = stride(from: 0, to: elements.count, by: chunkSize).map {
+            Array(elements[$0..<min($0 + chunkSize, elements.count)])
+        }
+        self.init(chunks: chunks, chunkCounts: FenwickTree(chunks.map { $0.count }), count: elements.count)
+    }
+    
+    private init(chunks: [[Element]], chunkCounts: FenwickTree, count: Int) {
+        self.chunks = chunks
+        self.chunkCounts = chunkCounts
+        self.count = count
+    }
+    
+    var isEmpty: Bool {
+        return count == 0
+    }
+    
+    /// All the elements as an `Array`. This is O(n), unless there is only one chunk.
+    var array: [Element] {
+        if chunks.count == 1 {
+            return chunks[0]
+        }
+        var array = [Element]()
+        array.reserveCapacity(count)
+        for chunk in chunks {
+            array.append(contentsOf: chunk)
+        }
+        return array
+    }
+    
+    subscript(index: Int) -> Element {
+        get {
+            precondition(index >= 0 && index < count, "Index out of range")
+            let (chunk, offset) = position(ofIndex: index)
+            return chunks[chunk][offset]
+        }
+        set {
+            precondition(index >= 0 && index < count, "Index out of range")
+            let (chunk, offset) = position(ofIndex: index)
+            chunks[chunk][offset] = newValue
+        }
+    }
+    
+    mutating func insert(contentsOf elements: [Element], at index: Int) {
+        precondition(index >= 0 && index <= count, "Index out of range")
+        guard !elements.isEmpty else {
+            return
+        }
+        guard !chunks.isEmpty else {
+            self = ChunkedArray(elements)
+            return
+        }
+        // inserting at the end adds to the last chunk
+        let (chunk, offset) = index == count ? (chunks.count - 1, chunks[chunks.count - 1].count) : position(ofIndex: index)
+        
+        chunks[chunk].insert(contentsOf: elements, at: offset)
+        count += elements.count
+        
+        let chunkSize = ChunkedArray.chunkSize
+        guard chunks[chunk].count > chunkSize * 2 else {
+            chunkCounts.add(elements.count, at: chunk)
+            return
+        }
+        let grownChunk = chunks[chunk]
+        chunks.replaceSubrange(chunk...chunk, with: stride(from: 0, to: grownChunk.count, by: chunkSize).map {
+            Array(grownChunk[$0..<min($0 + chunkSize, grownChunk.count)])
+        })
+        chunkCounts = FenwickTree(chunks.map { $0.count })
+    }
+    
+    mutating func removeSubrange(_ range: Range<Int>) {
+        precondition(range.lowerBound >= 0 && range.upperBound <= count, "Range out of range")
+        guard !range.isEmpty else {
+            return
+        }
+        var (chunk, offset) = position(ofIndex: range.lowerBound)
+        let firstChunk = chunk
+        var remaining = range.count
+        while remaining > 0 {
+            let removeCount = min(remaining, chunks[chunk].count - offset)
+            chunks[chunk].removeSubrange(offset..<(offset + removeCount))
+            chunkCounts.add(-removeCount, at: chunk)
+            remaining -= removeCount
+            chunk += 1
+            offset = 0
+        }
+        count -= range.count
+        
+        if chunks[firstChunk..<chunk].contains(where: { $0.isEmpty }) {
+            chunks.removeAll(where: { $0.isEmpty })
+            chunkCounts = FenwickTree(chunks.map { $0.count })
+        }
+    }
+    
+    /// Maps every element, keeping the same chunks.
+    func map<T>(_ transform: (Element) throws -> T) rethrows -> ChunkedArray<T> {
+        return try ChunkedArray<T>(chunks: chunks.map { try $0.map(transform) }, chunkCounts: chunkCounts, count: count)
+    }
+    
+    /**
+     Maps every element, as `map` does, with the chunks split between threads. `transform` must be safe to call
+     from any thread.
+     
+     If `transform` throws, the error from the earliest chunk is thrown.
+     */
+    func concurrentMap<T>(_ transform: (Element) throws -> T) throws -> ChunkedArray<T> {
+        guard chunks.count > 1 else {
+            return try map(transform)
+        }
+        let chunks = self.chunks
+        var mappedChunks = [Result<[T], Error>](repeating: .success([]), count: chunks.count)
+        mappedChunks.withUnsafeMutableBufferPointer { mappedChunksBuffer in
+            DispatchQueue.concurrentPerform(iterations: chunks.count) { chunk in
+                mappedChunksBuffer[chunk] = Result { try chunks[chunk].map(transform) }
+            }
+        }
+        return try ChunkedArray<T>(chunks: mappedChunks.map { try $0.get() }, chunkCounts: chunkCounts, count: count)
+    }
+    
+    /// Makes an iterator over the elements in `range`, which walks the chunks rather than looking up each index.
+    func makeIterator(in range: Range<Int>) -> Iterator {
+        precondition(range.lowerBound >= 0 && range.upperBound <= count, "Range out of range")
+        guard !range.isEmpty else {
+            return Iterator(chunks: chunks, chunk: 0, offset: 0, remaining: 0)
+        }
+        let (chunk, offset) = position(ofIndex: range.lowerBound)
+        return Iterator(chunks: chunks, chunk: chunk, offset: offset, remaining: range.count)
+    }
+    
+    /// The chunk that holds `index`, and where `index` is in that chunk
+    private func position(ofIndex index: Int) -> (chunk: Int, offset: Int) {
+        let chunk = chunkCounts.prefixCount(withSumNotExceeding: index)
+        return (chunk, index - chunkCounts.prefixSum(chunk))
+    }
+}
+
+extension ChunkedArray: Sequence {
+    
+    struct Iterator: IteratorProtocol {
+        
+        private let chunks: [[Element]]
+        private var chunk: Int
+        private var offset: Int
+        private var remaining: Int
+        
+        fileprivate init(chunks: [[Element]], chunk: Int, offset: Int, remaining: Int) {
+            self.chunks = chunks
+            self.chunk = chunk
+            self.offset = offset
+            self.remaining = remaining
+        }
+        
+        mutating func next() -> Element? {
+            guard remaining > 0 else {
+                return nil
+            }
+            let element = chunks[chunk][offset]
+            remaining -= 1
+            offset += 1
+            if offset == chunks[chunk].count {
+                chunk += 1
+                offset = 0
+            }
+            return element
+        }
+    }
+    
+    func makeIterator() -> Iterator {
+        return makeIterator(in: 0..<count)
+    }
+}
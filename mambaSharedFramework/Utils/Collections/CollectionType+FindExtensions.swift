@@ -63,3 +63,29 @@ public extension Collection {
 
 }
 
+
+extension RandomAccessCollection {
+    
+    /**
+     Finds the first index that matches the predicate by binary search. The collection must be partitioned by the
+     predicate, i.e. every element that does not match comes before every element that does.
+     
+     Returns `endIndex` if no element matches.
+     */
+    func partitioningIndex(where predicate: (Element) throws -> Bool) rethrows -> Index {
+        var low = startIndex
+        var count = self.count
+        while count > 0 {
+            let half = count / 2
+            let middle = index(low, offsetBy: half)
+            if try predicate(self[middle]) {
+                count = half
+            }
+            else {
+                low = index(after: middle)
+                count -= half + 1
+            }
+        }
+        return low
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  FenwickTree.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+
+import Foundation
+
+/**
+ A Fenwick tree (or binary indexed tree) over an array of `Int`s.
+ 
+ Adding to a single element and summing a prefix of the elements are both O(log n), where
+ an array would make one of the two O(n).
+ */
+struct FenwickTree {
+    
+    // 1-based, `tree[0]` is unused. `tree[i]` is the sum of the `i & -i` elements ending at element `i - 1`.
+    private var tree: [Int]
+    
+    /// Builds the tree in O(n).
+    init(_ elements: [Int]) {
+        var tree = [Int]()
+        tree.reserveCapacity(elements.count + 1)
+        tree.append(0)
+        tree.append(contentsOf: elements)
+        for index in tree.indices.dropFirst() {
+            let parent = index + (index & -index)
+            if parent < tree.count {
+                tree[parent] += tree[index]
+            }
+        }
+        self.tree = tree
+    }
+    
+    /// The number of elements
+    var count: Int {
+        return tree.count - 1
+    }
+    
+    /// Returns the elements in O(n).
+    var elements: [Int] {
+        var elements = tree
+        for index in elements.indices.dropFirst().reversed() {
+            let parent = index + (index & -index)
+            if parent < elements.count {
+                elements[parent] -= elements[index]
+            }
+        }
+        elements.removeFirst()
+        return elements
+    }
+    
+    /// Adds `delta` to the element at `index`.
+    mutating func add(_ delta: Int, at index: Int) {
+        assert(index >= 0 && index < count, "index out of range")
+        var index = index + 1
+        while index < tree.count {
+            tree[index] += delta
+            index += index & -index
+        }
+    }
+    
+    /// Returns the sum of the first `prefixCount` elements.
+    func prefixSum(_ prefixCount: Int) -> Int {
+        assert(prefixCount >= 0 && prefixCount <= count, "prefix out of range")
+        var index = prefixCount
+        var sum = 0
+        while index > 0 {
+            sum += tree[index]
+            index -= index & -index
+        }
+        return sum
+    }
+    
+    /**
+     Returns the length of the longest prefix whose sum is less than or equal to `sum`.
+     
+     The elements must all be positive, so that the prefix sums are increasing.
+     */
+    func prefixCount(withSumNotExceeding sum: Int) -> Int {
+        var position = 0
+        var remaining = sum
+        var step = 1
+        while step * 2 <= count {
+            step *= 2
+        }
+        while step > 0 {
+            let next = position + step
+            if next < tree.count && tree[next] <= remaining {
+                position = next
+                remaining -= tree[next]
+            }
+            step /= 2
+        }
+        return position
+    }
+}
@@ -42,6 +42,21 @@ extension OutputStream {
         }
     }
     
+    func write(tagString: PlaylistTagString) throws {
+        guard self.hasSpaceAvailable else {
+            throw OutputStreamError.couldNotWriteToStream(self.streamError as NSError?)
+        }
+        
+        try tagString.withUTF8Bytes { bytes in
+            guard let baseAddress = bytes.baseAddress else {
+                return
+            }
+            guard self.write(baseAddress, maxLength: bytes.count) == bytes.count else {
+                throw OutputStreamError.couldNotWriteToStream(self.streamError as NSError?)
+            }
+        }
+    }
+    
     func write(data: Data) throws {
         guard self.hasSpaceAvailable else {
             throw OutputStreamError.couldNotWriteToStream(self.streamError as NSError?)
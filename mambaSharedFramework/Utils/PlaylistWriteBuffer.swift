@@ -0,0 +1,227 @@
+//
+//  PlaylistWriteBuffer.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
+/**
+ A contiguous, growable byte buffer that `PlaylistWriter` writes a playlist into.
+ 
+ Appending to the buffer is a `memcpy`, so writing a tag costs no more than copying its bytes, and the
+ playlist reaches its destination in a few large writes instead of several small writes per tag.
+ */
+final class PlaylistWriteBuffer {
+    
+    /// Where the bytes in the buffer end up
+    enum Destination {
+        /// The bytes stay in the buffer until they are taken with `takeData()`
+        case data
+        case stream(OutputStream)
+        case fileDescriptor(Int32)
+    }
+    
+    private var bytes: UnsafeMutablePointer<UInt8>
+    
+    /// The number of bytes written into the buffer and not yet flushed
+    private(set) var count = 0
+    
+    private var capacity: Int
+    
+    private let destination: Destination
+    
+    private static let minimumCapacity = 4096
+    
+    /// The size of the blocks that we write to a stream or file descriptor
+    static let blockSize = 64 * 1024
+    
+    init(capacity: Int, destination: Destination = .data) {
+        self.capacity = max(capacity, PlaylistWriteBuffer.minimumCapacity)
+        self.bytes = UnsafeMutablePointer<UInt8>.allocate(capacity: self.capacity)
+        self.destination = destination
+    }
+    
+    deinit {
+        bytes.deallocate()
+    }
+    
+    // MARK: Appending
+    
+    func append(_ buffer: UnsafeBufferPointer<UInt8>) {
+        guard let baseAddress = buffer.baseAddress, buffer.count > 0 else {
+            return
+        }
+        reserveCapacity(count + buffer.count)
+        (bytes + count).initialize(from: baseAddress, count: buffer.count)
+        count += buffer.count
+    }
+    
+    func append(tagString: PlaylistTagString) {
+        tagString.withUTF8Bytes { append($0) }
+    }
+    
+    /// The string must be UTF-8 encodable.
+    func append(string: String) {
+        var string = string
+        string.withUTF8 { append($0) }
+    }
+    
+    func append(data: Data) {
+        data.withUnsafeBytes { append($0.bindMemory(to: UInt8.self)) }
+    }
+    
+    /// The character to be written must be representable as ASCII (values 0-127).
+    func append(unicodeScalar: UnicodeScalar) throws {
+        guard unicodeScalar.isASCII else {
+            throw OutputStreamError.invalidData(description: "Unicode scalar \(unicodeScalar) cannot be represented as ASCII")
+        }
+        reserveCapacity(count + 1)
+        bytes[count] = UInt8(ascii: unicodeScalar)
+        count += 1
+    }
+    
+    private func reserveCapacity(_ minimumCapacity: Int) {
+        guard minimumCapacity > capacity else {
+            return
+        }
+        var newCapacity = capacity * 2
+        while newCapacity < minimumCapacity {
+            newCapacity *= 2
+        }
+        let newBytes = UnsafeMutablePointer<UInt8>.allocate(capacity: newCapacity)
+        newBytes.initialize(from: bytes, count: count)
+        bytes.deallocate()
+        bytes = newBytes
+        capacity = newCapacity
+    }
+    
+    /**
+     Appends bytes that are already laid out as they should be written, such as a run of unedited tags
+     from the original playlist.
+     
+     Large runs are not copied into the buffer when we are writing to a stream or file descriptor. Instead we
+     write out what is in the buffer and the run together.
+     */
+    func append(passthrough passthroughBytes: UnsafeBufferPointer<UInt8>) throws {
+        if case .data = destination {
+            append(passthroughBytes)
+            return
+        }
+        guard passthroughBytes.count >= PlaylistWriteBuffer.blockSize else {
+            append(passthroughBytes)
+            try flushIfFull()
+            return
+        }
+        try write([UnsafeBufferPointer(start: bytes, count: count), passthroughBytes])
+        count = 0
+    }
+    
+    // MARK: Flushing
+    
+    /// Writes out the bytes in the buffer if there are more than `blockSize` of them. Does nothing for `Destination.data`.
+    func flushIfFull() throws {
+        guard count >= PlaylistWriteBuffer.blockSize else {
+            return
+        }
+        try flush()
+    }
+    
+    /// Writes out all bytes in the buffer and empties the buffer. Does nothing for `Destination.data`.
+    func flush() throws {
+        if case .data = destination {
+            return
+        }
+        try write([UnsafeBufferPointer(start: bytes, count: count)])
+        count = 0
+    }
+    
+    private func write(_ chunks: [UnsafeBufferPointer<UInt8>]) throws {
+        switch destination {
+        case .data:
+            assertionFailure("PlaylistWriteBuffer has no destination to write to")
+        case .stream(let stream):
+            try write(chunks, toStream: stream)
+        case .fileDescriptor(let fileDescriptor):
+            try write(chunks, toFileDescriptor: fileDescriptor)
+        }
+    }
+    
+    private func write(_ chunks: [UnsafeBufferPointer<UInt8>], toStream stream: OutputStream) throws {
+        for chunk in chunks {
+            guard let baseAddress = chunk.baseAddress else {
+                continue
+            }
+            var written = 0
+            while written < chunk.count {
+                let result = stream.write(baseAddress + written, maxLength: chunk.count - written)
+                guard result > 0 else {
+                    throw OutputStreamError.couldNotWriteToStream(stream.streamError as NSError?)
+                }
+                written += result
+            }
+        }
+    }
+    
+    /// Writes all the chunks with as few `writev` calls as possible.
+    private func write(_ chunks: [UnsafeBufferPointer<UInt8>], toFileDescriptor fileDescriptor: Int32) throws {
+        var iovecs = chunks
+            .filter { $0.count > 0 }
+            .map { iovec(iov_base: UnsafeMutableRawPointer(mutating: $0.baseAddress), iov_len: $0.count) }
+        var first = 0
+        while first < iovecs.count {
+            let result = iovecs.withUnsafeBufferPointer { writev(fileDescriptor, $0.baseAddress! + first, Int32(iovecs.count - first)) }
+            if result < 0 {
+                if errno == EINTR {
+                    continue
+                }
+                throw OutputStreamError.couldNotWriteToStream(NSError(domain: NSPOSIXErrorDomain, code: Int(errno)))
+            }
+            // every chunk left has bytes in it, so writing none of them means the descriptor will not take any more
+            guard result > 0 else {
+                throw OutputStreamError.couldNotWriteToStream(NSError(domain: NSPOSIXErrorDomain, code: Int(EIO)))
+            }
+            // skip past what was written, which may end part way through a chunk
+            var remaining = result
+            while first < iovecs.count && remaining >= iovecs[first].iov_len {
+                remaining -= iovecs[first].iov_len
+                first += 1
+            }
+            if remaining > 0 {
+                iovecs[first].iov_base = iovecs[first].iov_base! + remaining
+                iovecs[first].iov_len -= remaining
+            }
+        }
+    }
+    
+    /// Hands the bytes in the buffer over to a `Data` without copying and empties the buffer.
+    func takeData() -> Data {
+        guard count > 0 else {
+            return Data()
+        }
+        let data = Data(bytesNoCopy: bytes, count: count, deallocator: .custom({ pointer, _ in
+            pointer.assumingMemoryBound(to: UInt8.self).deallocate()
+        }))
+        capacity = PlaylistWriteBuffer.minimumCapacity
+        bytes = UnsafeMutablePointer<UInt8>.allocate(capacity: capacity)
+        count = 0
+        return data
+    }
+}
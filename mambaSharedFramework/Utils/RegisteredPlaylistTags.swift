@@ -36,6 +36,7 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
      */
     public mutating func register(tagDescriptorType: PlaylistTagDescriptor.Type) {
         registeredTagDescriptors.append(tagDescriptorType)
+        dispatchTable = PlaylistTagDispatchTable(registeredTagDescriptors: registeredTagDescriptors)
     }
     
     /**
@@ -43,6 +44,7 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
      */
     public mutating func unRegisterAllTagDescriptors() {
         registeredTagDescriptors = registeredTagDescriptors.filter { $0 == PantosTag.self }
+        dispatchTable = PlaylistTagDispatchTable.pantosTags
     }
     
     /**
@@ -65,6 +67,9 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
      - parameter forTag: The PlaylistTagDescriptor to be parsed
      */
     public func parser(forTag tag: PlaylistTagDescriptor) -> PlaylistTagParser {
+        if let entry = dispatchTable.entry(forTag: tag), let parser = entry.parser {
+            return parser
+        }
         for tagType in registeredTagDescriptors {
             if let parser = tagType.parser(forTag: tag) {
                 return parser
@@ -80,6 +85,9 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
      - parameter forTag: The PlaylistTagDescriptor to be parsed
      */
     public func writer(forTag tag: PlaylistTagDescriptor) -> PlaylistTagWriter? {
+        if let entry = dispatchTable.entry(forTag: tag), let writer = entry.writer {
+            return writer
+        }
         for tagType in registeredTagDescriptors {
             if let writer = tagType.writer(forTag: tag) {
                 return writer
@@ -99,6 +107,9 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
      - parameter forTag: The PlaylistTagDescriptor to be parsed
      */
     public func validator(forTag tag: PlaylistTagDescriptor) -> PlaylistTagValidator? {
+        if let entry = dispatchTable.entry(forTag: tag) {
+            return entry.validator
+        }
         for tagType in registeredTagDescriptors {
             if let validator = tagType.validator(forTag: tag) {
                 return validator
@@ -109,10 +120,14 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
     
     public init() {
         registeredTagDescriptors.append(PantosTag.self)
+        dispatchTable = PlaylistTagDispatchTable.pantosTags
     }
     
     internal fileprivate(set) var registeredTagDescriptors = [PlaylistTagDescriptor.Type]()
     
+    /// Shared parsers, writers and validators, looked up once when the descriptor types were registered
+    private var dispatchTable: PlaylistTagDispatchTable
+    
     public var debugDescription: String {
         return "RegisteredPlaylistTags registeredTagDescriptors:\(registeredTagDescriptors)\n"
     }
@@ -121,3 +136,84 @@ public struct RegisteredPlaylistTags: CustomDebugStringConvertible {
 public protocol RegisteredPlaylistTagsProvider {
     var registeredPlaylistTags: RegisteredPlaylistTags { get }
 }
+
+/**
+ The parser, writer and validator for every descriptor of the registered `PlaylistTagDescriptorEnumerable`
+ types, looked up the same way as `RegisteredPlaylistTags` does without a table.
+ 
+ The table is immutable once built, so the shared instances in it may be used from any thread.
+ */
+private final class PlaylistTagDispatchTable {
+    
+    struct Entry {
+        /// nil if the descriptor does not have a parser (the parser never asks for one for these descriptors)
+        let parser: PlaylistTagParser?
+        let writer: PlaylistTagWriter?
+        let validator: PlaylistTagValidator?
+    }
+    
+    /// Entries for `PantosTag`, indexed by `PantosTag.tagIndex`. Empty if `PantosTag` is not registered.
+    private let pantosEntries: [Entry?]
+    
+    /// Entries for the other registered types
+    private let entries: [PlaylistTagDescriptorKey: Entry]
+    
+    /// The table for the default registration of just `PantosTag`
+    static let pantosTags = PlaylistTagDispatchTable(registeredTagDescriptors: [PantosTag.self])
+    
+    init(registeredTagDescriptors: [PlaylistTagDescriptor.Type]) {
+        
+        func first<T>(_ factory: (PlaylistTagDescriptor.Type) -> T?) -> T? {
+            for tagType in registeredTagDescriptors {
+                if let result = factory(tagType) {
+                    return result
+                }
+            }
+            return nil
+        }
+        
+        func makeEntry(forTag tag: PlaylistTagDescriptor) -> Entry {
+            // only single value and key value tags are parsed with a `PlaylistTagParser`, and asking
+            // for the parser of other tags is a programming error
+            let hasParser = tag.type() == .singleValue || tag.type() == .keyValue
+            return Entry(parser: hasParser ? first { $0.parser(forTag: tag) } : nil,
+                         writer: first { $0.writer(forTag: tag) },
+                         validator: first { $0.validator(forTag: tag) })
+        }
+        
+        var pantosEntries = [Entry?]()
+        var entries = [PlaylistTagDescriptorKey: Entry]()
+        for case let tagType as PlaylistTagDescriptorEnumerable.Type in registeredTagDescriptors {
+            if tagType == PantosTag.self {
+                guard pantosEntries.isEmpty else {
+                    continue
+                }
+                pantosEntries = [Entry?](repeating: nil, count: PantosTag.tagIndexCount)
+                for tag in PantosTag.allCases {
+                    pantosEntries[tag.tagIndex] = makeEntry(forTag: tag)
+                }
+                continue
+            }
+            for tag in tagType.allTagDescriptors {
+                let key = PlaylistTagDescriptorKey(tag)
+                guard entries[key] == nil else {
+                    continue
+                }
+                entries[key] = makeEntry(forTag: tag)
+            }
+        }
+        self.pantosEntries = pantosEntries
+        self.entries = entries
+    }
+    
+    /// Returns nil if the descriptor is not in the table, in which case the caller should look it up directly.
+    func entry(forTag tag: PlaylistTagDescriptor) -> Entry? {
+        if let pantos = tag as? PantosTag {
+            return pantosEntries.isEmpty ? nil : pantosEntries[pantos.tagIndex]
+        }
+        guard !entries.isEmpty else {
+            return nil
+        }
+        return entries[PlaylistTagDescriptorKey(tag)]
+    }
+}
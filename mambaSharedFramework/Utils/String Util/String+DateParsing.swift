@@ -19,6 +19,10 @@
 
 import Foundation
 
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
 extension String {
     
     struct DateFormatter {
@@ -42,9 +46,50 @@ extension String {
     
     /// parse this string as a ISO8601 date if possible, return nil if impossible   
     public func parseISO8601Date() -> Date? {
+        var string = self
+        let (date, mightBeLenientDate) = string.withUTF8 { bytes -> (Date?, Bool) in
+            if let date = Date(iso8601UTF8Bytes: bytes) {
+                return (date, true)
+            }
+            return (nil, String.mightBeLenientISO8601Date(bytes))
+        }
+        if let date = date {
+            return date
+        }
+        // `mamba_parseISO8601Date` handles every RFC 3339 date, the formatters are more lenient about the rest
+        guard mightBeLenientDate else {
+            return nil
+        }
         if let date = DateFormatter.iso8601MS.date(from: self) {
             return date
         }
         return DateFormatter.iso8601.date(from: self)
     }
+    
+    /// returns false for strings that neither DateFormatter could parse, so we can skip them
+    private static func mightBeLenientISO8601Date(_ bytes: UnsafeBufferPointer<UInt8>) -> Bool {
+        // both formats start with a year and need the literal 'T' and the ':' separators
+        guard let first = bytes.first, first >= UInt8(ascii: "0"), first <= UInt8(ascii: "9") else {
+            return false
+        }
+        return bytes.contains(UInt8(ascii: "T")) && bytes.contains(UInt8(ascii: ":"))
+    }
+}
+
+extension Date {
+    
+    /// parse UTF-8 bytes as a RFC 3339 date (i.e. "2010-02-19T14:54:23.031+08:00") if possible, return nil if impossible
+    init?(iso8601UTF8Bytes bytes: UnsafeBufferPointer<UInt8>) {
+        guard let baseAddress = bytes.baseAddress else {
+            return nil
+        }
+        var timeIntervalSince1970: TimeInterval = 0
+        let parsed = baseAddress.withMemoryRebound(to: CChar.self, capacity: bytes.count) {
+            mamba_parseISO8601Date($0, bytes.count, &timeIntervalSince1970)
+        }
+        guard parsed else {
+            return nil
+        }
+        self.init(timeIntervalSince1970: timeIntervalSince1970)
+    }
 }
@@ -44,4 +44,17 @@ struct GenericDictionaryTagParserHelper {
                         
             return results
     }
+    
+    /// Generic code to parse tag dictionary values out from the UTF-8 bytes of a tag body, without creating a `String` for the whole body first
+    static func parseTag(fromUTF8Bytes bytes: UnsafeBufferPointer<UInt8>,
+                         tag: PlaylistTagDescriptor)
+        throws -> PlaylistTagDictionary {
+            
+            do {
+                return try StringDictionaryParser.parseToPlaylistTagDictionary(fromUTF8Bytes: bytes)
+            }
+            catch {
+                throw PlaylistParserError.malformedPlaylistTag(tag: tag.toString(), tagBody: String(decoding: bytes, as: UTF8.self))
+            }
+    }
 }
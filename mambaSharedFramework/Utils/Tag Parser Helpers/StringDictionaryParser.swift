@@ -19,6 +19,10 @@
 
 import Foundation
 
+#if SWIFT_PACKAGE
+import HLSObjectiveC
+#endif
+
 struct StringDictionaryParser {
     
     enum StringDictionaryParserError: Error {
@@ -30,77 +34,42 @@ struct StringDictionaryParser {
     ///
     /// quotes should escape commas and equals, so "key1=value1,key2="value2,value3=value4"" should resolve to [key1: value1, key2: "value2,value3=value4"]
     static func parseToPlaylistTagDictionary(fromParsableString string: String) throws -> PlaylistTagDictionary {
+        var string = string
+        return try string.withUTF8 { try parseToPlaylistTagDictionary(fromUTF8Bytes: $0) }
+    }
+    
+    /// parses the UTF-8 bytes of a string in the format "<key1>=<value1>,<key2>=<value2>". See `parseToPlaylistTagDictionary(fromParsableString:)`
+    ///
+    /// The bytes are tokenized in place by `mamba_parseAttributeList`, so the only allocations are the keys and values of the result.
+    static func parseToPlaylistTagDictionary(fromUTF8Bytes bytes: UnsafeBufferPointer<UInt8>) throws -> PlaylistTagDictionary {
         
         var dictionary = PlaylistTagDictionary()
         
-        guard string.count > 0 else {
+        guard let baseAddress = bytes.baseAddress, bytes.count > 0 else {
             return dictionary
         }
         
-        var build: String? = nil
-        var key: String = ""
-        var quoteEscaped = false
-        
-        for char in string {
-            if char == "\"" {
-                quoteEscaped = !quoteEscaped
-                if let _ = build {
-                    build = build! + String(char)
-                }
-                else {
-                    build = String(char)
-                }
-            }
-            else if char == "=" && !quoteEscaped && key.isEmpty {
-                if let build = build {
-                    key = build
-                }
-                else {
-                    throw StringDictionaryParserError.malformedDictionaryString
-                }
-                build = ""
+        return try baseAddress.withMemoryRebound(to: CChar.self, capacity: bytes.count) { cBytes in
+            
+            var entries = [AttributeListEntry](repeating: AttributeListEntry(), count: StringDictionaryParser.expectedMaximumEntryCount)
+            var count = mamba_parseAttributeList(cBytes, UInt64(bytes.count), &entries, UInt64(entries.count))
+            if count > Int64(entries.count) {
+                entries = [AttributeListEntry](repeating: AttributeListEntry(), count: Int(count))
+                count = mamba_parseAttributeList(cBytes, UInt64(bytes.count), &entries, UInt64(entries.count))
             }
-            else if char == "," && !quoteEscaped {
-                if let build = build, !key.isEmpty {
-                    add(key: key, andValue: build, toTagDictionary: &dictionary)
-                }
-                else {
-                    throw StringDictionaryParserError.malformedDictionaryString
-                }
-                build = ""
-                key = ""
+            guard count >= 0 else {
+                throw StringDictionaryParserError.malformedDictionaryString
             }
-            else {
-                if let _ = build {
-                    build = build! + String(char)
-                }
-                else {
-                    build = String(char)
-                }
+            
+            for entry in entries[0..<Int(count)] {
+                let key = String(decoding: UnsafeBufferPointer(rebasing: bytes[Int(entry.keyStart)..<Int(entry.keyStart + entry.keyLength)]), as: UTF8.self)
+                let value = String(decoding: UnsafeBufferPointer(rebasing: bytes[Int(entry.valueStart)..<Int(entry.valueStart + entry.valueLength)]), as: UTF8.self)
+                dictionary[key] = PlaylistTagValueData(value: value, quoteEscaped: entry.quoteEscaped)
             }
+            return dictionary
         }
-        if let build = build, !key.isEmpty {
-            add(key: key, andValue: build, toTagDictionary: &dictionary)
-        }
-        else {
-            throw StringDictionaryParserError.malformedDictionaryString
-        }
-        return dictionary
     }
     
-    static private func add(key keyIn: String,
-                            andValue valueIn: String,
-                            toTagDictionary dictionary: inout PlaylistTagDictionary) {
-        
-        var value = valueIn.trim()
-        let key = keyIn.trim()
-        var quoteEscaped = false
-        
-        if value.hasPrefix("\"") && value.hasSuffix("\"") {
-            value = value.trimDoubleQuotes()
-            quoteEscaped = true
-        }
-        
-        dictionary[key] = PlaylistTagValueData(value: value, quoteEscaped: quoteEscaped)
-    }
+    /// Enough entries for all but the largest attribute lists (i.e. a busy #EXT-X-DATERANGE), which will be parsed twice
+    private static let expectedMaximumEntryCount = 16
 }
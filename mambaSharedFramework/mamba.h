@@ -35,5 +35,11 @@ FOUNDATION_EXPORT const unsigned char mambaVersionString[];
 #import "MambaStringRef.h"
 #import "RapidParser.h"
 #import "RapidParserCallback.h"
+#import "RapidParserLineRecord.h"
+#import "RapidParserTagID.h"
 #import "CMTimeMakeFromString.h"
+#import "AttributeListParser.h"
+#import "ISO8601DateParser.h"
+#import "PlaylistLineSearch.h"
 #import "StaticMemoryStorage.h"
+#import "RapidParserCancellation.h"
@@ -18,6 +18,7 @@
 //
 
 import XCTest
+import CoreMedia
 
 @testable import mamba
 
@@ -662,6 +663,325 @@ a
         XCTAssert(playlist.tags[2].tagData.isEqual(to: "a"), "Location tag does not have expected value")
     }
     
+    func testParallelParse() {
+        
+        var playlistString = "#EXTM3U\n#EXT-X-VERSION:4\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:0\n#EXT-X-PLAYLIST-TYPE:VOD\n"
+        for segment in 0..<5000 {
+            if segment % 100 == 0 {
+                playlistString += "#EXT-X-DISCONTINUITY\n# comment \(segment)\n"
+            }
+            playlistString += "#EXTINF:2.002,\nhttp://not.a.server.nowhere/segment\(segment).ts\n"
+        }
+        playlistString += "#EXT-X-ENDLIST\n"
+        let data = playlistString.data(using: .utf8)!
+        
+        let expectedPlaylist = parseVariantPlaylist(inData: data)
+        
+        let parallelParseParams = ParallelParsePlaylistParams(minimalBytesPerPartition: 1024, maximumPartitionCount: 8)
+        let parser = PlaylistParser(parallelParseParams: parallelParseParams)
+        XCTAssertEqual(parallelParseParams.partitionCount(forPlaylistLength: data.count), 8)
+        
+        guard case .parsedVariant(let playlist) = parser.parse(playlistData: data, url: fakePlaylistURL()) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        
+        XCTAssertEqual(playlist.tags.count, expectedPlaylist.tags.count)
+        for (tag, expectedTag) in zip(playlist.tags, expectedPlaylist.tags) {
+            XCTAssert(tag.tagDescriptor == expectedTag.tagDescriptor)
+            XCTAssertEqual(tag.tagName?.stringValue(), expectedTag.tagName?.stringValue())
+            XCTAssertEqual(tag.tagData.stringValue(), expectedTag.tagData.stringValue())
+            XCTAssertEqual(tag.duration, expectedTag.duration)
+        }
+        XCTAssertEqual(playlist.mediaSegmentGroups.count, expectedPlaylist.mediaSegmentGroups.count)
+    }
+    
+    func testParallelParseExpectingFailure() {
+        
+        var playlistString = "#EXTM3U\n#EXT-X-TARGETDURATION:2\n"
+        for segment in 0..<1000 {
+            playlistString += "#EXTINF:2.002,\nsegment\(segment).ts\n"
+        }
+        playlistString += "#EXT-X-MEDIA-SEQUENCE:\n"
+        for segment in 1000..<2000 {
+            playlistString += "#EXTINF:2.002,\nsegment\(segment).ts\n"
+        }
+        
+        let parser = PlaylistParser(parallelParseParams: ParallelParsePlaylistParams(minimalBytesPerPartition: 1024, maximumPartitionCount: 8))
+        
+        guard case .parseError(_) = parser.parse(playlistData: playlistString.data(using: .utf8)!, url: fakePlaylistURL()) else {
+            XCTFail("testParallelParseExpectingFailure failure - not expecting a playlist")
+            return
+        }
+    }
+    
+    func testParseReportsFirstMalformedTag() {
+        
+        var playlistString = "#EXTM3U\n#EXT-X-TARGETDURATION:2\n#EXT-X-ENDLIST:first\n"
+        for segment in 0..<2000 {
+            playlistString += "#EXTINF:2.002,\nsegment\(segment).ts\n"
+        }
+        playlistString += "#EXT-X-DISCONTINUITY:second\n"
+        let data = playlistString.data(using: .utf8)!
+        
+        let parallelParser = PlaylistParser(parallelParseParams: ParallelParsePlaylistParams(minimalBytesPerPartition: 1024, maximumPartitionCount: 8))
+        
+        for parser in [PlaylistParser(), parallelParser] {
+            guard case .parseError(let error) = parser.parse(playlistData: data, url: fakePlaylistURL()) else {
+                XCTFail("testParseReportsFirstMalformedTag failure - not expecting a playlist")
+                return
+            }
+            guard case .mismatchBetweenTagDescriptorAndTagData(let description) = error else {
+                XCTFail("Unexpected error \(error)")
+                return
+            }
+            XCTAssert(description.contains("EXT-X-ENDLIST"), "Expected the first malformed tag to be reported, got \(description)")
+        }
+    }
+    
+    func testSynchronousParseRunsOnCallingThread() {
+        
+        guard let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt") as Data? else {
+            XCTFail("Fixture is missing?")
+            return
+        }
+        
+        let callingThread = Thread.current
+        var constructedOnCallingThread = false
+        
+        let tagCount: Int = PlaylistParser().parse(playlistData: data,
+                                                   customData: (),
+                                                   playlistConstructor: { baseResult, _, _, _ in
+                                                    constructedOnCallingThread = Thread.current == callingThread
+                                                    switch baseResult {
+                                                    case .success(let tags):
+                                                        return tags.count
+                                                    case .failure(_):
+                                                        return -1
+                                                    } })
+        
+        XCTAssertTrue(constructedOnCallingThread)
+        XCTAssertEqual(tagCount, 18)
+    }
+    
+    func testParseCancellation() {
+        
+        guard let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt") as Data? else {
+            XCTFail("Fixture is missing?")
+            return
+        }
+        
+        let cancellationToken = PlaylistParserCancellationToken()
+        cancellationToken.cancel()
+        XCTAssertTrue(cancellationToken.isCancelled)
+        
+        let expectation = self.expectation(description: "Parse cancelled")
+        PlaylistParser().parse(playlistData: data, url: fakePlaylistURL(), cancellationToken: cancellationToken) { result in
+            guard case .parseError(let error) = result, error.isCancelled else {
+                XCTFail("Expected a cancelled error")
+                return
+            }
+            expectation.fulfill()
+        }
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        
+        // a timeout of zero has passed before the parse starts
+        guard case .parseError(.timedOut) = PlaylistParser().parse(playlistData: data, url: fakePlaylistURL(), timeout: 0) else {
+            XCTFail("Expected a timedOut error")
+            return
+        }
+        
+        // a token that is not cancelled, with a deadline far in the future, does not get in the way
+        let successExpectation = self.expectation(description: "Parse complete")
+        PlaylistParser().parse(playlistData: data, url: fakePlaylistURL(), cancellationToken: PlaylistParserCancellationToken(deadline: .distantFuture)) { result in
+            guard case .parsedVariant(_) = result else {
+                XCTFail("Expected a variant playlist")
+                return
+            }
+            successExpectation.fulfill()
+        }
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+    }
+    
+    func testIncrementalParse() {
+        
+        for fixtureName in ["hls_sampleMediaFile.txt", "bipbopall.m3u8"] {
+            
+            guard let data = FixtureLoader.load(fixtureName: fixtureName as NSString) as Data? else {
+                XCTFail("Fixture is missing?")
+                return
+            }
+            
+            let expectedTags: [PlaylistTag]
+            switch PlaylistParser().parse(playlistData: data, url: fakePlaylistURL()) {
+            case .parsedMaster(let master):
+                expectedTags = master.tags
+            case .parsedVariant(let variant):
+                expectedTags = variant.tags
+            case .parseError(let error):
+                XCTFail("Unexpected parse error \(error)")
+                return
+            }
+            
+            for chunkSize in [1, 13, 1024] {
+                
+                let incrementalParse = PlaylistParser().beginIncrementalParse(url: fakePlaylistURL(), expectedContentLength: data.count)
+                for chunkStart in stride(from: 0, to: data.count, by: chunkSize) {
+                    XCTAssertTrue(incrementalParse.feed(playlistData: data.subdata(in: chunkStart..<min(chunkStart + chunkSize, data.count))))
+                }
+                
+                let tags: [PlaylistTag]
+                switch incrementalParse.finish() {
+                case .parsedMaster(let master):
+                    tags = master.tags
+                case .parsedVariant(let variant):
+                    tags = variant.tags
+                case .parseError(let error):
+                    XCTFail("Unexpected parse error \(error)")
+                    return
+                }
+                
+                XCTAssertEqual(tags.count, expectedTags.count, "\(fixtureName) chunk size \(chunkSize)")
+                for (tag, expectedTag) in zip(tags, expectedTags) {
+                    XCTAssert(tag.tagDescriptor == expectedTag.tagDescriptor, "\(fixtureName) chunk size \(chunkSize)")
+                    XCTAssertEqual(tag.tagName?.stringValue(), expectedTag.tagName?.stringValue(), "\(fixtureName) chunk size \(chunkSize)")
+                    XCTAssertEqual(tag.tagData.stringValue(), expectedTag.tagData.stringValue(), "\(fixtureName) chunk size \(chunkSize)")
+                }
+            }
+        }
+    }
+    
+    func testIncrementalParseExpectingFailure() {
+        
+        let incrementalParse = PlaylistParser().beginIncrementalParse(url: fakePlaylistURL())
+        
+        XCTAssertTrue(incrementalParse.feed(playlistData: "#EXTM3U\n#EXT-X-MEDIA-SEQ".data(using: .utf8)!))
+        XCTAssertFalse(incrementalParse.feed(playlistData: "UENCE:\n#EXTINF:5000\na\n".data(using: .utf8)!))
+        
+        switch incrementalParse.finish() {
+        case .parseError(_):
+            //expected result
+            break
+        default:
+            XCTFail("testIncrementalParseExpectingFailure failure - not expecting a playlist")
+        }
+    }
+    
+    func testParseFile() {
+        
+        guard let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt") as Data? else {
+            XCTFail("Fixture is missing?")
+            return
+        }
+        let fileURL = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent("testParseFile-\(UUID().uuidString).m3u8")
+        XCTAssertNoThrow(try data.write(to: fileURL))
+        defer {
+            try? FileManager.default.removeItem(at: fileURL)
+        }
+        
+        guard case .parsedVariant(let expectedPlaylist) = PlaylistParser().parse(playlistData: data, url: fileURL) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        
+        guard case .parsedVariant(let playlist) = PlaylistParser().parse(fileAt: fileURL) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        
+        XCTAssertEqual(playlist.url, fileURL)
+        XCTAssertEqual(playlist.playlistMemoryStorage.length, UInt(data.count))
+        XCTAssertEqual(playlist.tags.count, expectedPlaylist.tags.count)
+        for (tag, expectedTag) in zip(playlist.tags, expectedPlaylist.tags) {
+            XCTAssert(tag.tagDescriptor == expectedTag.tagDescriptor)
+            XCTAssertEqual(tag.tagName?.stringValue(), expectedTag.tagName?.stringValue())
+            XCTAssertEqual(tag.tagData.stringValue(), expectedTag.tagData.stringValue())
+        }
+    }
+    
+    func testParseMissingFile() {
+        
+        let fileURL = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent("testParseMissingFile-\(UUID().uuidString).m3u8")
+        
+        guard case .parseError(.unknown(_)) = PlaylistParser().parse(fileAt: fileURL) else {
+            XCTFail("Expected an unknown error")
+            return
+        }
+    }
+    
+    func testDeferredTagValueParsing() {
+        
+        guard let data = FixtureLoader.load(fixtureName: "hls_sampleMasterFile.txt") as Data? else {
+            XCTFail("Fixture is missing?")
+            return
+        }
+        
+        guard case .parsedMaster(let expectedPlaylist) = PlaylistParser().parse(playlistData: data, url: fakePlaylistURL()) else {
+            XCTFail("Expected a master playlist")
+            return
+        }
+        
+        guard case .parsedMaster(let playlist) = PlaylistParser(deferTagValueParsing: true).parse(playlistData: data, url: fakePlaylistURL()) else {
+            XCTFail("Expected a master playlist")
+            return
+        }
+        
+        XCTAssertNoThrow(try playlist.validateParsedTagValues())
+        XCTAssertEqual(playlist.tags.count, expectedPlaylist.tags.count)
+        for (tag, expectedTag) in zip(playlist.tags, expectedPlaylist.tags) {
+            XCTAssertEqual(tag, expectedTag)
+            XCTAssertEqual(tag.keys, expectedTag.keys)
+            XCTAssertEqual(tag.numberOfParsedValues(), expectedTag.numberOfParsedValues())
+            for key in expectedTag.keys {
+                XCTAssertEqual(tag.value(forKey: key), expectedTag.value(forKey: key))
+                XCTAssertEqual(tag.valueData(forKey: key)?.quoteEscaped, expectedTag.valueData(forKey: key)?.quoteEscaped)
+            }
+            XCTAssertFalse(tag.isDirty)
+        }
+        
+        // setting a value parses the rest first
+        var tag = playlist.tags[1]
+        XCTAssert(tag.tagDescriptor == PantosTag.EXT_X_STREAM_INF)
+        tag.set(value: "1", forValueIdentifier: PantosValue.programId)
+        XCTAssertTrue(tag.isDirty)
+        XCTAssertEqual(tag.value(forValueIdentifier: PantosValue.programId), "1")
+        XCTAssertEqual(tag.value(forValueIdentifier: PantosValue.bandwidthBPS), expectedPlaylist.tags[1].value(forValueIdentifier: PantosValue.bandwidthBPS))
+        XCTAssertEqual(tag.keys, expectedPlaylist.tags[1].keys)
+        // the original is untouched
+        XCTAssertFalse(playlist.tags[1].isDirty)
+    }
+    
+    func testDeferredTagValueParsingWithMalformedTag() {
+        
+        let playlistString = "#EXTM3U\n#EXT-X-TARGETDURATION:2\n#EXT-X-KEY:METHOD\n#EXTINF:2.002,\nsegment.ts\n"
+        
+        guard case .parseError(_) = PlaylistParser().parse(playlistData: playlistString.data(using: .utf8)!, url: fakePlaylistURL()) else {
+            XCTFail("Expected the malformed tag to fail the parse")
+            return
+        }
+        
+        guard case .parsedVariant(let playlist) = PlaylistParser(deferTagValueParsing: true).parse(playlistData: playlistString.data(using: .utf8)!, url: fakePlaylistURL()) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        
+        XCTAssert(playlist.tags[1].tagDescriptor == PantosTag.EXT_X_KEY)
+        XCTAssertNil(playlist.tags[1].value(forValueIdentifier: PantosValue.method))
+        XCTAssertEqual(playlist.tags[1].keys.count, 0)
+        XCTAssertThrowsError(try playlist.tags[1].validateParsedValues())
+        XCTAssertThrowsError(try playlist.validateParsedTagValues())
+        XCTAssertNoThrow(try playlist.tags[0].validateParsedValues())
+        
+        // freezing settles the failed parse, and the error is kept
+        let frozen = playlist.frozen()
+        XCTAssertEqual(frozen.tags[1].keys.count, 0)
+        XCTAssertThrowsError(try frozen.tags[1].validateParsedValues())
+    }
+    
     func runParseExpectingFailure(withPlaylistString playlistString: String) {
         let url: URL = fakePlaylistURL()
         let parser = PlaylistParser()
@@ -87,7 +87,12 @@ public enum TagString_ThirdParty2: String {
     case EXT_THIRD_PARTY2_1 = "EXT-THIRD-PARTY2-1"
 }
 
-extension TagString_ThirdParty2: PlaylistTagDescriptor {
+// TagString_ThirdParty2 lists its descriptors, so `RegisteredPlaylistTags` looks up its parsers once, when it is registered
+extension TagString_ThirdParty2: PlaylistTagDescriptorEnumerable {
+    
+    public static var allTagDescriptors: [PlaylistTagDescriptor] {
+        return [TagString_ThirdParty2.EXT_THIRD_PARTY2_1]
+    }
     
     public static func constructTag(tag: String) -> PlaylistTagDescriptor? {
         return TagString_ThirdParty2(rawValue: tag)
@@ -0,0 +1,96 @@
+//
+//  MambaStringSpanTests.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+import CoreMedia
+@testable import mamba
+
+class MambaStringSpanTests: XCTestCase {
+    
+    let bytes: [CChar] = Array("#EXTINF:2.002,ñ".utf8CString)
+    
+    func withSpan(_ body: (MambaStringSpan) -> Void) {
+        bytes.withUnsafeBufferPointer { buffer in
+            body(MambaStringSpan(bytes: buffer.baseAddress!, length: buffer.count - 1))
+        }
+    }
+    
+    func testMatchesStringRef() {
+        withSpan { span in
+            let stringRef = span.stringRef()
+            
+            XCTAssertEqual(span.length, Int(stringRef.length))
+            XCTAssertEqual(span.stringValue(), "#EXTINF:2.002,ñ")
+            XCTAssertEqual(span.stringValue(), stringRef.stringValue())
+            XCTAssert(span == "#EXTINF:2.002,ñ")
+            XCTAssert(span != "#EXTINF")
+            
+            // hashes the same as an NSObject
+            var hasher = Hasher()
+            hasher.combine(stringRef)
+            XCTAssertEqual(span.hashValue, hasher.finalize())
+        }
+    }
+    
+    func testEmpty() {
+        let empty = MambaStringSpan()
+        
+        XCTAssertEqual(empty.length, 0)
+        XCTAssertEqual(empty.stringValue(), "")
+        XCTAssertEqual(empty.stringRef().stringValue(), "")
+        XCTAssertEqual(empty, MambaStringSpan())
+        XCTAssert(empty == "")
+    }
+    
+    func testEXTINFDuration() {
+        bytes.withUnsafeBufferPointer { buffer in
+            let span = MambaStringSpan(bytes: buffer.baseAddress! + 8, length: 5)
+            
+            XCTAssertEqual(span.extinfSegmentDuration(), span.stringRef().extinfSegmentDuration())
+            XCTAssertEqual(span.extinfSegmentDuration().seconds, 2.002, accuracy: 0.0001)
+        }
+    }
+    
+    func testPlaylistTagStringEquality() {
+        withSpan { span in
+            let spanString = PlaylistTagString.span(span)
+            let stringRefString = PlaylistTagString.stringRef(MambaStringRef(string: "#EXTINF:2.002,ñ"))
+            let otherString = PlaylistTagString.stringRef(MambaStringRef(string: "#EXTINF:2.002,n"))
+            
+            XCTAssertEqual(spanString, stringRefString)
+            XCTAssertEqual(spanString.hashValue, stringRefString.hashValue)
+            XCTAssertNotEqual(spanString, otherString)
+            XCTAssertEqual(Set([spanString, stringRefString, otherString]).count, 2)
+        }
+    }
+    
+    func testParsedTagEqualsConstructedTag() {
+        let playlist = parseVariantPlaylist(inString: "#EXTM3U\n#EXT-X-TARGETDURATION:2\n#EXTINF:2.002,\nsegment.ts\n")
+        
+        let targetDuration = PlaylistTag(tagDescriptor: PantosTag.EXT_X_TARGETDURATION,
+                                         tagData: MambaStringRef(string: "2"),
+                                         tagName: MambaStringRef(string: "#EXT-X-TARGETDURATION"),
+                                         parsedValues: [PantosValue.targetDurationSeconds.rawValue: "2"])
+        
+        XCTAssertEqual(playlist.tags[1], targetDuration)
+        XCTAssertEqual(playlist.tags[1].hashValue, targetDuration.hashValue)
+        XCTAssertEqual(playlist.tags[1].tagName?.stringValue(), "#EXT-X-TARGETDURATION")
+        XCTAssertEqual(playlist.tags[1].tagData.stringValue(), "2")
+    }
+}
@@ -119,6 +119,11 @@ class PantosTagTests: XCTestCase {
                 return
             }
             XCTAssert(descriptor == newDescriptor, "PantosTag \(descriptor.toString()) is not hooked up properly from stringRefLookup table (found \(newDescriptor.toString()) instead).")
+            let tagID = stringRef.utf8Bytes().withMemoryRebound(to: UInt8.self, capacity: Int(stringRef.length)) {
+                UInt8(rapidParserTagIDForTagName($0, UInt64(stringRef.length)).rawValue)
+            }
+            XCTAssert(descriptor == PantosTag.descriptor(forRapidParserTagID: tagID), "PantosTag \(descriptor.toString()) is not recognized by the rapid parser (see RapidParserTagID.h).")
+            XCTAssertEqual(UInt8(descriptor.rapidParserTagID.rawValue), tagID, "PantosTag \(descriptor.toString()) has the wrong rapidParserTagID.")
             return
 
         case .Location:
@@ -136,9 +141,16 @@ class PantosTagTests: XCTestCase {
         // (1) If you have not already, add the new tag to the `tagList` in the `stringRefLookup` lazy calculated varible in PantosTag.
         // (2) Add the new tag to the tested tags in `PantosTagTests.testStringRefLookup` above.
         // (3) Add the new tag to the `PantosTagTests.testStringRefLookup.runStringRefLookupTest` above as well.
+        // (4) Add the new tag to `RapidParserTagID` and to the tables in RapidParserTagID.c, and to `PantosTag.rapidParserTagID`.
         // If you don't do these steps, this tag will not be recognized by the PantosTag, and will be treated like an unknown tag.
     }
     
+    func testTagIndex() {
+        let tagIndexes = PantosTag.allCases.map { $0.tagIndex }
+        XCTAssertEqual(Set(tagIndexes).count, PantosTag.allCases.count, "Every PantosTag should have its own tagIndex")
+        XCTAssert(tagIndexes.allSatisfy { $0 >= 0 && $0 < PantosTag.tagIndexCount }, "Every tagIndex should be less than tagIndexCount")
+    }
+    
     func testDISCONTINUITYSEQUENCEValidator() {
         guard let validator = PantosTag.validator(forTag: PantosTag.EXT_X_DISCONTINUITY_SEQUENCE) else {
             XCTFail("Could not find validator for PantosTag.EXT_X_DISCONTINUITY_SEQUENCE")
@@ -42,15 +42,101 @@ class Parser_EventUpdateTests: XCTestCase {
                                         withPlaylistData: eventHLS2.data(using: .utf8)!,
                                         atUrl: testURL1)
         
-        XCTAssertEqual(event1.playlistMemoryStorage, event2.playlistMemoryStorage)
+        // only the new bytes are in the new storage, and the old storage is kept alive for the old tags
+        XCTAssertEqual(event1.playlistMemoryStorage, event2.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(Int(event2.playlistMemoryStorage.length), eventHLS2.utf8.count - eventHLS1.utf8.count)
+        XCTAssertEqual(Int(event2.playlistMemoryStorage.documentLength), eventHLS2.utf8.count)
         XCTAssertEqual(event2.tags.count, 19)
+        assertTagsEqual(event2, parseVariantPlaylist(inString: eventHLS2))
         
         let event3 = try! parser.update(eventVariantPlaylist: event2,
                                         withPlaylistData: eventHLS3.data(using: .utf8)!,
                                         atUrl: testURL1)
         
-        XCTAssertEqual(event1.playlistMemoryStorage, event3.playlistMemoryStorage)
+        XCTAssertEqual(event2.playlistMemoryStorage, event3.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(Int(event3.playlistMemoryStorage.documentLength), eventHLS3.utf8.count)
         XCTAssertEqual(event3.tags.count, 27)
+        assertTagsEqual(event3, parseVariantPlaylist(inString: eventHLS3))
+    }
+    
+    func testEventVariantUpdateFlattensLongStorageChains() {
+        
+        // get an initial playlist
+        var event1 = parseVariantPlaylist(inString: eventHLS1)
+        event1.url = testURL1
+        
+        // create a special parser that will always do an update on event style variants, but only keeps one preceding storage
+        let parser = PlaylistParser(updateEventPlaylistParams: UpdateEventPlaylistParams(minimalBytesToTriggerUpdate: 0,
+                                                                                    maximumAmountOfTimeBetweenUpdatesToTrigger: 60 * 60,
+                                                                                    maximumPrecedingStorageCount: 1))
+        let event2 = try! parser.update(eventVariantPlaylist: event1,
+                                        withPlaylistData: eventHLS2.data(using: .utf8)!,
+                                        atUrl: testURL1)
+        
+        XCTAssertEqual(event1.playlistMemoryStorage, event2.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(event2.playlistMemoryStorage.precedingStorageCount, 1)
+        
+        // the chain is as long as we allow, so this is a normal parse into a single storage
+        let event3 = try! parser.update(eventVariantPlaylist: event2,
+                                        withPlaylistData: eventHLS3.data(using: .utf8)!,
+                                        atUrl: testURL1)
+        
+        XCTAssertNil(event3.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(Int(event3.playlistMemoryStorage.length), eventHLS3.utf8.count)
+        XCTAssertEqual(event3.tags.count, 27)
+        assertTagsEqual(event3, parseVariantPlaylist(inString: eventHLS3))
+    }
+    
+    func testEventVariantUpdateWithChangedHeader() {
+        
+        // get an initial playlist
+        var event1 = parseVariantPlaylist(inString: eventHLS1)
+        event1.url = testURL1
+        
+        // create a special parser that will always do an update on event style variants
+        let parser = PlaylistParser(updateEventPlaylistParams: UpdateEventPlaylistParams(minimalBytesToTriggerUpdate: 0,
+                                                                                    maximumAmountOfTimeBetweenUpdatesToTrigger: 60 * 60))
+        
+        // the old playlist is no longer the start of the new one, so we have to find the last fragment
+        let eventHLS2WithChangedHeader = eventHLS2.replacingOccurrences(of: "#EXT-X-VERSION:3", with: "#EXT-X-VERSION:4")
+        let event2 = try! parser.update(eventVariantPlaylist: event1,
+                                        withPlaylistData: eventHLS2WithChangedHeader.data(using: .utf8)!,
+                                        atUrl: testURL1)
+        
+        XCTAssertEqual(event1.playlistMemoryStorage, event2.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(Int(event2.playlistMemoryStorage.documentLength), eventHLS2.utf8.count)
+        XCTAssertEqual(event2.tags.count, 19)
+        assertTagsEqual(event2, parseVariantPlaylist(inString: eventHLS2))
+        
+        // our document is now the old playlist with the new bytes, so the next update with nothing changed in between is an append
+        let event3 = try! parser.update(eventVariantPlaylist: event2,
+                                        withPlaylistData: eventHLS3.data(using: .utf8)!,
+                                        atUrl: testURL1)
+        
+        XCTAssertEqual(event2.playlistMemoryStorage, event3.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(event3.tags.count, 27)
+        assertTagsEqual(event3, parseVariantPlaylist(inString: eventHLS3))
+    }
+    
+    func testEventVariantUpdateWithChangedLastLine() {
+        
+        // get an initial playlist
+        var event1 = parseVariantPlaylist(inString: eventHLS1)
+        event1.url = testURL1
+        
+        // create a special parser that will always do an update on event style variants
+        let parser = PlaylistParser(updateEventPlaylistParams: UpdateEventPlaylistParams(minimalBytesToTriggerUpdate: 0,
+                                                                                    maximumAmountOfTimeBetweenUpdatesToTrigger: 60 * 60))
+        
+        // the old playlist is the start of the new one, but our last line (and fragment) is not in it, so we have to do a normal parse
+        let eventHLS1WithChangedLastLine = eventHLS1 + "0.ts"
+        let event2 = try! parser.update(eventVariantPlaylist: event1,
+                                        withPlaylistData: eventHLS1WithChangedLastLine.data(using: .utf8)!,
+                                        atUrl: testURL1)
+        
+        XCTAssertNil(event2.playlistMemoryStorage.precedingStorage)
+        XCTAssertEqual(event2.tags.count, 15)
+        assertTagsEqual(event2, parseVariantPlaylist(inString: eventHLS1WithChangedLastLine))
     }
     
     func testEventVariantUpdateHappyPath_NoChangeToPlaylist() {
@@ -190,6 +276,14 @@ missing.ts
         XCTAssertNotEqual(event1.playlistMemoryStorage, event2.playlistMemoryStorage)
         XCTAssertEqual(event2.tags.count, 19)
     }
+    
+    private func assertTagsEqual(_ playlist: VariantPlaylist, _ expectedPlaylist: VariantPlaylist, file: StaticString = #file, line: UInt = #line) {
+        XCTAssertEqual(playlist.tags.count, expectedPlaylist.tags.count, file: file, line: line)
+        for (tag, expectedTag) in zip(playlist.tags, expectedPlaylist.tags) {
+            XCTAssert(tag.tagDescriptor == expectedTag.tagDescriptor, file: file, line: line)
+            XCTAssertEqual(tag.tagData.stringValue(), expectedTag.tagData.stringValue(), file: file, line: line)
+        }
+    }
 }
 
 private let eventHLS1 = """
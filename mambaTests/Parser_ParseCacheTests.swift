@@ -0,0 +1,155 @@
+//
+//  Parser_ParseCacheTests.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import XCTest
+@testable import mamba
+
+class Parser_ParseCacheTests: XCTestCase {
+    
+    let testURL1 = URL(string: "https://Parser_ParseCacheTests.nowhere/variant1.m3u8")!
+    let testURL2 = URL(string: "https://Parser_ParseCacheTests.nowhere/variant2.m3u8")!
+    
+    func testCacheHitSharesPlaylist() {
+        
+        let parseCache = PlaylistParseCache()
+        let parser = PlaylistParser(parseCache: parseCache)
+        
+        guard
+            case .parsedVariant(let playlist1) = parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1),
+            case .parsedVariant(var playlist2) = parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1) else {
+                XCTFail("Expected variant playlists")
+                return
+        }
+        
+        XCTAssertEqual(parseCache.missCount, 1)
+        XCTAssertEqual(parseCache.hitCount, 1)
+        XCTAssertEqual(parseCache.playlistCount, 1)
+        XCTAssert(playlist1.playlistMemoryStorage === playlist2.playlistMemoryStorage, "Expecting the cached playlist")
+        XCTAssertEqual(playlist1.tags, playlist2.tags)
+        XCTAssertEqual(playlist2.url, testURL1)
+        
+        // editing a cached playlist only changes our copy
+        playlist2.delete(atIndex: playlist2.tags.count - 1)
+        guard case .parsedVariant(let playlist3) = parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        XCTAssertEqual(playlist3.tags.count, playlist1.tags.count)
+        XCTAssertEqual(parseCache.hitCount, 2)
+        
+        // the cache is only used for the same URL and the same bytes
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL2)
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 4), url: testURL1)
+        XCTAssertEqual(parseCache.missCount, 3)
+        XCTAssertEqual(parseCache.playlistCount, 3)
+        
+        // a parser that parses differently does not get our playlists
+        let deferredParser = PlaylistParser(deferTagValueParsing: true, parseCache: parseCache)
+        _ = deferredParser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1)
+        XCTAssertEqual(parseCache.missCount, 4)
+    }
+    
+    func testAsynchronousParseUsesCache() {
+        
+        let parseCache = PlaylistParseCache()
+        let parser = PlaylistParser(parseCache: parseCache)
+        
+        let expectation = self.expectation(description: "parsed twice")
+        parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1) { result in
+            guard case .parsedVariant(let playlist1) = result else {
+                XCTFail("Expected a variant playlist")
+                return
+            }
+            parser.parse(playlistData: variantHLS(segmentCount: 3), url: self.testURL1) { result in
+                guard case .parsedVariant(let playlist2) = result else {
+                    XCTFail("Expected a variant playlist")
+                    return
+                }
+                XCTAssert(playlist1.playlistMemoryStorage === playlist2.playlistMemoryStorage, "Expecting the cached playlist")
+                expectation.fulfill()
+            }
+        }
+        waitForExpectations(timeout: 2.0)
+        
+        XCTAssertEqual(parseCache.missCount, 1)
+        XCTAssertEqual(parseCache.hitCount, 1)
+    }
+    
+    func testLeastRecentlyUsedEviction() {
+        
+        let parseCache = PlaylistParseCache(maximumPlaylistCount: 2)
+        let parser = PlaylistParser(parseCache: parseCache)
+        
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 1), url: testURL1)
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 2), url: testURL1)
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 1), url: testURL1)
+        // evicts the 2 segment playlist, which was used least recently
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 3), url: testURL1)
+        XCTAssertEqual(parseCache.playlistCount, 2)
+        XCTAssertEqual(parseCache.hitCount, 1)
+        XCTAssertEqual(parseCache.missCount, 3)
+        
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 1), url: testURL1)
+        XCTAssertEqual(parseCache.hitCount, 2)
+        _ = parser.parse(playlistData: variantHLS(segmentCount: 2), url: testURL1)
+        XCTAssertEqual(parseCache.missCount, 4)
+        
+        parseCache.removeAll()
+        XCTAssertEqual(parseCache.playlistCount, 0)
+        XCTAssertEqual(parseCache.byteCount, 0)
+    }
+    
+    func testByteBudget() {
+        
+        let smallData = variantHLS(segmentCount: 2)
+        let largeData = variantHLS(segmentCount: 200)
+        
+        let measuringCache = PlaylistParseCache()
+        _ = PlaylistParser(parseCache: measuringCache).parse(playlistData: smallData, url: testURL1)
+        let smallByteCount = measuringCache.byteCount
+        // the estimate includes the tags and their values, not just the data
+        XCTAssertGreaterThan(smallByteCount, smallData.count + 8 * MemoryLayout<PlaylistTag>.stride)
+        
+        // room for several small playlists, but not the large one
+        let parseCache = PlaylistParseCache(maximumByteCount: smallByteCount * 3)
+        let parser = PlaylistParser(parseCache: parseCache)
+        
+        _ = parser.parse(playlistData: largeData, url: testURL1)
+        XCTAssertEqual(parseCache.playlistCount, 0, "A playlist larger than the cache should not be cached")
+        
+        _ = parser.parse(playlistData: smallData, url: testURL1)
+        _ = parser.parse(playlistData: smallData, url: testURL2)
+        XCTAssertEqual(parseCache.playlistCount, 2)
+        XCTAssert(parseCache.byteCount <= parseCache.maximumByteCount)
+        
+        // failed parses are not cached
+        _ = parser.parse(playlistData: "not a playlist".data(using: .utf8)!, url: testURL1)
+        XCTAssertEqual(parseCache.playlistCount, 2)
+    }
+    
+    private func variantHLS(segmentCount: Int) -> Data {
+        var playlist = "#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:0\n"
+        for segment in 0..<segmentCount {
+            playlist += "#EXTINF:2.002,\nhttp://not.a.server.nowhere/segment\(segment).ts\n"
+        }
+        return playlist.data(using: .utf8)!
+    }
+}
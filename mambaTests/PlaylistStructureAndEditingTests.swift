@@ -725,6 +725,79 @@ class PlaylistStructureAndEditingTests: XCTestCase {
         }
     }
     
+    func testStructuralChangesFromTransform() {
+        
+        let delegate = VariantPlaylistStructureDelegate()
+        
+        let location = PlaylistTag(tagDescriptor: PantosTag.Location, tagData: MambaStringRef(string: "http://not.a.server.nowhere/segment1.ts"))
+        let signedLocation = PlaylistTag(tagDescriptor: PantosTag.Location, tagData: MambaStringRef(string: "http://not.a.server.nowhere/segment1.ts?token=abc"))
+        XCTAssertFalse(delegate.isStructuralChange(from: location, to: signedLocation), "Rewriting a segment URL should keep the structure")
+        
+        let comment = PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: MambaStringRef(string: " Just a comment tag"))
+        let otherComment = PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: MambaStringRef(string: " Another comment tag"))
+        XCTAssertFalse(delegate.isStructuralChange(from: comment, to: otherComment), "Rewriting a non-structural tag should keep the structure")
+        
+        let extinfTagData = MambaStringRef(string: "2.002,")
+        let extinf = PlaylistTag(tagDescriptor: PantosTag.EXTINF, tagData: extinfTagData, tagName: MambaStringRef(string: PantosTag.EXTINF.toString()), duration: extinfTagData.extinfSegmentDuration())
+        let longerExtinfTagData = MambaStringRef(string: "4.004,")
+        let longerExtinf = PlaylistTag(tagDescriptor: PantosTag.EXTINF, tagData: longerExtinfTagData, tagName: MambaStringRef(string: PantosTag.EXTINF.toString()), duration: longerExtinfTagData.extinfSegmentDuration())
+        XCTAssertFalse(delegate.isStructuralChange(from: extinf, to: extinf), "An unchanged structural tag should keep the structure")
+        XCTAssertTrue(delegate.isStructuralChange(from: extinf, to: longerExtinf), "Changing a duration should rebuild the structure")
+        XCTAssertTrue(delegate.isStructuralChange(from: extinf, to: comment), "Removing a structural tag should rebuild the structure")
+        XCTAssertTrue(delegate.isStructuralChange(from: comment, to: location), "Adding a structural tag should rebuild the structure")
+        
+        // a structural transform still rebuilds
+        var playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
+        XCTAssert(playlist.mediaSegmentGroups.count == 6, "Expecting 6 media groups")
+        
+        var extinfCount = 0
+        try! playlist.transform { tag in
+            guard tag.tagDescriptor == PantosTag.EXTINF else { return tag }
+            extinfCount += 1
+            return extinfCount == 2 ? longerExtinf : tag
+        }
+        
+        XCTAssert(playlist.mediaSegmentGroups.count == 6, "Expecting 6 media groups")
+        XCTAssertEqual(playlist.mediaSegmentGroups[1].timeRange.duration.seconds, 4.004, accuracy: 0.001, "Expecting the new duration")
+        XCTAssertEqual(playlist.mediaSegmentGroups[2].timeRange.start.seconds, 6.006, accuracy: 0.001, "Expecting later groups to move")
+    }
+    
+    func testConcurrentTransform() {
+        
+        var segments = ""
+        for segment in 0..<1000 {
+            segments += "#EXTINF:2.002,\nhttp://not.a.server.nowhere/segment\(segment).ts\n"
+        }
+        let playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_header + segments + sampleVariantPlaylist_footer)
+        
+        let signURL: (PlaylistTag) -> PlaylistTag = { tag in
+            guard tag.tagDescriptor == PantosTag.Location else { return tag }
+            return PlaylistTag(tagDescriptor: PantosTag.Location, tagData: MambaStringRef(string: tag.tagData.stringValue() + "?token=abc"))
+        }
+        
+        var serialPlaylist = playlist
+        var concurrentPlaylist = playlist
+        try! serialPlaylist.transform(signURL)
+        try! concurrentPlaylist.transformConcurrently(signURL)
+        
+        XCTAssertEqual(concurrentPlaylist.tags, serialPlaylist.tags, "Expecting the same tags as a serial transform")
+        XCTAssertEqual(concurrentPlaylist.mediaSegmentGroups, playlist.mediaSegmentGroups, "Expecting the same structure")
+        XCTAssert(concurrentPlaylist.tags.filter({ $0.tagDescriptor == PantosTag.Location }).allSatisfy({ $0.tagData.stringValue().hasSuffix("?token=abc") }),
+                  "Expecting every URL to be signed")
+        
+        enum TransformError: Error {
+            case failed
+        }
+        var failingPlaylist = playlist
+        XCTAssertThrowsError(try failingPlaylist.transformConcurrently { tag in
+            if tag.tagDescriptor == PantosTag.Location && tag.tagData.stringValue().hasSuffix("segment900.ts") {
+                throw TransformError.failed
+            }
+            return signURL(tag)
+        })
+        XCTAssertEqual(failingPlaylist.tags, playlist.tags, "A failed transform should leave the tags unchanged")
+    }
+    
     func testCopyOnWrite() {
         
         var playlist1 = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
@@ -749,6 +822,50 @@ class PlaylistStructureAndEditingTests: XCTestCase {
         XCTAssert(playlist1.tags.count == playlist2.tags.count + 1, "Expecting an added tag")
     }
     
+    func testFrozenPlaylist() {
+        
+        var playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
+        // the structure is updated the next time it is read, so freezing has to do that
+        playlist.insert(tag: PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: MambaStringRef(string: " Just a comment tag")), atIndex: 8)
+        
+        let frozen = playlist.frozen()
+        
+        XCTAssertEqual(frozen.tags, playlist.tags)
+        XCTAssertEqual(frozen.mediaSegmentGroups, playlist.mediaSegmentGroups)
+        XCTAssertEqual(frozen.mediaSpans.map { $0.tagMediaSpan }, playlist.mediaSpans.map { $0.tagMediaSpan })
+        XCTAssertEqual(frozen.playlistType, PlaylistType.vod)
+        XCTAssertEqual(frozen.url, playlist.url)
+        XCTAssertEqual(try frozen.write(), try playlist.write())
+        
+        let expectedMediaGroups = frozen.tags.indices.map { playlist.mediaGroup(forTagIndex: $0) }
+        DispatchQueue.concurrentPerform(iterations: 8) { _ in
+            for tagIndex in frozen.tags.indices {
+                XCTAssertEqual(frozen.mediaGroup(forTagIndex: tagIndex), expectedMediaGroups[tagIndex])
+            }
+            for group in frozen.mediaSegmentGroups {
+                XCTAssertEqual(frozen.mediaGroup(forTime: group.timeRange.start), group)
+                XCTAssertEqual(frozen.tagIndexes(forMediaSequence: group.mediaSequence), group.range)
+            }
+        }
+        
+        var thawed = VariantPlaylist(frozen)
+        XCTAssertEqual(thawed.mediaSegmentGroups, frozen.mediaSegmentGroups)
+        thawed.delete(atIndex: 8)
+        XCTAssertEqual(thawed.tags.count, frozen.tags.count - 1)
+        XCTAssertEqual(thawed.mediaSegmentGroups[1].range.count, 4)
+        XCTAssertEqual(frozen.mediaSegmentGroups[1].range.count, 5, "Editing a thawed playlist should not change the frozen playlist")
+        
+        guard case .parsedVariant(let deferredPlaylist) = PlaylistParser(deferTagValueParsing: true).parse(playlistData: sampleVariantPlaylist_XKeys.data(using: .utf8)!,
+                                                                                                         url: fakePlaylistURL()) else {
+            XCTFail("Expected a variant playlist")
+            return
+        }
+        let frozenDeferredPlaylist = deferredPlaylist.frozen()
+        let method: String? = frozenDeferredPlaylist.mediaSpans.first?.parentTag.value(forValueIdentifier: PantosValue.method)
+        XCTAssertEqual(method, "AES-128", "Expecting deferred tag values to be parsed")
+        XCTAssertEqual(try frozenDeferredPlaylist.write(), try deferredPlaylist.write(), "Parsing deferred values should not mark tags as edited")
+    }
+    
     func testMediaGroupByObjectAndByIndex() {
         
         let playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
@@ -767,6 +884,25 @@ class PlaylistStructureAndEditingTests: XCTestCase {
         }
     }
     
+    func testTagCollection() {
+        
+        var playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
+        playlist.insert(tag: PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: MambaStringRef(string: " Just a comment tag")), atIndex: 8)
+        playlist.delete(atIndex: 3)
+        
+        let tags = playlist.tags
+        XCTAssertEqual(Array(playlist.tagCollection), tags)
+        XCTAssertEqual(playlist.tagCollection.array, tags)
+        for tagIndex in tags.indices {
+            XCTAssertEqual(playlist.tagCollection[tagIndex], tags[tagIndex], "Expecting the same tag at index \(tagIndex)")
+        }
+        
+        let group = playlist.mediaSegmentGroups[1]
+        let groupTags = playlist.tags(forMediaGroup: group)
+        XCTAssertEqual(groupTags.startIndex, group.range.lowerBound, "A media group's tags should keep their playlist indices")
+        XCTAssertEqual(groupTags.array, Array(tags[group.range]))
+    }
+    
     func testOutOfRangeMediaGroupAccess() {
         
         let playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
@@ -871,6 +1007,43 @@ fragment1.ts
         XCTAssertEqual(playlist3.playlistType, .event)
     }
 
+    func testIncrementalEditsMatchRebuild() {
+        
+        var playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_XKeys)
+        
+        let tag = PlaylistTag(tagDescriptor: PantosTag.Comment, tagData:MambaStringRef(string: " Just a comment tag"))
+        
+        for round in 0..<12 {
+            
+            // access the playlist structure to force a build and set us in the .clean state
+            let mediaSegmentGroups = playlist.mediaSegmentGroups
+            guard let header = playlist.header, let footer = playlist.footer else {
+                return XCTFail("Expecting a header and a footer")
+            }
+            let group = mediaSegmentGroups[round % mediaSegmentGroups.count]
+            
+            // insert inside the footer, a media group and the header, back to front so the indexes above stay correct
+            playlist.insert(tag: tag, atIndex: footer.endIndex)
+            playlist.insert(tags: [tag, tag], atIndex: group.startIndex + 1)
+            playlist.insert(tag: tag, atIndex: header.startIndex + 1)
+            if round % 3 == 2, let commentIndex = playlist.tags.lastIndex(where: { $0.tagDescriptor == PantosTag.Comment }) {
+                playlist.delete(atIndex: commentIndex)
+            }
+            
+            let rebuilt = VariantPlaylistStructure(withTags: playlist.tags)
+            
+            XCTAssertEqual(playlist.header?.range, rebuilt.header?.range, "Header should match a rebuild in round \(round)")
+            XCTAssertEqual(playlist.mediaSegmentGroups, rebuilt.mediaSegmentGroups, "Media groups should match a rebuild in round \(round)")
+            XCTAssertEqual(playlist.footer?.range, rebuilt.footer?.range, "Footer should match a rebuild in round \(round)")
+            XCTAssertEqual(playlist.mediaSpans.map { $0.tagMediaSpan }, rebuilt.mediaSpans.map { $0.tagMediaSpan }, "Spans should match a rebuild in round \(round)")
+            for tagIndex in playlist.tags.indices {
+                XCTAssertEqual(playlist.mediaGroup(forTagIndex: tagIndex),
+                               rebuilt.mediaSegmentGroups.first(where: { $0.range.contains(tagIndex) }),
+                               "Wrong media group for tag \(tagIndex) in round \(round)")
+            }
+        }
+    }
+    
     func testDeltaUpdateCorrectlyCalculatesMediaSequencesInTagGroups() {
         let playlist = parseVariantPlaylist(inString: sampleDeltaUpdatePlaylist)
 
@@ -336,9 +336,45 @@ class PlaylistTimelineAndSequencingTests: XCTestCase {
         XCTAssertNil(playlist.tagIndexes(forTime: CMTime(seconds: 11.5, preferredTimescale: CMTimeScale.defaultMambaTimeScale)), "times after the end of the clip should not return tags")
     }
     
+    func testIndexedLookupsMatchLinearSearch() {
+        
+        var playlist = parseVariantPlaylist(inString: sampleVariantPlaylist_mediaSequence4)
+        
+        assertIndexedLookupsMatchLinearSearch(forPlaylist: playlist)
+        
+        // a non-structural insert updates the structure without a rebuild
+        playlist.insert(tag: PlaylistTag(tagDescriptor: PantosTag.Comment, tagData: MambaStringRef(string: "# comment")), atIndex: 7)
+        
+        XCTAssert(runTest(forTimeline: playlist, mediaSequence: 5, shouldMatchBeginTagIndex: 6, andEndTagIndex: 11), "Unexpected tags returned")
+        XCTAssert(runTest(forTimeline: playlist, mediaSequence: 6, shouldMatchBeginTagIndex: 12, andEndTagIndex: 13), "Unexpected tags returned")
+        assertIndexedLookupsMatchLinearSearch(forPlaylist: playlist)
+    }
+    
     
     // MARK: Utilities
     
+    func assertIndexedLookupsMatchLinearSearch(forPlaylist playlist: VariantPlaylist, file: StaticString = #file, line: UInt = #line) {
+        let groups = playlist.mediaSegmentGroups
+        
+        for tagIndex in -1...playlist.tags.count {
+            XCTAssertEqual(playlist.mediaGroup(forTagIndex: tagIndex),
+                           groups.first(where: { $0.startIndex <= tagIndex && $0.endIndex >= tagIndex }),
+                           "Tag index \(tagIndex)", file: file, line: line)
+        }
+        
+        for mediaSequence in (groups.first!.mediaSequence - 1)...(groups.last!.mediaSequence + 1) {
+            XCTAssertEqual(playlist.mediaGroup(forMediaSequence: mediaSequence),
+                           groups.first(where: { $0.mediaSequence == mediaSequence }),
+                           "Media sequence \(mediaSequence)", file: file, line: line)
+        }
+        
+        for timeInMilliseconds in stride(from: Int64(-500), through: 11500, by: 7) {
+            let time = CMTime(value: timeInMilliseconds, timescale: 1000)
+            let expectedGroup = groups.first(where: { $0.timeRange.containsTime(time) }) ?? (time == playlist.endTime ? groups.last : nil)
+            XCTAssertEqual(playlist.mediaGroup(forTime: time), expectedGroup, "Time \(timeInMilliseconds)ms", file: file, line: line)
+        }
+    }
+    
     func runTest(forTimeline timeline: PlaylistTimelineTranslator, mediaSequence: MediaSequence, hasStartTimeInMilliseconds startTimeInMilliseconds: Int64, andHasEndTimeInMilliseconds endTimeInMilliseconds: Int64) -> Bool {
         guard let timeRange = timeline.timeRange(forMediaSequence: mediaSequence) else {
             return false
@@ -55,6 +55,133 @@ class PlaylistWriterTests: XCTestCase {
         }
     }
     
+    func testWriterParserRoundTrip_Data() {
+        guard let hlsString = FixtureLoader.loadAsString(fixtureName: roundTripTestFixture as NSString) else {
+            XCTAssert(false, "Fixture is missing?")
+            return
+        }
+        
+        do {
+            let writer = PlaylistWriter(suppressMambaIdentityString: true)
+            let playlist = parseMasterPlaylist(inString: hlsString)
+            
+            let data: Data = try writer.write(playlist: playlist)
+            
+            XCTAssertEqual(data, hlsString.data(using: .utf8), "Incoming HLS not identical to Output HLS")
+        }
+        catch {
+            XCTAssert(false, "Exception was thrown while parsing: \(error)")
+        }
+    }
+    
+    func testWriterParserRoundTrip_FileDescriptor() {
+        guard let hlsString = FixtureLoader.loadAsString(fixtureName: roundTripTestFixture as NSString) else {
+            XCTAssert(false, "Fixture is missing?")
+            return
+        }
+        
+        let url = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent("PlaylistWriterTests_\(UUID().uuidString).m3u8")
+        defer {
+            try? FileManager.default.removeItem(at: url)
+        }
+        
+        do {
+            let writer = PlaylistWriter(suppressMambaIdentityString: true)
+            let playlist = parseMasterPlaylist(inString: hlsString)
+            
+            guard
+                FileManager.default.createFile(atPath: url.path, contents: nil),
+                let fileHandle = FileHandle(forWritingAtPath: url.path) else {
+                    XCTFail("Unable to open temporary file")
+                    return
+            }
+            try writer.write(playlist: playlist, toFileDescriptor: fileHandle.fileDescriptor)
+            fileHandle.closeFile()
+            
+            let hlsOut = try String(contentsOf: url, encoding: .utf8)
+            
+            XCTAssert(hlsOut == hlsString, "Incoming HLS not identical to Output HLS")
+        }
+        catch {
+            XCTAssert(false, "Exception was thrown while parsing: \(error)")
+        }
+    }
+    
+    func testWriterParserRoundTrip_LargePlaylist() {
+        
+        // large enough that the writer has to flush to the stream several times
+        var hlsString = "#EXTM3U\n#EXT-X-VERSION:4\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:0\n"
+        for index in 0..<5000 {
+            hlsString += "#EXTINF:2.002,\nhttp://media.example.com/a/very/long/path/to/the/media/segment_\(index).ts\n"
+        }
+        hlsString += "#EXT-X-ENDLIST\n"
+        
+        do {
+            let writer = PlaylistWriter(suppressMambaIdentityString: true)
+            var playlist = parseVariantPlaylist(inString: hlsString)
+            
+            let stream = OutputStream.toMemory()
+            stream.open()
+            try writer.write(playlist: playlist, toStream: stream)
+            guard let data = stream.property(forKey: .dataWrittenToMemoryStreamKey) as? Data else {
+                XCTFail("No data written in write from PlaylistWriter")
+                return
+            }
+            stream.close()
+            
+            XCTAssertGreaterThan(data.count, 64 * 1024)
+            XCTAssertEqual(String(data: data, encoding: .utf8), hlsString, "Incoming HLS not identical to Output HLS")
+            
+            // dirty tags are written through their tag writers
+            var tag = playlist.tags[3]
+            XCTAssert(tag.tagDescriptor == PantosTag.EXT_X_MEDIA_SEQUENCE)
+            tag.set(value: "10", forValueIdentifier: PantosValue.sequence)
+            playlist.delete(atIndex: 3)
+            playlist.insert(tag: tag, atIndex: 3)
+            
+            let editedData: Data = try writer.write(playlist: playlist)
+            XCTAssertEqual(String(data: editedData, encoding: .utf8),
+                           hlsString.replacingOccurrences(of: "#EXT-X-MEDIA-SEQUENCE:0\n", with: "#EXT-X-MEDIA-SEQUENCE:10\n"))
+        }
+        catch {
+            XCTAssert(false, "Exception was thrown while parsing: \(error)")
+        }
+    }
+    
+    func testWriterPassthroughOfUneditedTags() {
+        
+        // the blank line and the CRLF line ending are not written out
+        let hlsString = "#EXTM3U\n#EXT-X-VERSION:4\n\n#EXT-X-TARGETDURATION:2\r\n#EXT-X-MEDIA-SEQUENCE:0\n# a comment\n#EXTINF:2.002,\nsegment0.ts\n#EXTINF:2.002,\nsegment1.ts\n#EXT-X-ENDLIST\n"
+        
+        var playlist = parseVariantPlaylist(inString: hlsString)
+        
+        var tag = playlist.tags[3]
+        XCTAssert(tag.tagDescriptor == PantosTag.EXT_X_MEDIA_SEQUENCE)
+        tag.set(value: "10", forValueIdentifier: PantosValue.sequence)
+        playlist.delete(atIndex: 3)
+        playlist.insert(tag: tag, atIndex: 3)
+        playlist.insert(tag: PlaylistTag(tagDescriptor: PantosTag.EXT_X_DISCONTINUITY), atIndex: 8)
+        
+        let expectedString = "#EXTM3U\n#EXT-X-VERSION:4\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:10\n# a comment\n#EXTINF:2.002,\nsegment0.ts\n#EXT-X-DISCONTINUITY\n#EXTINF:2.002,\nsegment1.ts\n#EXT-X-ENDLIST\n"
+        
+        do {
+            let writer = PlaylistWriter(suppressMambaIdentityString: true)
+            
+            let string: String = try writer.write(playlist: playlist)
+            XCTAssertEqual(string, expectedString)
+            
+            let stream = OutputStream.toMemory()
+            stream.open()
+            try writer.write(playlist: playlist, toStream: stream)
+            let data = stream.property(forKey: .dataWrittenToMemoryStreamKey) as? Data
+            stream.close()
+            XCTAssertEqual(data, expectedString.data(using: .utf8))
+        }
+        catch {
+            XCTAssert(false, "Exception was thrown while parsing: \(error)")
+        }
+    }
+    
     
     // MARK: Test Failure Paths
 
@@ -21,6 +21,7 @@
 #import "RapidParserState.h"
 #import "RapidParserLineState.h"
 #import "RapidParserMasterParseArray.h"
+#import "RapidParserByteClassStateMachine.h"
 #import "RapidParser.h"
 
 static const NSInteger noHit = 0;
@@ -129,6 +130,14 @@ static const int64_t colonposition = 90;
 @implementation ParseArrayTests
 
 - (void)testArrays {
+    [self runArrayTestUsingByteClassTables:NO];
+}
+
+- (void)testByteClassTables {
+    [self runArrayTestUsingByteClassTables:YES];
+}
+
+- (void)runArrayTestUsingByteClassTables:(BOOL)useByteClassTables {
     
     struct LineState lineState;
     uint8_t newState = 0;
@@ -147,7 +156,12 @@ static const int64_t colonposition = 90;
             
             [mockParser clear];
             
-            newState = (*masterParseArray[state][c]) ((__bridge const void *)(mockParser), c, position, state, &lineState);
+            if (useByteClassTables) {
+                newState = byteClassParseStep((__bridge const void *)(mockParser), c, position, state, &lineState);
+            }
+            else {
+                newState = (*masterParseArray[state][c]) ((__bridge const void *)(mockParser), c, position, state, &lineState);
+            }
             
             [self evaluateNewState:newState
                       andLineState:lineState
@@ -349,11 +363,17 @@ static const int64_t colonposition = 90;
 
 - (void)testArrayForNewTag {
     
-    [self runNewTagTestForNewlineChar:'\n'];
-    [self runNewTagTestForNewlineChar:'\r'];
+    [self runNewTagTestForNewlineChar:'\n' usingByteClassTables:NO];
+    [self runNewTagTestForNewlineChar:'\r' usingByteClassTables:NO];
 }
 
-- (void)runNewTagTestForNewlineChar:(unsigned char)c {
+- (void)testByteClassTablesForNewTag {
+    
+    [self runNewTagTestForNewlineChar:'\n' usingByteClassTables:YES];
+    [self runNewTagTestForNewlineChar:'\r' usingByteClassTables:YES];
+}
+
+- (void)runNewTagTestForNewlineChar:(unsigned char)c usingByteClassTables:(BOOL)useByteClassTables {
     
     struct LineState lineState;
     uint8_t newState = 0;
@@ -366,7 +386,12 @@ static const int64_t colonposition = 90;
     
     [mockParser clear];
     
-    newState = (*masterParseArray[state][c]) ((__bridge const void *)(mockParser), c, position, state, &lineState);
+    if (useByteClassTables) {
+        newState = byteClassParseStep((__bridge const void *)(mockParser), c, position, state, &lineState);
+    }
+    else {
+        newState = (*masterParseArray[state][c]) ((__bridge const void *)(mockParser), c, position, state, &lineState);
+    }
     
     XCTAssert(newState == Scanning);
     XCTAssert(mockParser.hit == newTag);
@@ -0,0 +1,159 @@
+//
+//  RapidParserPerformanceTests.m
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "RapidParserState.h"
+#import "RapidParserLineState.h"
+#import "RapidParserMasterParseArray.h"
+#import "RapidParserByteClassStateMachine.h"
+#import "RapidParser.h"
+#import "parseHLS.h"
+
+/*
+ Benchmarks for the C scanner. These compare the original `masterParseArray` function
+ pointer table against the byte class tables, and against the full `parseHLS` function.
+
+ The parent parser ignores all callbacks so that we are only measuring the scanner.
+ */
+
+@interface NoOpRapidParser: RapidParser
+
+@property (nonatomic, assign) NSUInteger lineCount;
+
+@end
+
+@implementation NoOpRapidParser
+
+- (void)newTagWithStartTagName:(UInt64)startTagName endTagName:(UInt64)endTagName startTagData:(UInt64)startTagData endTagData:(UInt64)endTagData {
+    self.lineCount++;
+}
+
+- (void)newNoDataTagWithStartTagName:(UInt64)startTagName endTagName:(UInt64)endTagName {
+    self.lineCount++;
+}
+
+- (void)newEXTINFTagWithStartTagName:(UInt64)startTagName
+                          endTagName:(UInt64)endTagName
+                       startDuration:(UInt64)startDuration
+                         endDuration:(UInt64)endDuration
+                        startTagData:(UInt64)startTagData
+                          endTagData:(UInt64)endTagData {
+    self.lineCount++;
+}
+
+- (void)newCommentWithStart:(UInt64)startComment end:(UInt64)endComment {
+    self.lineCount++;
+}
+
+- (BOOL)newURLWithStart:(UInt64)startURL end:(UInt64)endURL {
+    self.lineCount++;
+    return YES;
+}
+
+- (void)parseComplete {}
+
+- (void)parseError:(NSString *)errorString errorNumber:(UInt32)errorNumber {}
+
+@end
+
+static const NSUInteger numberOfSegments = 10000;
+static const NSUInteger numberOfHeaderLines = 4;
+static const NSUInteger linesPerSegment = 3;
+
+// the pre-byte class parse loop, kept here to benchmark against
+static void parseUsingMasterParseArray(const void *parentparser, const unsigned char *bytes, const uint64_t length) {
+    uint64_t index = length;
+    uint8_t state = Scanning;
+    struct LineState lineState;
+    initializeLineState(&lineState);
+    lineState.end = index - 1;
+
+    while (index > 0 && state < numberOfScanningParseStates) {
+        index -= 1;
+        state = (*masterParseArray[state][bytes[index]]) (parentparser, bytes[index], index, state, &lineState);
+    }
+    if (index == 0 && state < numberOfScanningParseStates) {
+        (*masterParseArray[state]['\n']) (parentparser, '\n', -1, state, &lineState);
+    }
+}
+
+// the same loop using the byte class tables, without skipping ahead
+static void parseUsingByteClassTables(const void *parentparser, const unsigned char *bytes, const uint64_t length) {
+    uint64_t index = length;
+    uint8_t state = Scanning;
+    struct LineState lineState;
+    initializeLineState(&lineState);
+    lineState.end = index - 1;
+
+    while (index > 0 && state < numberOfScanningParseStates) {
+        index -= 1;
+        state = byteClassParseStep(parentparser, bytes[index], index, state, &lineState);
+    }
+    if (index == 0 && state < numberOfScanningParseStates) {
+        byteClassParseStep(parentparser, '\n', -1, state, &lineState);
+    }
+}
+
+@interface RapidParserPerformanceTests : XCTestCase
+
+@property (nonatomic, strong) NSData *playlist;
+
+@end
+
+@implementation RapidParserPerformanceTests
+
+- (void)setUp {
+    [super setUp];
+    NSMutableString *playlist = [NSMutableString stringWithString:@"#EXTM3U\n#EXT-X-VERSION:3\n#EXT-X-TARGETDURATION:6\n#EXT-X-MEDIA-SEQUENCE:0\n"];
+    for (NSUInteger i = 0; i < numberOfSegments; i++) {
+        [playlist appendFormat:@"#EXT-X-PROGRAM-DATE-TIME:2026-10-17T00:%02lu:%02lu.000Z\n", (unsigned long)(i / 60 % 60), (unsigned long)(i % 60)];
+        [playlist appendString:@"#EXTINF:6.006,\n"];
+        [playlist appendFormat:@"https://cdn.example.com/content/channel/1080p/segment_%08lu.ts?token=0123456789abcdef0123456789abcdef\n", (unsigned long)i];
+    }
+    self.playlist = [playlist dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (void)testPerformanceMasterParseArray {
+    NoOpRapidParser *parser = [NoOpRapidParser new];
+    [self measureBlock:^{
+        parser.lineCount = 0;
+        parseUsingMasterParseArray((__bridge const void *)(parser), self.playlist.bytes, self.playlist.length);
+    }];
+    XCTAssertEqual(parser.lineCount, numberOfHeaderLines + numberOfSegments * linesPerSegment);
+}
+
+- (void)testPerformanceByteClassTables {
+    NoOpRapidParser *parser = [NoOpRapidParser new];
+    [self measureBlock:^{
+        parser.lineCount = 0;
+        parseUsingByteClassTables((__bridge const void *)(parser), self.playlist.bytes, self.playlist.length);
+    }];
+    XCTAssertEqual(parser.lineCount, numberOfHeaderLines + numberOfSegments * linesPerSegment);
+}
+
+- (void)testPerformanceParseHLS {
+    NoOpRapidParser *parser = [NoOpRapidParser new];
+    [self measureBlock:^{
+        parser.lineCount = 0;
+        parseHLS((__bridge const void *)(parser), self.playlist.bytes, self.playlist.length);
+    }];
+    XCTAssertEqual(parser.lineCount, numberOfHeaderLines + numberOfSegments * linesPerSegment);
+}
+
+@end
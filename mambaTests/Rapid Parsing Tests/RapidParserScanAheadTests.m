@@ -0,0 +1,74 @@
+//
+//  RapidParserScanAheadTests.m
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "RapidParserState.h"
+#import "RapidParserMasterParseArray.h"
+#import "RapidParserScanAhead.h"
+
+@interface RapidParserScanAheadTests : XCTestCase
+
+@end
+
+@implementation RapidParserScanAheadTests
+
+- (void)testInterestingBytesMatchScanningParseArray {
+    for (int c = 0; c < 256; c++) {
+        BOOL isNoOp = masterParseArray[Scanning][c] == noOpContinueScanning;
+        XCTAssertEqual(isNoOp, !isInterestingByteForScanningState((unsigned char)c), @"Mismatch for character %i", c);
+    }
+}
+
+- (void)testSkipOnEveryAlignment {
+    // long enough to exercise the vector path and the scalar tail
+    const uint64_t length = 100;
+    unsigned char bytes[length];
+
+    for (uint64_t interestingPosition = 0; interestingPosition < length; interestingPosition++) {
+        memset(bytes, 'a', length);
+        bytes[interestingPosition] = '#';
+
+        for (uint64_t index = 0; index <= length; index++) {
+            uint64_t expected = index > interestingPosition ? interestingPosition + 1 : 0;
+            XCTAssertEqual(skipBackwardsToInterestingByteForScanningState(bytes, index), expected,
+                           @"Failed for interesting byte at %llu starting at %llu", interestingPosition, index);
+        }
+    }
+}
+
+- (void)testSkipFindsClosestInterestingByte {
+    const char *string = "#EXTINF:2.002,\nsegment1.ts";
+    const unsigned char *bytes = (const unsigned char *)string;
+    uint64_t length = strlen(string);
+
+    // the first interesting byte found from the end is the newline before the url
+    XCTAssertEqual(skipBackwardsToInterestingByteForScanningState(bytes, length), 15);
+    // then the comma
+    XCTAssertEqual(skipBackwardsToInterestingByteForScanningState(bytes, 14), 14);
+    // then the colon
+    XCTAssertEqual(skipBackwardsToInterestingByteForScanningState(bytes, 13), 8);
+}
+
+- (void)testNoInterestingBytes {
+    const char *string = "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz";
+    XCTAssertEqual(skipBackwardsToInterestingByteForScanningState((const unsigned char *)string, strlen(string)), 0);
+    XCTAssertEqual(skipBackwardsToInterestingByteForScanningState((const unsigned char *)string, 0), 0);
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  RapidParserTagIDTests.m
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "RapidParserTagID.h"
+
+@interface RapidParserTagIDTests : XCTestCase
+
+@end
+
+@implementation RapidParserTagIDTests
+
+- (void)testEveryTagNameIsRecognized {
+    for (uint8_t tagID = RapidParserTagIDNone + 1; tagID < numberOfRapidParserTagIDs; tagID++) {
+        const char *name = rapidParserTagNameForTagID(tagID);
+        XCTAssertTrue(name != NULL, @"No name for tag ID %i", tagID);
+        // this also checks that no two names share a hash slot
+        XCTAssertEqual(rapidParserTagIDForTagName((const unsigned char *)name, strlen(name)), tagID, @"Failed for %s", name);
+    }
+}
+
+- (void)testUnrecognizedTagNames {
+    const char *names[] = { "#EXT-X-UNKNOWN", "#EXT-X-VERSIO", "#EXT-X-VERSIONS", "#ext-x-version", "#EXTINF2", "#EXT-X-MEDIA-SEQUENC", "#EXT", "#", "EXTM3U" };
+    for (size_t index = 0; index < sizeof(names) / sizeof(names[0]); index++) {
+        XCTAssertEqual(rapidParserTagIDForTagName((const unsigned char *)names[index], strlen(names[index])), RapidParserTagIDNone, @"Failed for %s", names[index]);
+    }
+    XCTAssertEqual(rapidParserTagIDForTagName((const unsigned char *)"", 0), RapidParserTagIDNone);
+}
+
+- (void)testTagNameInsideLargerBuffer {
+    const char *line = "#EXT-X-TARGETDURATION:10";
+    XCTAssertEqual(rapidParserTagIDForTagName((const unsigned char *)line, 21), RapidParserTagIDEXT_X_TARGETDURATION);
+}
+
+- (void)testTagNameForInvalidTagIDs {
+    XCTAssertTrue(rapidParserTagNameForTagID(RapidParserTagIDNone) == NULL);
+    XCTAssertTrue(rapidParserTagNameForTagID(numberOfRapidParserTagIDs) == NULL);
+}
+
+@end
@@ -61,6 +61,269 @@ class RapidParserTests: XCTestCase {
             XCTAssertNil(error, "Unexpected error: \(error!)")
         })
     }
+    
+    func testLineRecords() {
+        
+        let mock = MockRapidParserLineRecordCallback()
+        
+        mock.expectation = self.expectation(description: "Parsing complete")
+        
+        let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt")! as Data
+        let storage = StaticMemoryStorage(data: data)
+        mock.storage = storage
+        
+        let parser = RapidParser()
+        
+        parser.parseHLSData(toLineRecords: storage, callback: mock)
+        
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        
+        XCTAssertEqual(mock.lines.count, 19)
+        
+        // records are returned in the order found, which is last line first
+        XCTAssertEqual(mock.lines[0], "N:#EXT-X-ENDLIST")
+        XCTAssertEqual(mock.lines[1], "U:http://media.example.com/entire1.ts")
+        XCTAssertEqual(mock.lines[2], "T:#EXT-X-BYTERANGE:82112@752321")
+        XCTAssertEqual(mock.lines[3], "I:#EXTINF:5220,2:5220")
+        XCTAssertEqual(mock.lines[18], "N:#EXTM3U")
+        
+        // durations are decoded during the scan
+        XCTAssertEqual(mock.durationTicks, [522_000_000, 522_000_000])
+    }
+    
+    func testPartitionedLineRecords() {
+        
+        let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt")! as Data
+        let storage = StaticMemoryStorage(data: data)
+        
+        let serialMock = MockRapidParserLineRecordCallback()
+        serialMock.expectation = self.expectation(description: "Serial parsing complete")
+        serialMock.storage = storage
+        let serialParser = RapidParser()
+        serialParser.parseHLSData(toLineRecords: storage, callback: serialMock)
+        
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        
+        // partitions will be as small as a few lines, and some will be empty
+        for partitionCount in [2, 3, 5, 8, 64] {
+            
+            let mock = MockRapidParserLineRecordCallback()
+            mock.expectation = self.expectation(description: "Parsing complete")
+            mock.storage = storage
+            
+            let parser = RapidParser()
+            parser.parseHLSData(toLineRecords: storage, partitionCount: UInt(partitionCount), callback: mock)
+            
+            self.waitForExpectations(timeout: 1, handler: { (error) in
+                XCTAssertNil(error, "Unexpected error: \(error!)")
+            })
+            
+            XCTAssertEqual(mock.lines, serialMock.lines, "Partition count \(partitionCount)")
+        }
+    }
+    
+    func testSynchronousLineRecords() {
+        
+        let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt")! as Data
+        let storage = StaticMemoryStorage(data: data)
+        
+        let asyncMock = MockRapidParserLineRecordCallback()
+        asyncMock.expectation = self.expectation(description: "Parsing complete")
+        asyncMock.storage = storage
+        let asyncParser = RapidParser()
+        asyncParser.parseHLSData(toLineRecords: storage, callback: asyncMock)
+        
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        
+        for partitionCount in [1, 3] {
+            
+            let mock = MockRapidParserLineRecordCallback()
+            mock.expectation = self.expectation(description: "Parsing complete")
+            mock.storage = storage
+            
+            let parser = RapidParser()
+            parser.parseHLSDataToLineRecordsSynchronously(storage, partitionCount: UInt(partitionCount), callback: mock)
+            
+            // the callback has been called before the parse returns
+            self.waitForExpectations(timeout: 0, handler: { (error) in
+                XCTAssertNil(error, "Unexpected error: \(error!)")
+            })
+            
+            XCTAssertEqual(mock.lines, asyncMock.lines, "Partition count \(partitionCount)")
+        }
+    }
+    
+    func testCancellation() {
+        
+        var playlistString = "#EXTM3U\n#EXT-X-TARGETDURATION:2\n"
+        for segment in 0..<5000 {
+            playlistString += "#EXTINF:2.002,\nhttp://not.a.server.nowhere/segment\(segment).ts\n"
+        }
+        let storage = StaticMemoryStorage(data: playlistString.data(using: .utf8)!)
+        
+        // cancelled before the parse starts
+        let cancellation = RapidParserCancellation()
+        cancellation.cancel()
+        for partitionCount in [1, 4] {
+            let mock = MockRapidParserLineRecordCallback()
+            mock.expectingError = true
+            mock.expectation = self.expectation(description: "Parsing cancelled")
+            mock.storage = storage
+            
+            let parser = RapidParser()
+            parser.cancellation = cancellation
+            parser.parseHLSDataToLineRecordsSynchronously(storage, partitionCount: UInt(partitionCount), callback: mock)
+            
+            self.waitForExpectations(timeout: 0, handler: { (error) in
+                XCTAssertNil(error, "Unexpected error: \(error!)")
+            })
+            XCTAssertEqual(mock.errorNumber, RapidParserErrorCancelled, "Partition count \(partitionCount)")
+            XCTAssertTrue(mock.lines.isEmpty, "Partition count \(partitionCount)")
+        }
+        
+        // a deadline that has passed
+        let timedOutMock = MockRapidParserLineRecordCallback()
+        timedOutMock.expectingError = true
+        timedOutMock.expectation = self.expectation(description: "Parsing timed out")
+        let timedOutParser = RapidParser()
+        timedOutParser.cancellation = RapidParserCancellation(deadline: DispatchTime.now().rawValue)
+        timedOutParser.parseHLSDataToLineRecordsSynchronously(storage, partitionCount: 1, callback: timedOutMock)
+        self.waitForExpectations(timeout: 0, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        XCTAssertEqual(timedOutMock.errorNumber, RapidParserErrorTimedOut)
+        
+        // cancelled part way through the scan
+        let mock = MockRapidParserCallback()
+        mock.cancellationOnFirstURL = RapidParserCancellation()
+        mock.expectation = self.expectation(description: "Parsing cancelled")
+        let parser = RapidParser()
+        parser.cancellation = mock.cancellationOnFirstURL
+        parser.parseHLSData(storage, callback: mock)
+        self.waitForExpectations(timeout: 1, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        XCTAssertEqual(mock.errorNumber, RapidParserErrorCancelled)
+        // the scan stops within a few kilobytes of being cancelled
+        XCTAssertGreaterThan(mock.lines.count, 0)
+        XCTAssertLessThan(mock.lines.count, 2000)
+    }
+    
+    func testIncrementalLineRecords() {
+        
+        let data = FixtureLoader.load(fixtureName: "hls_sampleMediaFile.txt")! as Data
+        
+        for chunkSize in [1, 2, 7, 64, data.count] {
+            
+            let mock = MockRapidParserLineRecordCallback()
+            mock.expectation = self.expectation(description: "Parsing complete")
+            mock.storage = StaticMemoryStorage(data: data)
+            
+            let parser = RapidParser()
+            
+            parser.beginIncrementalParse(withCallback: mock)
+            for chunkStart in stride(from: 0, to: data.count, by: chunkSize) {
+                let chunk = data.subdata(in: chunkStart..<min(chunkStart + chunkSize, data.count))
+                XCTAssertTrue(parser.feedIncrementalParse(chunk))
+            }
+            parser.finishIncrementalParse()
+            
+            // the incremental parser calls back synchronously
+            self.waitForExpectations(timeout: 0, handler: { (error) in
+                XCTAssertNil(error, "Unexpected error: \(error!)")
+            })
+            
+            XCTAssertEqual(mock.lines.count, 19, "Chunk size \(chunkSize)")
+            
+            // records are returned in document order
+            XCTAssertEqual(mock.lines[0], "N:#EXTM3U", "Chunk size \(chunkSize)")
+            XCTAssertEqual(mock.lines[15], "I:#EXTINF:5220,2:5220", "Chunk size \(chunkSize)")
+            XCTAssertEqual(mock.lines[16], "T:#EXT-X-BYTERANGE:82112@752321", "Chunk size \(chunkSize)")
+            XCTAssertEqual(mock.lines[17], "U:http://media.example.com/entire1.ts", "Chunk size \(chunkSize)")
+            XCTAssertEqual(mock.lines[18], "N:#EXT-X-ENDLIST", "Chunk size \(chunkSize)")
+            XCTAssert(mock.durationTicks.allSatisfy { $0 == Int64(RapidParserLineRecordDurationNotDecoded) }, "Chunk size \(chunkSize)")
+            
+            // once finished, no more data is accepted
+            XCTAssertFalse(parser.feedIncrementalParse(data))
+        }
+    }
+    
+    func testIncrementalParseError() {
+        
+        let mock = MockRapidParserLineRecordCallback()
+        mock.expectingError = true
+        mock.expectation = self.expectation(description: "Parsing failed")
+        
+        let parser = RapidParser()
+        
+        parser.beginIncrementalParse(withCallback: mock)
+        XCTAssertTrue(parser.feedIncrementalParse("#EXTM3U\n#EXT-X-VERSION:4\n#EXTI".data(using: .utf8)!))
+        // the #EXTINF tag is missing its colon, which we only know once we see the end of the line
+        XCTAssertFalse(parser.feedIncrementalParse("NF\nsegment.ts\n".data(using: .utf8)!))
+        XCTAssertFalse(parser.feedIncrementalParse("#EXT-X-ENDLIST\n".data(using: .utf8)!))
+        parser.finishIncrementalParse()
+        
+        self.waitForExpectations(timeout: 0, handler: { (error) in
+            XCTAssertNil(error, "Unexpected error: \(error!)")
+        })
+        
+        XCTAssertEqual(mock.errorNumber, UInt32(PlaylistParserInternalErrorCode.missingTagDataForEXTINF.rawValue))
+    }
+}
+
+private class MockRapidParserLineRecordCallback: NSObject, RapidParserLineRecordCallback {
+    
+    var lines = [String]()
+    var durationTicks = [Int64]()
+    var expectation: XCTestExpectation?
+    var storage: StaticMemoryStorage?
+    var expectingError = false
+    var errorNumber: UInt32?
+    
+    // MARK: RapidParserLineRecordCallback
+    
+    func parsedLineRecords(_ records: UnsafePointer<RapidParserLineRecord>, count: UInt) {
+        guard let bytes = storage?.bytes?.assumingMemoryBound(to: CChar.self) else {
+            XCTFail("No storage")
+            return
+        }
+        func string(_ start: UInt64, _ length: UInt64) -> String {
+            return MambaStringRef(bytesNoCopy: bytes + Int(start), length: UInt(length)).stringValue()
+        }
+        for record in UnsafeBufferPointer(start: records, count: Int(count)) {
+            switch record.kind {
+            case .tag:
+                lines.append("T:\(string(record.nameStart, record.nameLength)):\(string(record.dataStart, record.dataLength))")
+            case .noDataTag:
+                lines.append("N:\(string(record.nameStart, record.nameLength))")
+            case .extinfTag:
+                lines.append("I:\(string(record.nameStart, record.nameLength)):\(string(record.dataStart, record.dataLength)):\(string(record.durationStart, record.durationLength))")
+                durationTicks.append(record.durationTicks)
+            case .comment:
+                lines.append("C:\(string(record.dataStart, record.dataLength))")
+            case .url:
+                lines.append("U:\(string(record.dataStart, record.dataLength))")
+            @unknown default:
+                XCTFail("Unknown record kind")
+            }
+        }
+        expectation?.fulfill()
+    }
+    
+    func parseError(_ error: String, errorNumber: UInt32) {
+        guard expectingError else {
+            XCTFail("Received Parse Error: \(errorNumber) \(error)")
+            return
+        }
+        self.errorNumber = errorNumber
+        expectation?.fulfill()
+    }
 }
 
 private class MockRapidParserCallback: NSObject, RapidParserCallback {
@@ -69,10 +332,13 @@ private class MockRapidParserCallback: NSObject, RapidParserCallback {
     var expectation: XCTestExpectation?
     var expectedNumberOfLines: Int = 0
     var shuntOnFragmentUrl: String? = nil
+    var cancellationOnFirstURL: RapidParserCancellation? = nil
+    var errorNumber: UInt32?
 
     // MARK: RapidParserCallback
     
     func addedURLLine(_ url: MambaStringRef) -> Bool {
+        cancellationOnFirstURL?.cancel()
         if
             let shuntOnFragmentUrl = shuntOnFragmentUrl,
             url.stringValue() == shuntOnFragmentUrl {
@@ -107,7 +373,12 @@ private class MockRapidParserCallback: NSObject, RapidParserCallback {
     }
     
     func parseError(_ error: String, errorNumber: UInt32) {
-        XCTFail("Received Parse Error: \(errorNumber) \(error)")
+        guard cancellationOnFirstURL != nil else {
+            XCTFail("Received Parse Error: \(errorNumber) \(error)")
+            return
+        }
+        self.errorNumber = errorNumber
+        expectation?.fulfill()
     }
     
     private func runParseTest() {
@@ -44,6 +44,96 @@
     XCTAssertEqual(data.length, buffer.length);
 }
 
+- (void)testNoCopy {
+    NSData *data = [NSData dataWithBytes:"abcdefg" length:7];
+    StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] initWithDataNoCopy:data];
+    
+    XCTAssertEqual(buffer.bytes, data.bytes);
+    XCTAssertEqual(data.length, buffer.length);
+}
+
+- (void)testNoCopyOfMutableData {
+    NSMutableData *data = [NSMutableData dataWithBytes:"abcdefg" length:7];
+    StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] initWithDataNoCopy:data];
+    
+    // mutable data has to be copied, so that changes do not show up in the storage
+    ((char *)data.mutableBytes)[0] = 'z';
+    
+    XCTAssertEqual(((const char *)buffer.bytes)[0], 'a');
+    XCTAssertEqual(data.length, buffer.length);
+}
+
+- (void)testMappedFile {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    NSData *data = [NSData dataWithBytes:"#EXTM3U\n#EXT-X-VERSION:4\n" length:25];
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+    
+    NSError *error = nil;
+    StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] initWithContentsOfFileAtPath:path error:&error];
+    
+    XCTAssertNotNil(buffer);
+    XCTAssertNil(error);
+    XCTAssertEqual(buffer.length, data.length);
+    XCTAssertEqual(memcmp(buffer.bytes, data.bytes, data.length), 0);
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testMappedEmptyFile {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertTrue([[NSData data] writeToFile:path atomically:YES]);
+    
+    NSError *error = nil;
+    StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] initWithContentsOfFileAtPath:path error:&error];
+    
+    XCTAssertNotNil(buffer);
+    XCTAssertEqual(buffer.bytes, (char *)0);
+    XCTAssertEqual(buffer.length, 0);
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testMappedMissingFile {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    
+    NSError *error = nil;
+    StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] initWithContentsOfFileAtPath:path error:&error];
+    
+    XCTAssertNil(buffer);
+    XCTAssertEqualObjects(error.domain, NSPOSIXErrorDomain);
+    XCTAssertEqual(error.code, ENOENT);
+}
+
+- (void)testPrecedingStorage {
+    NSData *data = [NSData dataWithBytes:"abcdefg" length:7];
+    StaticMemoryStorage *first = [[StaticMemoryStorage alloc] initWithData:data];
+    // keep "abcd" of the first storage and add "xyz"
+    StaticMemoryStorage *second = [[StaticMemoryStorage alloc] initWithBytes:"xyz" length:3 precedingStorage:first precedingLength:4];
+    
+    XCTAssertEqual(second.precedingStorage, first);
+    XCTAssertNil(first.precedingStorage);
+    XCTAssertEqual(first.precedingStorageCount, 0);
+    XCTAssertEqual(second.precedingStorageCount, 1);
+    XCTAssertEqual(first.documentLength, 7);
+    XCTAssertEqual(second.length, 3);
+    XCTAssertEqual(second.documentLength, 7);
+    XCTAssertEqual(memcmp(second.bytes, "xyz", 3), 0);
+    
+    XCTAssertTrue([first isDocumentPrefixOfBytes:"abcdefg" length:7]);
+    XCTAssertTrue([first isDocumentPrefixOfBytes:"abcdefghij" length:10]);
+    XCTAssertFalse([first isDocumentPrefixOfBytes:"abcdef" length:6]);
+    XCTAssertTrue([second isDocumentPrefixOfBytes:"abcdxyz" length:7]);
+    XCTAssertTrue([second isDocumentPrefixOfBytes:"abcdxyz123" length:10]);
+    XCTAssertFalse([second isDocumentPrefixOfBytes:"abcdefg" length:7]);
+    XCTAssertFalse([second isDocumentPrefixOfBytes:"zbcdxyz" length:7]);
+    
+    XCTAssertEqual([second documentOffsetOfPointer:(const char *)first.bytes + 2], 2);
+    XCTAssertEqual([second documentOffsetOfPointer:(const char *)second.bytes + 1], 5);
+    // "efg" of the first storage is not in the document of the second
+    XCTAssertEqual([second documentOffsetOfPointer:(const char *)first.bytes + 5], NSNotFound);
+    XCTAssertEqual([second documentOffsetOfPointer:data.bytes], NSNotFound);
+}
+
 - (void)testEmptyBuffer {
     StaticMemoryStorage *buffer = [[StaticMemoryStorage alloc] init];
     
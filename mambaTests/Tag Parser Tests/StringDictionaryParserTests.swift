@@ -308,6 +308,61 @@ class StringDictionaryParserTests: XCTestCase {
         }
     }
     
+    func testStringDictionaryParser19() {
+        do {
+            let dict = try StringDictionaryParser.parseToPlaylistTagDictionary(fromParsableString: " key1 = value1 ,key2= \"value2\" ,key3=\"\"")
+            
+            XCTAssert(dict.count == 3, "Unexpected dict count")
+            XCTAssert(dict["key1"]?.value == "value1", "Did not find expected pair")
+            XCTAssert(dict["key1"]?.quoteEscaped == false, "Did not find expected pair")
+            XCTAssert(dict["key2"]?.value == "value2", "Did not find expected pair")
+            XCTAssert(dict["key2"]?.quoteEscaped == true, "Did not find expected pair")
+            XCTAssert(dict["key3"]?.value == "", "Did not find expected pair")
+            XCTAssert(dict["key3"]?.quoteEscaped == true, "Did not find expected pair")
+        }
+        catch {
+            XCTAssert(false, "should not throw")
+        }
+    }
+    
+    func testStringDictionaryParserManyKeys() {
+        // more keys than the parser expects, so it has to parse twice
+        let keys = (0..<40).map { "KEY\($0)" }
+        let string = keys.map { "\($0)=\"\($0),ñ\"" }.joined(separator: ",")
+        do {
+            let dict = try StringDictionaryParser.parseToPlaylistTagDictionary(fromParsableString: string)
+            
+            XCTAssert(dict.count == keys.count, "Unexpected dict count")
+            for key in keys {
+                XCTAssert(dict[key]?.value == "\(key),ñ", "Did not find expected pair")
+                XCTAssert(dict[key]?.quoteEscaped == true, "Did not find expected pair")
+            }
+        }
+        catch {
+            XCTAssert(false, "should not throw")
+        }
+    }
+    
+    func testStringDictionaryParserFromUTF8Bytes() {
+        let data = "#EXT-X-KEY:METHOD=AES-128,URI=\"https://key.example.com/key?a=b,c\"".data(using: .utf8)!
+        do {
+            let dict = try data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> PlaylistTagDictionary in
+                // parse just the tag body
+                let bytes = UnsafeBufferPointer(rebasing: buffer.bindMemory(to: UInt8.self)[11...])
+                return try StringDictionaryParser.parseToPlaylistTagDictionary(fromUTF8Bytes: bytes)
+            }
+            
+            XCTAssert(dict.count == 2, "Unexpected dict count")
+            XCTAssert(dict["METHOD"]?.value == "AES-128", "Did not find expected pair")
+            XCTAssert(dict["METHOD"]?.quoteEscaped == false, "Did not find expected pair")
+            XCTAssert(dict["URI"]?.value == "https://key.example.com/key?a=b,c", "Did not find expected pair")
+            XCTAssert(dict["URI"]?.quoteEscaped == true, "Did not find expected pair")
+        }
+        catch {
+            XCTAssert(false, "should not throw")
+        }
+    }
+    
     func testStringDictionaryParserFailure1() {
         do {
             let _ = try StringDictionaryParser.parseToPlaylistTagDictionary(fromParsableString: "text")
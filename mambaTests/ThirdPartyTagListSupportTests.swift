@@ -61,5 +61,33 @@ class ThirdPartyTagListSupportTests: XCTestCase {
         
         XCTAssert(playlist.tags[7].tagDescriptor == PantosTag.EXT_X_ENDLIST, "Tag did not parse properly")
     }
+    
+    func testRegisteredPlaylistTagsLookups() {
+        
+        var registeredPlaylistTags = RegisteredPlaylistTags()
+        registeredPlaylistTags.register(tagDescriptorType: TagString_ThirdParty1.self)
+        registeredPlaylistTags.register(tagDescriptorType: TagString_ThirdParty2.self)
+        
+        // enumerable descriptor types share one instance between lookups
+        let pantosParser = registeredPlaylistTags.parser(forTag: PantosTag.EXT_X_KEY)
+        XCTAssert(pantosParser === registeredPlaylistTags.parser(forTag: PantosTag.EXT_X_KEY))
+        XCTAssert(pantosParser is GenericDictionaryTagParser)
+        let thirdParty2Parser = registeredPlaylistTags.parser(forTag: TagString_ThirdParty2.EXT_THIRD_PARTY2_1)
+        XCTAssert(thirdParty2Parser === registeredPlaylistTags.parser(forTag: TagString_ThirdParty2.EXT_THIRD_PARTY2_1))
+        XCTAssert(thirdParty2Parser is EXT_THIRD_PARTY2_1TagParser)
+        
+        // other descriptor types are looked up every time
+        XCTAssert(registeredPlaylistTags.parser(forTag: TagString_ThirdParty1.EXT_THIRD_PARTY1_1) is EXT_THIRD_PARTY1_1TagParser)
+        XCTAssert(registeredPlaylistTags.parser(forTag: TagString_ThirdParty1.EXT_THIRD_PARTY1_2) is EXT_THIRD_PARTY1_2TagParser)
+        
+        XCTAssertNotNil(registeredPlaylistTags.writer(forTag: PantosTag.EXT_X_TARGETDURATION))
+        XCTAssertNotNil(registeredPlaylistTags.validator(forTag: PantosTag.EXT_X_TARGETDURATION))
+        XCTAssertNil(registeredPlaylistTags.validator(forTag: PantosTag.EXT_X_ENDLIST))
+        XCTAssertNil(registeredPlaylistTags.validator(forTag: TagString_ThirdParty2.EXT_THIRD_PARTY2_1))
+        
+        // unregistering drops the third party entries from the table
+        registeredPlaylistTags.unRegisterAllTagDescriptors()
+        XCTAssert(registeredPlaylistTags.parser(forTag: PantosTag.EXT_X_KEY) is GenericDictionaryTagParser)
+        XCTAssertNil(registeredPlaylistTags.validator(forTag: TagString_ThirdParty2.EXT_THIRD_PARTY2_1))
+    }
 }
-
@@ -98,4 +98,33 @@
     XCTAssert(strcmp(remainder, "\0") == 0);
 }
 
+- (void)testEXTINFDurationTicks {
+    const char *c = "2.002,Title";
+    XCTAssert(mamba_EXTINFDurationTicks(c, strlen(c)) == 200200);
+    // only the duration's own bytes are read, there is no need for a null
+    XCTAssert(mamba_EXTINFDurationTicks(c, 5) == 200200);
+    XCTAssert(mamba_EXTINFDurationTicks("10", 2) == 10 * mamba_EXTINFDurationTimescale);
+    // clamped to seven characters
+    XCTAssert(mamba_EXTINFDurationTicks("1.0000019", 9) == 100000);
+}
+
+- (void)testEXTINFDurationTicksInvalid {
+    XCTAssert(mamba_EXTINFDurationTicks(NULL, 0) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks("", 0) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks("-1.0", 4) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks("1.", 2) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks("1-2", 3) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks("1.0x", 4) == -1);
+    XCTAssert(mamba_EXTINFDurationTicks(",Title", 6) == -1);
+}
+
+- (void)testEXTINFDurationMatchesCMTime {
+    const char *c = "5.005,";
+    CMTime time = mamba_CMTimeMakeFromEXTINFDuration(c, strlen(c));
+    XCTAssert(CMTIME_IS_NUMERIC(time));
+    XCTAssert(time.value == mamba_EXTINFDurationTicks(c, strlen(c)));
+    XCTAssert(time.timescale == mamba_EXTINFDurationTimescale);
+    XCTAssert(!CMTIME_IS_VALID(mamba_CMTimeMakeFromEXTINFDuration("-5", 2)));
+}
+
 @end
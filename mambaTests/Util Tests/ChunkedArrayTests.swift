@@ -0,0 +1,111 @@
+//
+//  ChunkedArrayTests.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+
+import XCTest
+
+@testable import mamba
+
+class ChunkedArrayTests: XCTestCase {
+    
+    let elementCount = ChunkedArray<Int>.chunkSize * 8 + 17
+    
+    func testEditsMatchArray() {
+        var expected = Array(0..<elementCount)
+        var chunkedArray = ChunkedArray(expected)
+        
+        XCTAssertEqual(chunkedArray.array, expected)
+        
+        // inserts that grow a chunk past twice the chunk size, at the start, middle and end
+        for round in 0..<6 {
+            let inserted = Array(repeating: -round, count: ChunkedArray<Int>.chunkSize + round)
+            let index = [0, expected.count / 2, expected.count][round % 3]
+            expected.insert(contentsOf: inserted, at: index)
+            chunkedArray.insert(contentsOf: inserted, at: index)
+        }
+        
+        // deletes within a chunk, across chunks, and of whole chunks
+        for range in [3..<4, 100..<700, 0..<ChunkedArray<Int>.chunkSize * 2, (expected.count - 300)..<(expected.count - 1)] {
+            expected.removeSubrange(range)
+            chunkedArray.removeSubrange(range)
+        }
+        
+        chunkedArray[42] = 4242
+        expected[42] = 4242
+        
+        XCTAssertEqual(chunkedArray.count, expected.count)
+        XCTAssertEqual(chunkedArray.array, expected)
+        XCTAssertEqual(Array(chunkedArray), expected)
+        for index in expected.indices {
+            XCTAssertEqual(chunkedArray[index], expected[index], "Wrong element at \(index)")
+        }
+        XCTAssertFalse(chunkedArray.chunks.contains(where: { $0.isEmpty }), "There should be no empty chunks")
+        XCTAssertEqual(chunkedArray.map { $0 * 2 }.array, expected.map { $0 * 2 })
+    }
+    
+    func testIteratingARange() {
+        let expected = Array(0..<elementCount)
+        let chunkedArray = ChunkedArray(expected)
+        let chunkSize = ChunkedArray<Int>.chunkSize
+        
+        for range in [0..<0, 0..<elementCount, 5..<6, (chunkSize - 1)..<(chunkSize * 3 + 1), chunkSize..<(elementCount - 1), elementCount..<elementCount] {
+            var iterator = chunkedArray.makeIterator(in: range)
+            var elements = [Int]()
+            while let element = iterator.next() {
+                elements.append(element)
+            }
+            XCTAssertEqual(elements, Array(expected[range]), "Wrong elements in \(range)")
+        }
+    }
+    
+    func testEmpty() {
+        var chunkedArray = ChunkedArray<Int>()
+        
+        XCTAssertTrue(chunkedArray.isEmpty)
+        XCTAssertEqual(chunkedArray.array, [])
+        
+        chunkedArray.insert(contentsOf: [1, 2, 3], at: 0)
+        XCTAssertEqual(chunkedArray.array, [1, 2, 3])
+        
+        chunkedArray.removeSubrange(0..<3)
+        XCTAssertTrue(chunkedArray.isEmpty)
+        XCTAssertEqual(chunkedArray.array, [])
+    }
+    
+    func testCopiesShareUnchangedChunks() {
+        var chunkedArray = ChunkedArray(Array(0..<elementCount))
+        let copy = chunkedArray
+        
+        chunkedArray[5] = -1
+        chunkedArray.insert(contentsOf: [-2], at: chunkedArray.count - 1)
+        
+        XCTAssertEqual(chunkedArray[5], -1)
+        XCTAssertEqual(copy[5], 5)
+        XCTAssertEqual(copy.array, Array(0..<elementCount))
+        
+        // only the first and last chunks were copied
+        for (chunkIndex, (chunk, copyChunk)) in zip(chunkedArray.chunks, copy.chunks).enumerated() {
+            let sharesStorage = chunk.withUnsafeBufferPointer { buffer in
+                copyChunk.withUnsafeBufferPointer { copyBuffer in buffer.baseAddress == copyBuffer.baseAddress }
+            }
+            let isEdited = chunkIndex == 0 || chunkIndex == copy.chunks.count - 1
+            XCTAssertEqual(sharesStorage, !isEdited, "Chunk \(chunkIndex) should \(isEdited ? "not " : "")share storage")
+        }
+    }
+}
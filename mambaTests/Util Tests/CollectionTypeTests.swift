@@ -118,4 +118,17 @@ class CollectionTypeTests: XCTestCase {
         XCTAssertNil(outOfBoundsIndexResult2, "Out of bounds should return nil")
     }
     
+    func testCollectionTypePartitioningIndex() {
+        
+        let array = [1, 3, 3, 5, 7, 9]
+        
+        XCTAssert(array.partitioningIndex(where: { $0 >= 0 }) == 0, "Every element matches")
+        XCTAssert(array.partitioningIndex(where: { $0 >= 3 }) == 1, "Should find the first matching element")
+        XCTAssert(array.partitioningIndex(where: { $0 > 3 }) == 3, "Should find the first matching element")
+        XCTAssert(array.partitioningIndex(where: { $0 >= 9 }) == 5, "Should find the last element")
+        XCTAssert(array.partitioningIndex(where: { $0 > 9 }) == array.endIndex, "No element matches")
+        XCTAssert([Int]().partitioningIndex(where: { _ in true }) == 0, "Empty collection should return endIndex")
+        XCTAssert(array[2...].partitioningIndex(where: { $0 >= 7 }) == 4, "Slices should return indexes of the base collection")
+    }
+    
 }
@@ -0,0 +1,72 @@
+//
+//  FenwickTreeTests.swift
+//  mamba
+//
+//  Created by agent on 10/17/26.
+//  Copyright © 2026 Comcast Corporation.
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+
+import XCTest
+
+@testable import mamba
+
+class FenwickTreeTests: XCTestCase {
+    
+    let values = [3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5]
+    
+    func testPrefixSums() {
+        let tree = FenwickTree(values)
+        
+        XCTAssertEqual(tree.count, values.count)
+        XCTAssertEqual(tree.elements, values)
+        for prefixCount in 0...values.count {
+            XCTAssertEqual(tree.prefixSum(prefixCount), values.prefix(prefixCount).reduce(0, +), "Wrong sum of the first \(prefixCount) elements")
+        }
+    }
+    
+    func testAdd() {
+        var tree = FenwickTree(values)
+        var expected = values
+        
+        for (index, delta) in [(0, 2), (10, -4), (5, 7), (3, -1), (7, 3)] {
+            tree.add(delta, at: index)
+            expected[index] += delta
+        }
+        
+        XCTAssertEqual(tree.elements, expected)
+        for prefixCount in 0...expected.count {
+            XCTAssertEqual(tree.prefixSum(prefixCount), expected.prefix(prefixCount).reduce(0, +), "Wrong sum of the first \(prefixCount) elements")
+        }
+    }
+    
+    func testPrefixCount() {
+        let tree = FenwickTree(values)
+        let total = values.reduce(0, +)
+        
+        for sum in -1...(total + 1) {
+            let expected = (0...values.count).last(where: { values.prefix($0).reduce(0, +) <= sum }) ?? 0
+            XCTAssertEqual(tree.prefixCount(withSumNotExceeding: sum), expected, "Wrong prefix for a sum of \(sum)")
+        }
+    }
+    
+    func testEmpty() {
+        let tree = FenwickTree([])
+        
+        XCTAssertEqual(tree.count, 0)
+        XCTAssertEqual(tree.elements, [])
+        XCTAssertEqual(tree.prefixSum(0), 0)
+        XCTAssertEqual(tree.prefixCount(withSumNotExceeding: 10), 0)
+    }
+}
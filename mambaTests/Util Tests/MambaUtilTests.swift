@@ -94,6 +94,42 @@ class MambaUtilTests: XCTestCase {
         XCTAssertNil(non8601Date1, "Parsing of 8601 date should fail")
     }
     
+    func testISO8601Parsing_timeInterval() {
+        XCTAssertEqual("1970-01-01T00:00:00Z".parseISO8601Date()?.timeIntervalSince1970, 0)
+        XCTAssertEqual("2010-02-19T14:54:23Z".parseISO8601Date()?.timeIntervalSince1970, 1266591263)
+        XCTAssertEqual("2010-02-19T14:54:23.031+03:00".parseISO8601Date()!.timeIntervalSince1970, 1266580463.031, accuracy: 0.0001)
+        XCTAssertEqual("2010-02-19T14:54:23-0230".parseISO8601Date()?.timeIntervalSince1970, 1266600263)
+        XCTAssertEqual("1969-12-31T23:59:59.5Z".parseISO8601Date()?.timeIntervalSince1970, -0.5)
+        XCTAssertEqual("2012-02-29T00:00:00Z".parseISO8601Date()?.timeIntervalSince1970, 1330473600)
+    }
+    
+    func testISO8601Parsing_fractionalSeconds() {
+        XCTAssertEqual("2010-02-19T14:54:23.5Z".parseISO8601Date()!.timeIntervalSince1970, 1266591263.5, accuracy: 0.0001)
+        XCTAssertEqual("2010-02-19T14:54:23.000001Z".parseISO8601Date()!.timeIntervalSince1970, 1266591263.000001, accuracy: 0.0000001)
+    }
+    
+    func testISO8601Parsing_sameDay() {
+        // consecutive dates on the same day skip the date math, so check that they still come out right
+        let dates = (0..<100).map { "2010-02-19T14:54:\(String(format: "%02d", $0 % 60)).\($0)Z".parseISO8601Date() }
+        for (second, date) in dates.enumerated() {
+            XCTAssertEqual(date!.timeIntervalSince1970, 1266591240 + Double(second % 60) + Double("0.\(second)")!, accuracy: 0.0001)
+        }
+        XCTAssertNil("2010-02-19T24:54:23Z".parseISO8601Date())
+        XCTAssertEqual("2010-02-20T14:54:23Z".parseISO8601Date()?.timeIntervalSince1970, 1266591263 + 86400)
+    }
+    
+    func testISO8601Parsing_fromUTF8Bytes() {
+        let data = "#EXT-X-PROGRAM-DATE-TIME:2010-02-19T14:54:23.031Z".data(using: .utf8)!
+        let date = data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> Date? in
+            Date(iso8601UTF8Bytes: UnsafeBufferPointer(rebasing: buffer.bindMemory(to: UInt8.self)[25...]))
+        }
+        XCTAssertEqual(date!.timeIntervalSince1970, 1266591263.031, accuracy: 0.0001)
+    }
+    
+    func testISO8601Parsing_invalidDay_Failure() {
+        XCTAssertNil("2010-02-30T14:54:23Z".parseISO8601Date(), "Parsing of 8601 date should fail")
+    }
+    
     // MARK: Convenience String Init
     
     func testConvenienceString() {
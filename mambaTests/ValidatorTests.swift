@@ -843,6 +843,45 @@ frag1.ts
         )
     }
 
+    
+    func testValidateTagsOfLargePlaylistReportsIssuesInPlaylistOrder() {
+        
+        // large enough to be validated on several threads
+        var hlsString = "#EXTM3U\n#EXT-X-VERSION:4\n#EXT-X-TARGETDURATION:2\n#EXT-X-MEDIA-SEQUENCE:0\n"
+        var expectedDescriptions = [String]()
+        for index in 0..<5000 {
+            if index % 500 == 0 {
+                hlsString += "#EXT-X-PROGRAM-DATE-TIME:bad-date-\(index)\n"
+                expectedDescriptions.append("EXT-X-PROGRAM-DATE-TIME (bad-date-\(index)) is not an instance of the expected data type.")
+            }
+            hlsString += "#EXTINF:2.002,\nsegment\(index).ts\n"
+        }
+        hlsString += "#EXT-X-ENDLIST\n"
+        
+        let playlist = parseVariantPlaylist(inString: hlsString)
+        XCTAssertGreaterThan(playlist.tags.count, PlaylistTagValidationSlicing.minimumTagsPerSlice * 2)
+        
+        let issues = PlaylistValidator.validateTags(fromPlaylist: playlist)
+        XCTAssertEqual(issues.map { $0.description }, expectedDescriptions)
+        
+        // the playlist validators find no further issues
+        XCTAssertEqual(PlaylistValidator.validate(variantPlaylist: playlist).map { $0.description }, expectedDescriptions)
+    }
+    
+    func testCombinedValidationMatchesIndividualValidators() {
+        
+        let variantPlaylist = parseVariantPlaylist(inString: "#EXTM3U\n#EXT-X-VERSION:4\n#EXT-X-VERSION:5\n#EXT-X-TARGETDURATION:2\n#EXT-X-DATERANGE:ID=\"a\",START-DATE=\"2020-01-01T00:00:00.000Z\"\n#EXTINF:4.004,\nsegment0.ts\n#EXT-X-ENDLIST\n#EXT-X-ENDLIST\n")
+        let expectedVariantIssues = PlaylistValidator.variantPlaylistValidators.flatMap { $0.validate(variantPlaylist: variantPlaylist) }
+        let variantIssues = PlaylistValidator.combinedValidation(ofVariantPlaylist: variantPlaylist)
+        XCTAssertFalse(variantIssues.isEmpty)
+        XCTAssertEqual(variantIssues.map { $0.description }, expectedVariantIssues.map { $0.description })
+        
+        let masterPlaylist = parseMasterPlaylist(inString: "#EXTM3U\n#EXT-X-SESSION-DATA:DATA-ID=\"a\",VALUE=\"1\"\n#EXT-X-SESSION-DATA:DATA-ID=\"a\",VALUE=\"2\"\n" + SubtitlesAndCCGroup_txt.dropFirst().joined())
+        let expectedMasterIssues = PlaylistValidator.masterPlaylistValidators.flatMap { $0.validate(masterPlaylist: masterPlaylist) }
+        let masterIssues = PlaylistValidator.combinedValidation(ofMasterPlaylist: masterPlaylist)
+        XCTAssertFalse(masterIssues.isEmpty)
+        XCTAssertEqual(masterIssues.map { $0.description }, expectedMasterIssues.map { $0.description })
+    }
 }
 
 private let masterStreamInf = "#EXT-X-STREAM-INF:PROGRAM-ID=1,BANDWIDTH=100,CODECS=\"avc1\",RESOLUTION=10x10\n"